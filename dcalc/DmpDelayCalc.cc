@@ -243,10 +243,8 @@ DmpCeffTwoPoleDelayCalc::findParasitic(const Pin *drvr_pin,
 						dcalc_ap->corner(),
 						cnst_min_max,
 						parasitic_ap);
-      // Estimated parasitics are not recorded in the "database", so
-      // it for deletion after the drvr pin delay calc is finished.
-      if (parasitic)
-	unsaved_parasitics_.push_back(parasitic);
+      // Estimated parasitics are kept by the parasitics and reused
+      // by incremental delay calculation.
       return parasitic;
     }
   }
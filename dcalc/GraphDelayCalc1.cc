@@ -17,6 +17,7 @@
 #include "GraphDelayCalc1.hh"
 
 #include "Debug.hh"
+#include "Hash.hh"
 #include "Stats.hh"
 #include "MinMax.hh"
 #include "Mutex.hh"
@@ -219,7 +220,8 @@ GraphDelayCalc1::GraphDelayCalc1(StaState *sta) :
   clk_pred_(new ClkTreeSearchPred(sta)),
   iter_(new BfsFwdIterator(BfsIndex::dcalc, search_non_latch_pred_, sta)),
   multi_drvr_nets_found_(false),
-  incremental_delay_tolerance_(0.0)
+  incremental_delay_tolerance_(0.0),
+  corner_parallel_(false)
 {
 }
 
@@ -295,6 +297,7 @@ GraphDelayCalc1::delaysInvalid()
   // No need to keep track of incremental updates any more.
   invalid_delays_.clear();
   invalid_checks_.clear();
+  corner_splits_.clear();
 }
 
 void
@@ -325,6 +328,8 @@ GraphDelayCalc1::delayInvalid(Vertex *vertex)
 {
   debugPrint(debug_, "delay_calc", 2, "delay invalid %s",
              vertex->name(sdc_network_));
+  // Parasitic changes invalidate the driver.
+  corner_splits_.erase(vertex);
   if (graph_ && incremental_) {
     invalid_delays_.insert(vertex);
     // Invalidate driver that triggers dcalc for multi-driver nets.
@@ -340,6 +345,7 @@ GraphDelayCalc1::deleteVertexBefore(Vertex *vertex)
   iter_->deleteVertexBefore(vertex);
   if (incremental_)
     invalid_delays_.erase(vertex);
+  corner_splits_.erase(vertex);
   MultiDrvrNet *multi_drvr = multiDrvrNet(vertex);
   if (multi_drvr) {
     multi_drvr->drvrs()->erase(vertex);
@@ -352,24 +358,31 @@ GraphDelayCalc1::deleteVertexBefore(Vertex *vertex)
 class FindVertexDelays : public VertexVisitor
 {
 public:
+  // corner=nullptr finds delays for all corners.
   FindVertexDelays(GraphDelayCalc1 *graph_delay_calc1,
+		   const Corner *corner,
 		   ArcDelayCalc *arc_delay_calc,
 		   bool own_arc_delay_calc);
   virtual ~FindVertexDelays();
   virtual void visit(Vertex *vertex);
+  virtual bool splitVisit(Vertex *vertex);
+  virtual void visitUnsplit(Vertex *vertex);
   virtual VertexVisitor *copy();
 
 protected:
   GraphDelayCalc1 *graph_delay_calc1_;
+  const Corner *corner_;
   ArcDelayCalc *arc_delay_calc_;
   bool own_arc_delay_calc_;
 };
 
 FindVertexDelays::FindVertexDelays(GraphDelayCalc1 *graph_delay_calc1,
+				   const Corner *corner,
 				   ArcDelayCalc *arc_delay_calc,
 				   bool own_arc_delay_calc) :
   VertexVisitor(),
   graph_delay_calc1_(graph_delay_calc1),
+  corner_(corner),
   arc_delay_calc_(arc_delay_calc),
   own_arc_delay_calc_(own_arc_delay_calc)
 {
@@ -386,13 +399,28 @@ FindVertexDelays::copy()
 {
   // Copy StaState::arc_delay_calc_ because it needs separate state
   // for each thread.
-  return new FindVertexDelays(graph_delay_calc1_,arc_delay_calc_->copy(),true);
+  return new FindVertexDelays(graph_delay_calc1_, corner_,
+			      arc_delay_calc_->copy(), true);
 }
 
 void
 FindVertexDelays::visit(Vertex *vertex)
 {
-  graph_delay_calc1_->findVertexDelay(vertex, arc_delay_calc_, true);
+  graph_delay_calc1_->findVertexDelay(vertex, corner_, arc_delay_calc_, true);
+}
+
+bool
+FindVertexDelays::splitVisit(Vertex *vertex)
+{
+  return graph_delay_calc1_->cornerSplit(vertex);
+}
+
+// Vertices that are not split are only visited by the first corner
+// visitor, which finds them for all corners.
+void
+FindVertexDelays::visitUnsplit(Vertex *vertex)
+{
+  graph_delay_calc1_->findVertexDelay(vertex, nullptr, arc_delay_calc_, true);
 }
 
 // The logical structure of incremental delay calculation closely
@@ -416,8 +444,22 @@ GraphDelayCalc1::findDelays(Level level)
     if (incremental_)
       seedInvalidDelays();
 
-    FindVertexDelays visitor(this, arc_delay_calc_, false);
-    dcalc_count += iter_->visitParallel(level, &visitor);
+    if (corner_parallel_
+	&& corners_->multiCorner()
+	&& thread_count_ > 1) {
+      // Each corner of a vertex is an independent task.
+      VertexVisitorSeq corner_visitors;
+      for (Corner *corner : *corners_)
+	corner_visitors.push_back(new FindVertexDelays(this, corner,
+						       arc_delay_calc_,
+						       false));
+      dcalc_count += iter_->visitParallel(level, corner_visitors);
+      corner_visitors.deleteContents();
+    }
+    else {
+      FindVertexDelays visitor(this, nullptr, arc_delay_calc_, false);
+      dcalc_count += iter_->visitParallel(level, &visitor);
+    }
 
     // Timing checks require slews at both ends of the arc,
     // so find their delays after all slews are known.
@@ -831,11 +873,19 @@ GraphDelayCalc1::findInputArcDelay(LibertyCell *drvr_cell,
 void
 GraphDelayCalc1::findDelays(Vertex *drvr_vertex)
 {
-  findVertexDelay(drvr_vertex, arc_delay_calc_, true);
+  findVertexDelay(drvr_vertex, nullptr, arc_delay_calc_, true);
 }
 
+void
+GraphDelayCalc1::setCornerParallel(bool parallel)
+{
+  corner_parallel_ = parallel;
+}
+
+// corner=nullptr finds delays for all corners.
 void
 GraphDelayCalc1::findVertexDelay(Vertex *vertex,
+				 const Corner *corner,
 				 ArcDelayCalc *arc_delay_calc,
 				 bool propagate)
 {
@@ -847,7 +897,7 @@ GraphDelayCalc1::findVertexDelay(Vertex *vertex,
                network_->cellName(network_->instance(pin)));
     if (network_->isLeaf(pin)) {
       if (vertex->isDriver(network_)) {
-	bool delay_changed = findDriverDelays(vertex, arc_delay_calc);
+	bool delay_changed = findDriverDelays(vertex, corner, arc_delay_calc);
 	if (propagate) {
 	  if (network_->direction(pin)->isInternal())
 	    enqueueTimingChecksEdges(vertex);
@@ -873,6 +923,39 @@ GraphDelayCalc1::findVertexDelay(Vertex *vertex,
   }
 }
 
+// Return true if the corners of vertex can be found as separate tasks.
+// Multiple driver nets share state across corners. Loads and bidirect
+// ports only enqueue and seed vertices so one task is sufficient.
+// Reducing a parasitic network deletes the reduced parasitics of every
+// analysis point when the driver is finished.
+// The driver decision is cached until the driver delays are invalid
+// because finding the parasitic networks is not free.
+// Only called by BfsIterator::visitParallel from the main thread.
+bool
+GraphDelayCalc1::cornerSplit(Vertex *vertex)
+{
+  const Pin *pin = vertex->pin();
+  if (!(vertex->isDriver(network_) && network_->isLeaf(pin))
+      || multiDrvrNet(vertex))
+    return false;
+  bool split;
+  bool exists;
+  corner_splits_.findKey(vertex, split, exists);
+  if (!exists) {
+    split = true;
+    if (parasitics_->haveParasitics()) {
+      for (ParasiticAnalysisPt *ap : corners_->parasiticAnalysisPts()) {
+	if (parasitics_->findParasiticNetwork(pin, ap)) {
+	  split = false;
+	  break;
+	}
+      }
+    }
+    corner_splits_[vertex] = split;
+  }
+  return split;
+}
+
 void
 GraphDelayCalc1::enqueueTimingChecksEdges(Vertex *vertex)
 {
@@ -885,6 +968,7 @@ GraphDelayCalc1::enqueueTimingChecksEdges(Vertex *vertex)
 
 bool
 GraphDelayCalc1::findDriverDelays(Vertex *drvr_vertex,
+				  const Corner *corner,
 				  ArcDelayCalc *arc_delay_calc)
 {
   bool delay_changed = false;
@@ -899,13 +983,14 @@ GraphDelayCalc1::findDriverDelays(Vertex *drvr_vertex,
 	// Only init load slews once so previous driver dcalc results
 	// aren't clobbered.
 	delay_changed |= findDriverDelays1(drvr_vertex, init_load_slews,
-					   multi_drvr, arc_delay_calc);
+					   multi_drvr, nullptr, arc_delay_calc);
 	init_load_slews = false;
       }
     }
   }
   else
-    delay_changed = findDriverDelays1(drvr_vertex, true, nullptr, arc_delay_calc);
+    delay_changed = findDriverDelays1(drvr_vertex, true, nullptr, corner,
+				      arc_delay_calc);
   arc_delay_calc->finishDrvrPin();
   return delay_changed;
 }
@@ -914,13 +999,14 @@ bool
 GraphDelayCalc1::findDriverDelays1(Vertex *drvr_vertex,
 				   bool init_load_slews,
 				   MultiDrvrNet *multi_drvr,
+				   const Corner *corner,
 				   ArcDelayCalc *arc_delay_calc)
 {
   const Pin *drvr_pin = drvr_vertex->pin();
   Instance *drvr_inst = network_->instance(drvr_pin);
   LibertyCell *drvr_cell = network_->libertyCell(drvr_inst);
-  initSlew(drvr_vertex);
-  initWireDelays(drvr_vertex, init_load_slews);
+  initSlew(drvr_vertex, corner);
+  initWireDelays(drvr_vertex, init_load_slews, corner);
   bool delay_changed = false;
   VertexInEdgeIterator edge_iter(drvr_vertex, graph_);
   while (edge_iter.hasNext()) {
@@ -931,7 +1017,7 @@ GraphDelayCalc1::findDriverDelays1(Vertex *drvr_vertex,
 	&& search_pred_->searchThru(edge))
       delay_changed |= findDriverEdgeDelays(drvr_cell, drvr_inst, drvr_pin,
 					    drvr_vertex, multi_drvr, edge,
-					    arc_delay_calc);
+					    corner, arc_delay_calc);
   }
   if (delay_changed && observer_)
     observer_->delayChangedTo(drvr_vertex);
@@ -960,6 +1046,7 @@ GraphDelayCalc1::findDriverEdgeDelays(LibertyCell *drvr_cell,
 				      Vertex *drvr_vertex,
 				      MultiDrvrNet *multi_drvr,
 				      Edge *edge,
+				      const Corner *corner,
 				      ArcDelayCalc *arc_delay_calc)
 {
   Vertex *in_vertex = edge->from(graph_);
@@ -969,7 +1056,7 @@ GraphDelayCalc1::findDriverEdgeDelays(LibertyCell *drvr_cell,
   bool delay_changed = false;
   if (related_out_port)
     related_out_pin = network_->findPin(drvr_inst, related_out_port);
-  for (auto dcalc_ap : corners_->dcalcAnalysisPts()) {
+  for (auto dcalc_ap : dcalcAnalysisPts(corner)) {
     const Pvt *pvt = sdc_->pvt(drvr_inst, dcalc_ap->constraintMinMax());
     if (pvt == nullptr)
       pvt = dcalc_ap->operatingConditions();
@@ -1130,9 +1217,16 @@ GraphDelayCalc1::netCaps(const Pin *drvr_pin,
 
 void
 GraphDelayCalc1::initSlew(Vertex *vertex)
+{
+  initSlew(vertex, nullptr);
+}
+
+void
+GraphDelayCalc1::initSlew(Vertex *vertex,
+			  const Corner *corner)
 {
   for (auto tr : RiseFall::range()) {
-    for (auto dcalc_ap : corners_->dcalcAnalysisPts()) {
+    for (auto dcalc_ap : dcalcAnalysisPts(corner)) {
       const MinMax *slew_min_max = dcalc_ap->slewMinMax();
       if (!vertex->slewAnnotated(tr, slew_min_max)) {
 	DcalcAPIndex ap_index = dcalc_ap->index();
@@ -1142,17 +1236,28 @@ GraphDelayCalc1::initSlew(Vertex *vertex)
   }
 }
 
+// Delay calc analysis points of corner, or all of them if corner=nullptr.
+const DcalcAnalysisPtSeq &
+GraphDelayCalc1::dcalcAnalysisPts(const Corner *corner) const
+{
+  if (corner)
+    return corner->dcalcAnalysisPts();
+  else
+    return corners_->dcalcAnalysisPts();
+}
+
 // Init wire delays and load slews.
 void
 GraphDelayCalc1::initWireDelays(Vertex *drvr_vertex,
-				bool init_load_slews)
+				bool init_load_slews,
+				const Corner *corner)
 {
   VertexOutEdgeIterator edge_iter(drvr_vertex, graph_);
   while (edge_iter.hasNext()) {
     Edge *wire_edge = edge_iter.next();
     if (wire_edge->isWire()) {
       Vertex *load_vertex = wire_edge->to(graph_);
-      for (auto dcalc_ap : corners_->dcalcAnalysisPts()) {
+      for (auto dcalc_ap : dcalcAnalysisPts(corner)) {
 	const MinMax *delay_min_max = dcalc_ap->delayMinMax();
 	const MinMax *slew_min_max = dcalc_ap->slewMinMax();
 	Delay delay_init_value(delay_min_max->initValue());
@@ -1479,7 +1584,7 @@ GraphDelayCalc1::findCheckDelays(Vertex *vertex,
 	Edge *edge = edge_iter.next();
 	Vertex *to_vertex = edge->to(graph_);
 	if (edge->role() == TimingRole::latchDtoQ())
-	  findVertexDelay(to_vertex, arc_delay_calc_, false);
+	  findVertexDelay(to_vertex, nullptr, arc_delay_calc_, false);
       }
     }
   }
@@ -1678,4 +1783,222 @@ GraphDelayCalc1::reportDelayCalc(Edge *edge,
   return result;
 }
 
+////////////////////////////////////////////////////////////////
+
+void
+GraphDelayCalc1::swapCellDelays(const Instance *inst,
+				LibertyCell *swap_cell,
+				const Corner *corner,
+				SwapCellDelaySeq &delays)
+{
+  // The arc delay calculators keep state between gateDelay and
+  // loadDelay so use a private copy.
+  ArcDelayCalc *arc_delay_calc = arc_delay_calc_->copy();
+  InstancePinIterator *pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    Pin *pin = pin_iter->next();
+    if (network_->isLoad(pin))
+      swapCellLoadDelays(pin, swap_cell, corner, arc_delay_calc, delays);
+    if (network_->isDriver(pin)) {
+      Vertex *drvr_vertex = graph_->pinDrvrVertex(pin);
+      if (drvr_vertex)
+	swapCellDrvrDelays(drvr_vertex, swap_cell, corner,
+			   arc_delay_calc, delays);
+    }
+  }
+  delete pin_iter;
+  delete arc_delay_calc;
+}
+
+// Gate delays to drvr_vertex with the swap cell timing arcs and the
+// wire delays to its loads.
+void
+GraphDelayCalc1::swapCellDrvrDelays(Vertex *drvr_vertex,
+				    LibertyCell *swap_cell,
+				    const Corner *corner,
+				    ArcDelayCalc *arc_delay_calc,
+				    SwapCellDelaySeq &delays)
+{
+  const Pin *drvr_pin = drvr_vertex->pin();
+  Instance *drvr_inst = network_->instance(drvr_pin);
+  UniqueLock lock(swapCellDrvrLock(drvr_pin));
+  VertexInEdgeIterator edge_iter(drvr_vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *edge = edge_iter.next();
+    Vertex *from_vertex = edge->from(graph_);
+    TimingArcSet *arc_set = edge->timingArcSet();
+    TimingArcSet *swap_arc_set = swap_cell->findTimingArcSet(arc_set);
+    if (swap_arc_set
+	&& search_pred_->searchFrom(from_vertex)
+	&& search_pred_->searchThru(edge)) {
+      const LibertyPort *related_out_port = arc_set->relatedOut();
+      const Pin *related_out_pin = nullptr;
+      if (related_out_port)
+	related_out_pin = network_->findPin(drvr_inst, related_out_port);
+      for (auto dcalc_ap : dcalcAnalysisPts(corner)) {
+	DcalcAPIndex ap_index = dcalc_ap->index();
+	const Pvt *pvt = sdc_->pvt(drvr_inst, dcalc_ap->constraintMinMax());
+	if (pvt == nullptr)
+	  pvt = dcalc_ap->operatingConditions();
+	for (TimingArc *arc : arc_set->arcs()) {
+	  TimingArc *swap_arc = swap_arc_set->findTimingArc(arc->index());
+	  RiseFall *from_rf = arc->fromTrans()->asRiseFall();
+	  RiseFall *drvr_rf = arc->toTrans()->asRiseFall();
+	  if (swap_arc && from_rf && drvr_rf) {
+	    Parasitic *parasitic = arc_delay_calc->findParasitic(drvr_pin, drvr_rf,
+								 dcalc_ap);
+	    float related_out_cap = 0.0;
+	    if (related_out_pin) {
+	      Parasitic *related_out_parasitic =
+		arc_delay_calc->findParasitic(related_out_pin, drvr_rf, dcalc_ap);
+	      related_out_cap = loadCap(related_out_pin, related_out_parasitic,
+					drvr_rf, dcalc_ap);
+	    }
+	    const Slew from_slew = edgeFromSlew(from_vertex, from_rf, edge,
+						dcalc_ap);
+	    float load_cap = loadCap(drvr_pin, parasitic, drvr_rf, dcalc_ap);
+	    ArcDelay gate_delay;
+	    Slew gate_slew;
+	    arc_delay_calc->gateDelay(swap_cell, swap_arc, from_slew,
+				      load_cap, parasitic, related_out_cap,
+				      pvt, dcalc_ap, gate_delay, gate_slew);
+	    const ArcDelay &prev_gate_delay = graph_->arcDelay(edge, arc,
+								ap_index);
+	    const Slew &prev_drvr_slew = graph_->slew(drvr_vertex, drvr_rf,
+						      ap_index);
+	    // Annotated delays and slews do not change.
+	    if (graph_->arcDelayAnnotated(edge, arc, ap_index))
+	      gate_delay = prev_gate_delay;
+	    const MinMax *slew_min_max = dcalc_ap->slewMinMax();
+	    if (drvr_vertex->slewAnnotated(drvr_rf, slew_min_max))
+	      gate_slew = prev_drvr_slew;
+	    delays.push_back({edge, arc, ap_index, gate_delay, prev_gate_delay,
+			      gate_slew, prev_drvr_slew});
+
+	    VertexOutEdgeIterator wire_iter(drvr_vertex, graph_);
+	    while (wire_iter.hasNext()) {
+	      Edge *wire_edge = wire_iter.next();
+	      if (wire_edge->isWire()) {
+		Vertex *load_vertex = wire_edge->to(graph_);
+		ArcDelay wire_delay;
+		Slew load_slew;
+		arc_delay_calc->loadDelay(load_vertex->pin(),
+					  wire_delay, load_slew);
+		const ArcDelay &prev_wire_delay =
+		  graph_->wireArcDelay(wire_edge, drvr_rf, ap_index);
+		const Slew &prev_load_slew = graph_->slew(load_vertex, drvr_rf,
+							  ap_index);
+		if (graph_->wireDelayAnnotated(wire_edge, drvr_rf, ap_index))
+		  wire_delay = prev_wire_delay;
+		if (load_vertex->slewAnnotated(drvr_rf, slew_min_max))
+		  load_slew = prev_load_slew;
+		delays.push_back({wire_edge, arc, ap_index,
+				  wire_delay, prev_wire_delay,
+				  load_slew, prev_load_slew});
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+  arc_delay_calc->finishDrvrPin();
+}
+
+// The swap cell input pin capacitance changes the load of the drivers
+// of load_pin. Their delays and slews are estimated by adding the
+// change in lumped capacitance delay/slew to the current values.
+void
+GraphDelayCalc1::swapCellLoadDelays(const Pin *load_pin,
+				    LibertyCell *swap_cell,
+				    const Corner *corner,
+				    ArcDelayCalc *arc_delay_calc,
+				    SwapCellDelaySeq &delays)
+{
+  Instance *inst = network_->instance(load_pin);
+  LibertyPort *port = network_->libertyPort(load_pin);
+  LibertyPort *swap_port = port
+    ? swap_cell->findLibertyPort(port->name())
+    : nullptr;
+  Vertex *load_vertex = graph_->pinLoadVertex(load_pin);
+  if (swap_port && load_vertex) {
+    VertexInEdgeIterator wire_iter(load_vertex, graph_);
+    while (wire_iter.hasNext()) {
+      Edge *wire_edge = wire_iter.next();
+      if (wire_edge->isWire()) {
+	Vertex *drvr_vertex = wire_edge->from(graph_);
+	const Pin *drvr_pin = drvr_vertex->pin();
+	Instance *drvr_inst = network_->instance(drvr_pin);
+	LibertyCell *drvr_cell = network_->libertyCell(drvr_inst);
+	if (drvr_cell) {
+	  UniqueLock lock(swapCellDrvrLock(drvr_pin));
+	  VertexInEdgeIterator edge_iter(drvr_vertex, graph_);
+	  while (edge_iter.hasNext()) {
+	    Edge *edge = edge_iter.next();
+	    Vertex *from_vertex = edge->from(graph_);
+	    if (search_pred_->searchFrom(from_vertex)
+		&& search_pred_->searchThru(edge)) {
+	      for (auto dcalc_ap : dcalcAnalysisPts(corner)) {
+		DcalcAPIndex ap_index = dcalc_ap->index();
+		const MinMax *cnst_min_max = dcalc_ap->constraintMinMax();
+		const OperatingConditions *op_cond = dcalc_ap->operatingConditions();
+		const Pvt *pvt = sdc_->pvt(drvr_inst, cnst_min_max);
+		if (pvt == nullptr)
+		  pvt = op_cond;
+		for (TimingArc *arc : edge->timingArcSet()->arcs()) {
+		  RiseFall *from_rf = arc->fromTrans()->asRiseFall();
+		  RiseFall *drvr_rf = arc->toTrans()->asRiseFall();
+		  if (from_rf && drvr_rf
+		      && !graph_->arcDelayAnnotated(edge, arc, ap_index)) {
+		    float cap_delta =
+		      sdc_->portCapacitance(inst, swap_port, drvr_rf, op_cond,
+					    dcalc_ap->corner(), cnst_min_max)
+		      - sdc_->portCapacitance(inst, port, drvr_rf, op_cond,
+					      dcalc_ap->corner(), cnst_min_max);
+		    if (cap_delta != 0.0) {
+		      Parasitic *parasitic =
+			arc_delay_calc->findParasitic(drvr_pin, drvr_rf, dcalc_ap);
+		      float load_cap = loadCap(drvr_pin, parasitic, drvr_rf,
+					       dcalc_ap);
+		      const Slew from_slew = edgeFromSlew(from_vertex, from_rf,
+							  edge, dcalc_ap);
+		      ArcDelay delay1, delay2;
+		      Slew slew1, slew2;
+		      arc_delay_calc->gateDelay(drvr_cell, arc, from_slew,
+						load_cap, nullptr, 0.0, pvt,
+						dcalc_ap, delay1, slew1);
+		      arc_delay_calc->gateDelay(drvr_cell, arc, from_slew,
+						load_cap + cap_delta, nullptr,
+						0.0, pvt, dcalc_ap,
+						delay2, slew2);
+		      const ArcDelay &prev_delay = graph_->arcDelay(edge, arc,
+								     ap_index);
+		      const Slew &prev_slew = graph_->slew(drvr_vertex, drvr_rf,
+							   ap_index);
+		      Slew slew = prev_slew;
+		      if (!drvr_vertex->slewAnnotated(drvr_rf,
+						      dcalc_ap->slewMinMax()))
+			slew += slew2 - slew1;
+		      delays.push_back({edge, arc, ap_index,
+					prev_delay + delay2 - delay1, prev_delay,
+					slew, prev_slew});
+		    }
+		  }
+		}
+	      }
+	    }
+	  }
+	  arc_delay_calc->finishDrvrPin();
+	}
+      }
+    }
+  }
+}
+
+std::mutex &
+GraphDelayCalc1::swapCellDrvrLock(const Pin *drvr_pin)
+{
+  return swap_cell_drvr_locks_[hashPtr(drvr_pin) % swap_cell_drvr_lock_count];
+}
+
 } // namespace
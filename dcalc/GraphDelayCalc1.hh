@@ -20,14 +20,15 @@
 
 #include "Delay.hh"
 #include "GraphDelayCalc.hh"
+#include "Corner.hh"
 
 namespace sta {
 
 class MultiDrvrNet;
 class FindVertexDelays;
-class Corner;
 
 typedef Map<const Vertex*, MultiDrvrNet*> MultiDrvrNetMap;
+typedef Map<const Vertex*, bool> VertexCornerSplitMap;
 
 // This class traverses the graph calling the arc delay calculator and
 // annotating delays on graph edges.
@@ -51,6 +52,8 @@ public:
 				  int digits);
   virtual float incrementalDelayTolerance();
   virtual void setIncrementalDelayTolerance(float tol);
+  virtual bool cornerParallel() const { return corner_parallel_; }
+  virtual void setCornerParallel(bool parallel);
   virtual void setObserver(DelayCalcObserver *observer);
   // Load pin_cap + wire_cap.
   virtual float loadCap(const Pin *drvr_pin,
@@ -80,12 +83,18 @@ public:
   float ceff(Edge *edge,
 	     TimingArc *arc,
 	     const DcalcAnalysisPt *dcalc_ap);
+  virtual void swapCellDelays(const Instance *inst,
+			      LibertyCell *swap_cell,
+			      const Corner *corner,
+			      SwapCellDelaySeq &delays);
 
 protected:
   void seedInvalidDelays();
   void ensureMultiDrvrNetsFound();
   void makeMultiDrvrNet(PinSet &drvr_pins);
   void initSlew(Vertex *vertex);
+  void initSlew(Vertex *vertex,
+		const Corner *corner);
   void seedRootSlew(Vertex *vertex,
 		    ArcDelayCalc *arc_delay_calc);
   void seedRootSlews();
@@ -123,10 +132,12 @@ protected:
 			 float from_slew,
 			 DcalcAnalysisPt *dcalc_ap);
   bool findDriverDelays(Vertex *drvr_vertex,
+			const Corner *corner,
 			ArcDelayCalc *arc_delay_calc);
   bool findDriverDelays1(Vertex *drvr_vertex,
 			 bool init_load_slews,
 			 MultiDrvrNet *multi_drvr,
+			 const Corner *corner,
 			 ArcDelayCalc *arc_delay_calc);
   bool findDriverEdgeDelays(LibertyCell *drvr_cell,
 			    Instance *drvr_inst,
@@ -134,13 +145,18 @@ protected:
 			    Vertex *drvr_vertex,
 			    MultiDrvrNet *multi_drvr,
 			    Edge *edge,
+			    const Corner *corner,
 			    ArcDelayCalc *arc_delay_calc);
   void initWireDelays(Vertex *drvr_vertex,
-		      bool init_load_slews);
+		      bool init_load_slews,
+		      const Corner *corner);
+  const DcalcAnalysisPtSeq &dcalcAnalysisPts(const Corner *corner) const;
   void initRootSlews(Vertex *vertex);
   void findVertexDelay(Vertex *vertex,
+		       const Corner *corner,
 		       ArcDelayCalc *arc_delay_calc,
 		       bool propagate);
+  bool cornerSplit(Vertex *vertex);
   void enqueueTimingChecksEdges(Vertex *vertex);
   bool findArcDelay(LibertyCell *drvr_cell,
 		    const Pin *drvr_pin,
@@ -208,6 +224,17 @@ protected:
 		Parasitic *drvr_parasitic,
 		const RiseFall *rf,
 		const DcalcAnalysisPt *dcalc_ap) const;
+  void swapCellDrvrDelays(Vertex *drvr_vertex,
+			  LibertyCell *swap_cell,
+			  const Corner *corner,
+			  ArcDelayCalc *arc_delay_calc,
+			  SwapCellDelaySeq &delays);
+  void swapCellLoadDelays(const Pin *load_pin,
+			  LibertyCell *swap_cell,
+			  const Corner *corner,
+			  ArcDelayCalc *arc_delay_calc,
+			  SwapCellDelaySeq &delays);
+  std::mutex &swapCellDrvrLock(const Pin *drvr_pin);
 
   // Observer for edge delay changes.
   DelayCalcObserver *observer_;
@@ -228,6 +255,15 @@ protected:
   // Percentage (0.0:1.0) change in delay that causes downstream
   // delays to be recomputed during incremental delay calculation.
   float incremental_delay_tolerance_;
+  // Find the delays for each corner of a vertex in separate threads.
+  bool corner_parallel_;
+  // cornerSplit results for driver vertices.
+  VertexCornerSplitMap corner_splits_;
+  // Drivers with parasitic networks reduce and delete their reduced
+  // parasitics in the shared Parasitics, so swapCellDelays only
+  // evaluates a driver in one thread at a time.
+  static const int swap_cell_drvr_lock_count = 64;
+  std::mutex swap_cell_drvr_locks_[swap_cell_drvr_lock_count];
 
   friend class FindVertexDelays;
   friend class MultiDrvrNet;
@@ -88,10 +88,8 @@ LumpedCapDelayCalc::findParasitic(const Pin *drvr_pin,
 						dcalc_ap->corner(),
 						cnst_min_max,
 						parasitic_ap);
-      // Estimated parasitics are not recorded in the "database", so
-      // it for deletion after the drvr pin delay calc is finished.
-      if (parasitic)
-	unsaved_parasitics_.push_back(parasitic);
+      // Estimated parasitics are kept by the parasitics and reused
+      // by incremental delay calculation.
       return parasitic;
     }
   }
@@ -107,9 +105,6 @@ LumpedCapDelayCalc::reducedParasiticType() const
 void
 LumpedCapDelayCalc::finishDrvrPin()
 {
-  for (auto parasitic : unsaved_parasitics_)
-    parasitics_->deleteUnsavedParasitic(parasitic);
-  unsaved_parasitics_.clear();
   for (auto drvr_pin : reduced_parasitic_drvrs_)
     parasitics_->deleteDrvrReducedParasitics(drvr_pin);
   reduced_parasitic_drvrs_.clear();
@@ -103,10 +103,8 @@ protected:
   float multi_drvr_slew_factor_;
   const LibertyLibrary *drvr_library_;
   const RiseFall *drvr_rf_;
-  // Parasitics returned by findParasitic that are reduced or estimated
-  // that can be deleted after delay calculation for the driver pin
-  // is finished.
-  Vector<Parasitic*> unsaved_parasitics_;
+  // Drivers with parasitics reduced by findParasitic that can be
+  // deleted after delay calculation for the driver pin is finished.
   Vector<const Pin *> reduced_parasitic_drvrs_;
 };
 
@@ -21,7 +21,6 @@
 #include "Error.hh"
 #include "Debug.hh"
 #include "MinMax.hh"
-#include "Mutex.hh"
 #include "Transition.hh"
 #include "TimingRole.hh"
 #include "TimingArc.hh"
@@ -29,6 +28,8 @@
 #include "PortDirection.hh"
 #include "Network.hh"
 #include "DcalcAnalysisPt.hh"
+#include "DispatchQueue.hh"
+#include "Report.hh"
 
 namespace sta {
 
@@ -52,6 +53,8 @@ Graph::Graph(StaState *sta,
   width_check_annotations_(nullptr),
   period_check_annotations_(nullptr)
 {
+  arrivals_.setThreadCount(thread_count_);
+  prev_paths_.setThreadCount(thread_count_);
 }
 
 Graph::~Graph()
@@ -365,6 +368,18 @@ Graph::id(const Vertex *vertex) const
   return vertices_->objectId(vertex);
 }
 
+bool
+Graph::isValidVertexId(VertexId vertex_id) const
+{
+  return vertices_->isValid(vertex_id);
+}
+
+VertexId
+Graph::vertexIdEnd() const
+{
+  return vertices_->idEnd();
+}
+
 void
 Graph::makePinVertices(Pin *pin)
 {
@@ -500,16 +515,21 @@ Graph::deleteOutEdge(Vertex *vertex,
     Graph::edge(next)->vertex_out_prev_ = prev;
 }
 
+void
+Graph::copyState(const StaState *sta)
+{
+  StaState::copyState(sta);
+  arrivals_.setThreadCount(thread_count_);
+  prev_paths_.setThreadCount(thread_count_);
+}
+
 Arrival *
 Graph::makeArrivals(Vertex *vertex,
 		    uint32_t count)
 {
   Arrival *arrivals;
   ArrivalId id;
-  {
-    UniqueLock lock(arrivals_lock_);
-    arrivals_.make(count, arrivals, id);
-  }
+  arrivals_.make(count, DispatchQueue::threadIndex(), arrivals, id);
   vertex->setArrivals(id);
   return arrivals;
 }
@@ -520,6 +540,13 @@ Graph::arrivals(Vertex *vertex)
   return arrivals_.pointer(vertex->arrivals());
 }
 
+void
+Graph::deleteArrivals(ArrivalId id,
+		      uint32_t count)
+{
+  arrivals_.destroy(id, count, DispatchQueue::threadIndex());
+}
+
 void
 Graph::clearArrivals()
 {
@@ -532,10 +559,7 @@ Graph::makePrevPaths(Vertex *vertex,
 {
   PathVertexRep *prev_paths;
   PrevPathId id;
-  {
-    UniqueLock lock(prev_paths_lock_);
-    prev_paths_.make(count, prev_paths, id);
-  }
+  prev_paths_.make(count, DispatchQueue::threadIndex(), prev_paths, id);
   vertex->setPrevPaths(id);
   return prev_paths;
 }
@@ -546,12 +570,121 @@ Graph::prevPaths(Vertex *vertex) const
   return prev_paths_.pointer(vertex->prevPaths());
 }
 
+void
+Graph::deletePrevPaths(PrevPathId id,
+		       uint32_t count)
+{
+  prev_paths_.destroy(id, count, DispatchQueue::threadIndex());
+}
+
 void
 Graph::clearPrevPaths()
 {
   prev_paths_.clear();
 }
 
+void
+Graph::compactPaths(const PathArrayCountFunc &array_counts)
+{
+  ArrivalsTable arrivals;
+  PrevPathsTable prev_paths;
+  VertexIterator vertex_iter(this);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    uint32_t arrival_count, prev_path_count;
+    array_counts(vertex, arrival_count, prev_path_count);
+    Arrival *from_arrivals = arrivals_.pointer(vertex->arrivals());
+    if (from_arrivals && arrival_count > 0) {
+      Arrival *to_arrivals;
+      ArrivalId id;
+      arrivals.make(arrival_count, to_arrivals, id);
+      for (uint32_t i = 0; i < arrival_count; i++)
+	to_arrivals[i] = from_arrivals[i];
+      vertex->setArrivals(id);
+    }
+    PathVertexRep *from_prev_paths = prev_paths_.pointer(vertex->prevPaths());
+    if (from_prev_paths && prev_path_count > 0) {
+      PathVertexRep *to_prev_paths;
+      PrevPathId id;
+      prev_paths.make(prev_path_count, to_prev_paths, id);
+      for (uint32_t i = 0; i < prev_path_count; i++)
+	to_prev_paths[i].init(from_prev_paths[i]);
+      vertex->setPrevPaths(id);
+    }
+  }
+  arrivals_.swap(arrivals);
+  prev_paths_.swap(prev_paths);
+  arrivals_.setThreadCount(thread_count_);
+  prev_paths_.setThreadCount(thread_count_);
+}
+
+void
+Graph::swapPaths(GraphPaths &paths)
+{
+  std::vector<VertexPaths> vertex_paths(vertexIdEnd());
+  VertexIterator vertex_iter(this);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    VertexId vertex_id = id(vertex);
+    VertexPaths &to = vertex_paths[vertex_id];
+    to.arrivals_ = vertex->arrivals_;
+    to.prev_paths_ = vertex->prev_paths_;
+    to.tag_group_index_ = vertex->tag_group_index_;
+    to.has_requireds_ = vertex->has_requireds_;
+    to.crpr_path_pruning_disabled_ = vertex->crpr_path_pruning_disabled_;
+    to.requireds_pruned_ = vertex->requireds_pruned_;
+    if (vertex_id < paths.vertex_paths_.size()) {
+      const VertexPaths &from = paths.vertex_paths_[vertex_id];
+      vertex->arrivals_ = from.arrivals_;
+      vertex->prev_paths_ = from.prev_paths_;
+      vertex->tag_group_index_ = from.tag_group_index_;
+      vertex->has_requireds_ = from.has_requireds_;
+      vertex->crpr_path_pruning_disabled_ = from.crpr_path_pruning_disabled_;
+      vertex->requireds_pruned_ = from.requireds_pruned_;
+    }
+    else {
+      vertex->deletePaths();
+      vertex->requireds_pruned_ = false;
+    }
+  }
+  paths.vertex_paths_.swap(vertex_paths);
+  arrivals_.swap(paths.arrivals_);
+  prev_paths_.swap(paths.prev_paths_);
+  arrivals_.setThreadCount(thread_count_);
+  prev_paths_.setThreadCount(thread_count_);
+}
+
+void
+GraphPaths::clear()
+{
+  arrivals_.clear();
+  prev_paths_.clear();
+  vertex_paths_.clear();
+}
+
+// Live objects are referenced by vertices. Free objects are in deleted
+// arrays waiting for reuse. The rest of the blocks are dead.
+void
+Graph::reportPathMemory() const
+{
+  size_t arrivals_live = arrivals_.size();
+  size_t arrivals_free = arrivals_.freeSize();
+  size_t arrivals_capacity = arrivals_.capacity();
+  report_->reportLine("Arrivals   live %10zu free %10zu dead %10zu %6.1fMb",
+                      arrivals_live,
+                      arrivals_free,
+                      arrivals_capacity - arrivals_live - arrivals_free,
+                      arrivals_capacity * sizeof(Arrival) * 1e-6);
+  size_t prev_paths_live = prev_paths_.size();
+  size_t prev_paths_free = prev_paths_.freeSize();
+  size_t prev_paths_capacity = prev_paths_.capacity();
+  report_->reportLine("Prev paths live %10zu free %10zu dead %10zu %6.1fMb",
+                      prev_paths_live,
+                      prev_paths_free,
+                      prev_paths_capacity - prev_paths_live - prev_paths_free,
+                      prev_paths_capacity * sizeof(PathVertexRep) * 1e-6);
+}
+
 const Slew &
 Graph::slew(const Vertex *vertex,
 	    const RiseFall *rf,
@@ -600,6 +733,12 @@ Graph::id(const Edge *edge) const
   return edges_->objectId(edge);
 }
 
+bool
+Graph::isValidEdgeId(EdgeId edge_id) const
+{
+  return edges_->isValid(edge_id);
+}
+
 Edge *
 Graph::makeEdge(Vertex *from,
 		Vertex *to,
@@ -10,21 +10,35 @@
 #define STA_ARRAY_TABLE_H
 
 #include <string.h> // memcpy
+#include <mutex>
+#include <new>
+#include <vector>
 
 #include "ObjectId.hh"
 #include "Error.hh"
+#include "BlockArena.hh"
 
 namespace sta {
 
 template <class TYPE>
 class ArrayBlock;
 
+template <class TYPE>
+class ArrayTableThread;
+
 // Array tables allocate arrays of objects in blocks and use 32 bit IDs to
 // reference the array. Paging performance is improved by allocating
 // blocks instead of individual arrays, and object sizes are reduced
 // by using 32 bit references instead of 64 bit pointers.
-// They are similar to ObjectTables but do not support delete/destroy or
-// reclaiming deleted arrays.
+// Deleted arrays are kept on free lists by size for reuse. Arrays larger
+// than block_size are not reused.
+//
+// make/destroy with a thread_index (0 <= thread_index < threadCount())
+// allocate from the thread's own blocks and free lists, so threads
+// only lock to add a block. make/destroy without a thread_index are
+// serialized by the table.
+// Each thread makes its blocks from its own BlockArena, so the memory
+// is first touched (and placed on a NUMA node) by the thread using it.
 
 template <class TYPE>
 class ArrayTable
@@ -35,45 +49,112 @@ public:
   void make(uint32_t count,
 	    TYPE *&array,
 	    ObjectId &id);
+  void make(uint32_t count,
+	    int thread_index,
+	    TYPE *&array,
+	    ObjectId &id);
+  // count must be the count used to make the array.
+  void destroy(ObjectId id,
+	       uint32_t count);
+  void destroy(ObjectId id,
+	       uint32_t count,
+	       int thread_index);
   // Grow as necessary and return pointer for id.
   TYPE *ensureId(ObjectId id);
   TYPE *pointer(ObjectId id) const;
   TYPE &ref(ObjectId id) const;
-  size_t size() const { return size_; }
+  // Objects in arrays that have been made and not destroyed.
+  size_t size() const;
+  // Objects in destroyed arrays waiting to be reused.
+  size_t freeSize() const;
+  // Objects in all blocks.
+  size_t capacity() const { return capacity_; }
+  int threadCount() const { return thread_count_; }
+  // Not thread safe.
+  void setThreadCount(int thread_count);
   void clear();
+  // Exchange the arrays of two tables (not thread safe).
+  void swap(ArrayTable<TYPE> &table);
 
   static constexpr int idx_bits = 7;
   static constexpr int block_size = (1 << idx_bits);
   static constexpr int block_id_max = 1 << (object_id_bits - idx_bits);
 
 private:
-  ArrayBlock<TYPE> *makeBlock(uint32_t size);
+  void make(uint32_t count,
+	    ArrayTableThread<TYPE> &thread,
+	    TYPE *&array,
+	    ObjectId &id);
+  void destroy(ObjectId id,
+	       uint32_t count,
+	       ArrayTableThread<TYPE> &thread);
+  ArrayBlock<TYPE> *makeBlock(uint32_t size,
+			      ArrayTableThread<TYPE> &thread);
   void pushBlock(ArrayBlock<TYPE> *block);
   void deleteBlocks();
+  bool isThreadIndex(int thread_index) const;
+  void ensureArenas(size_t count);
 
-  size_t size_;
-  // Block index of free block (blocks_[size - 1]).
-  BlockIdx free_block_idx_;
-  // Index of next free object in free_block_idx_.
-  ObjectIdx free_idx_;
+  // Allocation state for each thread followed by the state shared by
+  // callers without a thread index.
+  std::vector<ArrayTableThread<TYPE>> threads_;
+  // Block memory. Arenas are kept for the life of their blocks
+  // when the thread count shrinks.
+  std::vector<BlockArena*> arenas_;
+  int thread_count_;
+  std::mutex lock_;
+  size_t capacity_;
   // Don't use std::vector so growing blocks_ can be thread safe.
   size_t blocks_size_;
   size_t blocks_capacity_;
   ArrayBlock<TYPE>* *blocks_;
   ArrayBlock<TYPE>* *prev_blocks_;
+  std::mutex blocks_lock_;
   static constexpr ObjectId idx_mask_ = block_size - 1;
 };
 
+// Array allocation state for one thread.
+template <class TYPE>
+class ArrayTableThread
+{
+public:
+  ArrayTableThread();
+  void clear();
+
+  BlockArena *arena_;
+  // The thread's block and its index.
+  ArrayBlock<TYPE> *block_;
+  BlockIdx block_idx_;
+  // Index of next free object in block_idx_.
+  ObjectIdx free_idx_;
+  uint32_t block_size_;
+  // Destroyed array ids indexed by array size.
+  std::vector<std::vector<ObjectId>> free_arrays_;
+  // Objects made - destroyed by this thread.
+  int64_t size_;
+  int64_t free_size_;
+};
+
 template <class TYPE>
 ArrayTable<TYPE>::ArrayTable() :
-  size_(0),
-  free_block_idx_(block_idx_null),
-  free_idx_(object_idx_null),
+  threads_(1),
+  thread_count_(0),
+  capacity_(0),
   blocks_size_(0),
   blocks_capacity_(1024),
   blocks_(new ArrayBlock<TYPE>*[blocks_capacity_]),
   prev_blocks_(nullptr)
 {
+  ensureArenas(1);
+  threads_.back().arena_ = arenas_[0];
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::ensureArenas(size_t count)
+{
+  while (arenas_.size() < count)
+    arenas_.push_back(new BlockArena);
 }
 
 template <class TYPE>
@@ -82,6 +163,8 @@ ArrayTable<TYPE>::~ArrayTable()
   deleteBlocks();
   delete [] blocks_;
   delete [] prev_blocks_;
+  for (BlockArena *arena : arenas_)
+    delete arena;
 }
 
 template <class TYPE>
@@ -92,36 +175,174 @@ ArrayTable<TYPE>::deleteBlocks()
     delete blocks_[i];
 }
 
+template <class TYPE>
+bool
+ArrayTable<TYPE>::isThreadIndex(int thread_index) const
+{
+  return thread_index >= 0 && thread_index < thread_count_;
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::setThreadCount(int thread_count)
+{
+  // Keep the shared state last and give it the arrays and counts
+  // of threads that go away.
+  ArrayTableThread<TYPE> shared = threads_.back();
+  for (int i = thread_count; i < thread_count_; i++) {
+    ArrayTableThread<TYPE> &thread = threads_[i];
+    if (thread.free_arrays_.size() > shared.free_arrays_.size())
+      shared.free_arrays_.resize(thread.free_arrays_.size());
+    for (size_t count = 0; count < thread.free_arrays_.size(); count++) {
+      std::vector<ObjectId> &free_ids = thread.free_arrays_[count];
+      shared.free_arrays_[count].insert(shared.free_arrays_[count].end(),
+					free_ids.begin(), free_ids.end());
+    }
+    shared.size_ += thread.size_;
+    shared.free_size_ += thread.free_size_;
+  }
+  threads_.resize(thread_count + 1);
+  threads_.back() = shared;
+  for (int i = thread_count_; i < thread_count; i++)
+    threads_[i].clear();
+  // The shared state keeps its arena; the threads use the others.
+  ensureArenas(thread_count + 1);
+  size_t arena_index = 0;
+  for (int i = 0; i < thread_count; i++) {
+    if (arenas_[arena_index] == shared.arena_)
+      arena_index++;
+    threads_[i].arena_ = arenas_[arena_index++];
+  }
+  thread_count_ = thread_count;
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::make(uint32_t count,
+		       TYPE *&array,
+		       ObjectId &id)
+{
+  std::unique_lock<std::mutex> lock(lock_);
+  make(count, threads_.back(), array, id);
+}
+
 template <class TYPE>
 void
 ArrayTable<TYPE>::make(uint32_t count,
+		       int thread_index,
 		       TYPE *&array,
 		       ObjectId &id)
 {
-  ArrayBlock<TYPE> *block = blocks_size_ ? blocks_[free_block_idx_] : nullptr;
-  if ((free_idx_ == object_idx_null
-       && free_block_idx_ == block_idx_null)
-      || free_idx_ + count >= block->size()) {
-    uint32_t size = (count > block_size) ? count : block_size;
-    block = makeBlock(size);
+  if (isThreadIndex(thread_index))
+    make(count, threads_[thread_index], array, id);
+  else
+    make(count, array, id);
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::make(uint32_t count,
+		       ArrayTableThread<TYPE> &thread,
+		       TYPE *&array,
+		       ObjectId &id)
+{
+  if (count < thread.free_arrays_.size()
+      && !thread.free_arrays_[count].empty()) {
+    id = thread.free_arrays_[count].back();
+    thread.free_arrays_[count].pop_back();
+    thread.free_size_ -= count;
+    array = pointer(id);
+  }
+  else {
+    if (thread.block_ == nullptr
+	|| thread.free_idx_ + count > thread.block_size_) {
+      // One extra object in case this is block zero, which starts at 1.
+      uint32_t size = (count >= block_size) ? count + 1 : block_size;
+      makeBlock(size, thread);
+    }
+    // makeId(block_idx_, idx_bits)
+    id = (thread.block_idx_ << idx_bits) + thread.free_idx_;
+    array = thread.block_->pointer(thread.free_idx_);
+    thread.free_idx_ += count;
+  }
+  thread.size_ += count;
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::destroy(ObjectId id,
+			  uint32_t count)
+{
+  std::unique_lock<std::mutex> lock(lock_);
+  destroy(id, count, threads_.back());
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::destroy(ObjectId id,
+			  uint32_t count,
+			  int thread_index)
+{
+  if (isThreadIndex(thread_index))
+    destroy(id, count, threads_[thread_index]);
+  else
+    destroy(id, count);
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::destroy(ObjectId id,
+			  uint32_t count,
+			  ArrayTableThread<TYPE> &thread)
+{
+  if (id != object_id_null) {
+    thread.size_ -= count;
+    // Arrays larger than a block have blocks of their own that are
+    // not worth keeping around.
+    if (count > 0 && count <= block_size) {
+      if (count >= thread.free_arrays_.size())
+	thread.free_arrays_.resize(count + 1);
+      thread.free_arrays_[count].push_back(id);
+      thread.free_size_ += count;
+    }
   }
-  // makeId(free_block_idx_, idx_bits)
-  id = (free_block_idx_ << idx_bits) + free_idx_;
-  array = block->pointer(free_idx_);
-  free_idx_ += count;
-  size_ += count;
+}
+
+template <class TYPE>
+size_t
+ArrayTable<TYPE>::size() const
+{
+  int64_t size = 0;
+  for (const ArrayTableThread<TYPE> &thread : threads_)
+    size += thread.size_;
+  return size;
+}
+
+template <class TYPE>
+size_t
+ArrayTable<TYPE>::freeSize() const
+{
+  int64_t free_size = 0;
+  for (const ArrayTableThread<TYPE> &thread : threads_)
+    free_size += thread.free_size_;
+  return free_size;
 }
 
 template <class TYPE>
 ArrayBlock<TYPE> *
-ArrayTable<TYPE>::makeBlock(uint32_t size)
+ArrayTable<TYPE>::makeBlock(uint32_t size,
+			    ArrayTableThread<TYPE> &thread)
 {
+  ArrayBlock<TYPE> *block = new ArrayBlock<TYPE>(size, *thread.arena_);
+  std::unique_lock<std::mutex> lock(blocks_lock_);
   BlockIdx block_idx = blocks_size_;
-  ArrayBlock<TYPE> *block = new ArrayBlock<TYPE>(size);
-  pushBlock(block); 
-  free_block_idx_ = block_idx;
+  pushBlock(block);
+  capacity_ += size;
+  thread.block_ = block;
+  thread.block_idx_ = block_idx;
+  thread.block_size_ = size;
   // ObjectId zero is reserved for object_id_null.
-  free_idx_ = (block_idx > 0) ? 0 : 1;
+  thread.free_idx_ = (block_idx > 0) ? 0 : 1;
   return block;
 }
 
@@ -166,8 +387,10 @@ ArrayTable<TYPE>::ensureId(ObjectId id)
   ObjectIdx obj_idx = id & idx_mask_;
   // Make enough blocks for blk_idx to be valid.
   for (BlockIdx i = blocks_size_; i <= blk_idx; i++) {
-    ArrayBlock<TYPE> *block = new ArrayBlock<TYPE>(block_size);
+    ArrayBlock<TYPE> *block = new ArrayBlock<TYPE>(block_size,
+						   *threads_.back().arena_);
     pushBlock(block);
+    capacity_ += block_size;
   }
   return blocks_[blk_idx]->pointer(obj_idx);
 }
@@ -190,9 +413,52 @@ ArrayTable<TYPE>::clear()
 {
   deleteBlocks();
   blocks_size_ = 0;
-  size_ = 0;
-  free_block_idx_ = block_idx_null;
+  capacity_ = 0;
+  for (ArrayTableThread<TYPE> &thread : threads_)
+    thread.clear();
+  for (BlockArena *arena : arenas_)
+    arena->clear();
+}
+
+template <class TYPE>
+void
+ArrayTable<TYPE>::swap(ArrayTable<TYPE> &table)
+{
+  std::swap(threads_, table.threads_);
+  std::swap(arenas_, table.arenas_);
+  std::swap(thread_count_, table.thread_count_);
+  std::swap(capacity_, table.capacity_);
+  std::swap(blocks_size_, table.blocks_size_);
+  std::swap(blocks_capacity_, table.blocks_capacity_);
+  std::swap(blocks_, table.blocks_);
+  std::swap(prev_blocks_, table.prev_blocks_);
+}
+
+////////////////////////////////////////////////////////////////
+
+template <class TYPE>
+ArrayTableThread<TYPE>::ArrayTableThread() :
+  arena_(nullptr),
+  block_(nullptr),
+  block_idx_(block_idx_null),
+  free_idx_(object_idx_null),
+  block_size_(0),
+  size_(0),
+  free_size_(0)
+{
+}
+
+template <class TYPE>
+void
+ArrayTableThread<TYPE>::clear()
+{
+  block_ = nullptr;
+  block_idx_ = block_idx_null;
   free_idx_ = object_idx_null;
+  block_size_ = 0;
+  free_arrays_.clear();
+  size_ = 0;
+  free_size_ = 0;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -201,7 +467,8 @@ template <class TYPE>
 class ArrayBlock
 {
 public:
-  ArrayBlock(uint32_t size);
+  ArrayBlock(uint32_t size,
+	     BlockArena &arena);
   ~ArrayBlock();
   uint32_t size() const { return size_; }
   TYPE &ref(ObjectIdx idx) { return objects_[idx]; }
@@ -213,16 +480,21 @@ private:
 };
 
 template <class TYPE>
-ArrayBlock<TYPE>::ArrayBlock(uint32_t size) :
+ArrayBlock<TYPE>::ArrayBlock(uint32_t size,
+			     BlockArena &arena) :
   size_(size),
-  objects_(new TYPE[size])
+  objects_(static_cast<TYPE*>(arena.alloc(size * sizeof(TYPE))))
 {
+  for (uint32_t i = 0; i < size; i++)
+    new (&objects_[i]) TYPE;
 }
 
+// The arena owns the memory.
 template <class TYPE>
 ArrayBlock<TYPE>::~ArrayBlock()
 {
-  delete [] objects_;
+  for (uint32_t i = 0; i < size_; i++)
+    objects_[i].~TYPE();
 }
 
 } // Namespace
@@ -52,6 +52,8 @@ public:
   // Reset to virgin state.
   void clear();
   bool empty() const;
+  // Number of vertices in the queue.
+  int queueCount() const;
   // Enqueue a vertex to search from.
   void enqueue(Vertex *vertex);
   // Enqueue vertices adjacent to a vertex.
@@ -83,6 +85,14 @@ public:
   // Returns the number of vertices that are visited.
   int visitParallel(Level to_level,
 		    VertexVisitor *visitor);
+  // Apply each visitor in visitors to every vertex in the queue in
+  // level order, dispatching each (vertex, visitor) pair as a separate
+  // task. Vertices the first visitor does not split (see
+  // VertexVisitor::splitVisit) are one task for the first visitor.
+  // The visitors must not write shared vertex state.
+  // Returns the number of vertices that are visited.
+  int visitParallel(Level to_level,
+		    VertexVisitorSeq &visitors);
 
 protected:
   BfsIterator(BfsIndex bfs_index,
@@ -0,0 +1,66 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2020, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <cstddef>
+
+#include "DisallowCopyAssign.hh"
+#include "Vector.hh"
+
+namespace sta {
+
+// Table blocks are carved out of large chunks of memory so the blocks
+// of a table are contiguous and the chunks can use huge pages.
+// Chunks start small so small tables stay small and double in size up
+// to chunkSizeMax(). Memory is only released by clear.
+// Not thread safe.
+class BlockArena
+{
+public:
+  BlockArena();
+  ~BlockArena();
+  void *alloc(size_t size);
+  void clear();
+  // Bytes allocated for chunks.
+  size_t size() const { return size_; }
+
+  // Largest chunk size. Zero allocates each block separately.
+  static size_t chunkSizeMax() { return chunk_size_max_; }
+  static void setChunkSizeMax(size_t size);
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(BlockArena);
+  char *makeChunk(size_t size);
+
+  struct Chunk
+  {
+    char *memory;
+    size_t size;
+  };
+  Vector<Chunk> chunks_;
+  char *next_;
+  size_t remaining_;
+  size_t chunk_size_;
+  size_t size_;
+
+  static size_t chunk_size_max_;
+  static const size_t chunk_size_min_ = 64 * 1024;
+  static const size_t alignment_ = 64;
+};
+
+} // namespace
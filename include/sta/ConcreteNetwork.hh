@@ -272,7 +272,10 @@ public:
   ConcretePin *findPin(const char *port_name) const;
   ConcretePin *findPin(const Port *port) const;
   ConcreteNet *findNet(const char *net_name) const;
+  // Names are matched by the threads of dispatch_queue.
   void findNetsMatching(const PatternMatch *pattern,
+			DispatchQueue *dispatch_queue,
+			int thread_count,
 			NetSeq *nets) const;
   InstanceNetIterator *netIterator() const;
   Instance *findChild(const char *name) const;
@@ -108,7 +108,9 @@ public:
   ParasiticAnalysisPt *findParasiticAnalysisPt(const MinMax *min_max) const;
   int parasiticAnalysisPtcount();
   DcalcAnalysisPt *findDcalcAnalysisPt(const MinMax *min_max) const;
+  const DcalcAnalysisPtSeq &dcalcAnalysisPts() const { return dcalc_analysis_pts_; }
   PathAnalysisPt *findPathAnalysisPt(const MinMax *min_max) const;
+  const PathAnalysisPtSeq &pathAnalysisPts() const { return path_analysis_pts_; }
   void addLiberty(LibertyLibrary *lib,
 		  const MinMax *min_max);
   LibertySeq *libertyLibraries(const MinMax *min_max);
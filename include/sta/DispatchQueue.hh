@@ -29,6 +29,9 @@ public:
   // Dispatch and move.
   void dispatch(fp_t&& op);
   void finishTasks();
+  // Index of the dispatch thread running the caller (the thread
+  // argument to the task), or -1 if the caller is not a dispatch thread.
+  static int threadIndex();
 
   // Deleted operations
   DispatchQueue(const DispatchQueue& rhs) = delete;
@@ -23,31 +23,49 @@
 
 namespace sta {
 
-typedef Map<LibertyCell*, LibertyCellSeq*> EquivCellMap;
+typedef UnorderedMap<const LibertyCell*, LibertyCellSeq*> EquivCellMap;
 typedef UnorderedMap<unsigned, LibertyCellSeq*> LibertyCellHashMap;
+// Equiv cells sorted by drive resistance for each liberty analysis point.
+typedef Vector<LibertyCellSeq*> CornerEquivCells;
+typedef UnorderedMap<const LibertyCellSeq*, CornerEquivCells*> CornerEquivCellMap;
 
 class EquivCells
 {
 public:
   // Find equivalent cells in equiv_libs.
   // Optionally add mappings for cells in map_libs.
+  // When lib_ap_count is non-zero the equiv cells are also sorted
+  // by the drive resistance of their corner cells for each liberty
+  // analysis point index (Corner::libertyIndex) below lib_ap_count.
   EquivCells(LibertyLibrarySeq *equiv_libs,
-	     LibertyLibrarySeq *map_libs);
+	     LibertyLibrarySeq *map_libs,
+	     int lib_ap_count = 0);
   ~EquivCells();
   // Find equivalents for cell (member of from_libs) in to_libs.
-  LibertyCellSeq *equivs(LibertyCell *cell);
+  LibertyCellSeq *equivs(const LibertyCell *cell) const;
+  // Equivalents sorted by drive resistance at liberty analysis point.
+  LibertyCellSeq *equivs(const LibertyCell *cell,
+			 int lib_ap_index) const;
   
 protected:
   void findEquivCells(const LibertyLibrary *library,
 		      LibertyCellHashMap &hash_matches);
   void mapEquivCells(const LibertyLibrary *library,
 		     LibertyCellHashMap &hash_matches);
+  void sortCornerEquivCells(int lib_ap_count);
 
   EquivCellMap equiv_cells_;
   // Unique cell for each equiv cell group.
   LibertyCellSeq unique_equiv_cells_;
+  CornerEquivCellMap corner_equiv_cells_;
 };
 
+// Hash of cell ports, functions and sequentials that is equal for
+// cells that are equivCells. Functions of up to six single bit ports
+// are hashed by truth table. LibertyCell::equivSignature caches it.
+unsigned
+equivCellSignature(const LibertyCell *cell);
+
 // Predicate that is true when the ports, functions, sequentials and
 // timing arcs match.
 bool
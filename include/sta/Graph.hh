@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <mutex>
 
 #include "DisallowCopyAssign.hh"
@@ -52,6 +53,11 @@ typedef Vector<DelayTable*> DelayTableSeq;
 typedef ObjectId EdgeId;
 typedef ObjectId ArrivalId;
 typedef ObjectId PrevPathId;
+// Size of the arrival and prev path arrays of a vertex.
+typedef std::function<void (const Vertex *vertex,
+			    // Return values.
+			    uint32_t &arrival_count,
+			    uint32_t &prev_path_count)> PathArrayCountFunc;
 
 static constexpr EdgeId edge_id_null = object_id_null;
 static constexpr ObjectIdx edge_idx_null = object_id_null;
@@ -74,6 +80,7 @@ public:
 	DcalcAPIndex ap_count);
   void makeGraph();
   virtual ~Graph();
+  virtual void copyState(const StaState *sta);
 
   // Number of arc delays and slews from sdf or delay calculation.
   virtual void setDelayCount(DcalcAPIndex ap_count);
@@ -82,6 +89,10 @@ public:
   // Bidirect pins have two vertices.
   virtual Vertex *vertex(VertexId vertex_id) const;
   VertexId id(const Vertex *vertex) const;
+  // True if vertex_id references an existing (not deleted) vertex.
+  bool isValidVertexId(VertexId vertex_id) const;
+  // One more than the largest vertex id, for tables indexed by VertexId.
+  VertexId vertexIdEnd() const;
   void makePinVertices(Pin *pin);
   void makePinVertices(Pin *pin,
 		       Vertex *&vertex,
@@ -101,11 +112,25 @@ public:
   Arrival *makeArrivals(Vertex *vertex,
 			uint32_t count);
   Arrival *arrivals(Vertex *vertex);
+  // Reuse an array made by makeArrivals.
+  // The caller is responsible for updating vertices that reference it.
+  void deleteArrivals(ArrivalId id,
+		      uint32_t count);
   void clearArrivals();
   PathVertexRep *makePrevPaths(Vertex *vertex,
 			       uint32_t count);
   PathVertexRep *prevPaths(Vertex *vertex) const;
+  void deletePrevPaths(PrevPathId id,
+		       uint32_t count);
   void clearPrevPaths();
+  // Copy vertex arrival and prev path arrays to new tables to release
+  // the blocks held by deleted arrays.
+  void compactPaths(const PathArrayCountFunc &array_counts);
+  // Exchange the arrival/prev path tables and vertex path state with
+  // paths so the paths of another search can be kept while it is not
+  // in use. Vertices made after paths were saved have no paths.
+  void swapPaths(GraphPaths &paths);
+  void reportPathMemory() const;
   // Slews are reported slews in seconds.
   // Reported slew are the same as those in the liberty tables.
   //  reported_slews = measured_slews / slew_derate_from_library
@@ -121,6 +146,8 @@ public:
   // Edge functions.
   virtual Edge *edge(EdgeId edge_index) const;
   EdgeId id(const Edge *edge) const;
+  // True if edge_id references an existing (not deleted) edge.
+  bool isValidEdgeId(EdgeId edge_id) const;
   virtual Edge *makeEdge(Vertex *from,
 			 Vertex *to,
 			 TimingArcSet *arc_set);
@@ -234,10 +261,10 @@ protected:
   //  in pin_bidirect_drvr_vertex_map
   PinVertexMap pin_bidirect_drvr_vertex_map_;
   int arc_count_;
+  // Arrays are made and deleted with the dispatch thread index
+  // so search threads do not contend for a lock.
   ArrivalsTable arrivals_;
-  std::mutex arrivals_lock_;
   PrevPathsTable prev_paths_;
-  std::mutex prev_paths_lock_;
   Vector<bool> arc_delay_annotated_;
   int slew_rf_count_;
   bool have_arc_delays_;
@@ -384,6 +411,38 @@ private:
   friend class VertexOutEdgeIterator;
 };
 
+// Vertex path state saved by Graph::swapPaths.
+class VertexPaths
+{
+public:
+  ArrivalId arrivals_;
+  PrevPathId prev_paths_;
+  TagGroupIndex tag_group_index_;
+  bool has_requireds_;
+  bool crpr_path_pruning_disabled_;
+  bool requireds_pruned_;
+};
+
+// Paths of a search that are not on the graph vertices.
+class GraphPaths
+{
+public:
+  GraphPaths() {}
+  bool empty() const { return vertex_paths_.empty(); }
+  void clear();
+
+protected:
+  ArrivalsTable arrivals_;
+  PrevPathsTable prev_paths_;
+  // Indexed by vertex id.
+  std::vector<VertexPaths> vertex_paths_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(GraphPaths);
+
+  friend class Graph;
+};
+
 // There is one Edge between each pair of pins that has a timing
 // path between them.
 class Edge
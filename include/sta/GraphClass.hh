@@ -32,6 +32,7 @@ class VertexIterator;
 class VertexInEdgeIterator;
 class VertexOutEdgeIterator;
 class GraphLoop;
+class GraphPaths;
 
 typedef ObjectId VertexId;
 typedef ObjectId EdgeId;
@@ -18,6 +18,8 @@
 
 #include <string>
 #include "DisallowCopyAssign.hh"
+#include "Vector.hh"
+#include "Delay.hh"
 #include "GraphClass.hh"
 #include "DcalcAnalysisPt.hh"
 #include "StaState.hh"
@@ -31,6 +33,9 @@ class SearchPred;
 class DelayCalcObserver;
 class Parasitic;
 class Corner;
+class SwapCellDelay;
+
+typedef Vector<SwapCellDelay> SwapCellDelaySeq;
 
 // Base class for graph delay calculator.
 // This class annotates the arc delays and slews on the graph by calling
@@ -68,6 +73,9 @@ public:
   // delays to be recomputed during incremental delay calculation.
   virtual float incrementalDelayTolerance();
   virtual void setIncrementalDelayTolerance(float /* tol */) {}
+  // Find the delays for each corner of a vertex in separate threads.
+  virtual bool cornerParallel() const { return false; }
+  virtual void setCornerParallel(bool /* parallel */) {}
   // Set the observer for edge delay changes.
   virtual void setObserver(DelayCalcObserver *observer);
   // pin_cap  = net pin capacitances + port external pin capacitance,
@@ -102,6 +110,18 @@ public:
   virtual float ceff(Edge *edge,
 		     TimingArc *arc,
 		     const DcalcAnalysisPt *dcalc_ap);
+  // Find the delays and slews that change if the cell of inst is
+  // swapped to swap_cell without changing the network or graph.
+  // swap_cell must have the same ports and timing arcs as the
+  // instance cell (equivCells).
+  // Delays must be up to date.  Safe to call from multiple threads
+  // while the network, constraints and timing are not changing.
+  virtual void swapCellDelays(const Instance * /* inst */,
+			      LibertyCell * /* swap_cell */,
+			      // nullptr for all corners.
+			      const Corner * /* corner */,
+			      // Return value.
+			      SwapCellDelaySeq & /* delays */) {}
   // Precedence:
   //  SDF annotation
   //  Liberty library
@@ -125,6 +145,22 @@ private:
   DISALLOW_COPY_AND_ASSIGN(GraphDelayCalc);
 };
 
+// Delay/slew of an edge with a swapped cell.
+class SwapCellDelay
+{
+public:
+  // Gate edge to a driver pin or wire edge from a driver pin.
+  Edge *edge_;
+  // Driver timing arc (of the current cell).
+  TimingArc *arc_;
+  DcalcAPIndex ap_index_;
+  ArcDelay delay_;
+  ArcDelay prev_delay_;
+  // Slew at the edge to vertex.
+  Slew slew_;
+  Slew prev_slew_;
+};
+
 // Abstract base class for edge delay change observer.
 class DelayCalcObserver
 {
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "DisallowCopyAssign.hh"
 #include "MinMax.hh"
 #include "RiseFallMinMax.hh"
@@ -37,6 +40,7 @@ class ModeValueDef;
 class TestCell;
 class PatternMatch;
 class LatchEnable;
+class PvtScaleFactors;
 class Report;
 class Debug;
 class LibertyBuilder;
@@ -132,7 +136,7 @@ public:
 			TableTemplateType type);
   TableTemplate *findTableTemplate(const char *name,
 				   TableTemplateType type);
-  float nominalProcess() { return nominal_process_; }
+  float nominalProcess() const { return nominal_process_; }
   void setNominalProcess(float process);
   float nominalVoltage() const { return nominal_voltage_; }
   void setNominalVoltage(float voltage);
@@ -460,6 +464,9 @@ public:
   RiseFall *latchCheckEnableTrans(TimingArcSet *check_set);
   bool isDisabledConstraint() const { return is_disabled_constraint_; }
   LibertyCell *cornerCell(int ap_index);
+  // Signature of ports, functions and sequentials that is the same
+  // for equivalent cells (see equivCellSignature).
+  unsigned equivSignature() const { return equiv_signature_; }
 
   // AOCV
   float ocvArcDepth() const;
@@ -573,6 +580,7 @@ protected:
   OcvDerateMap ocv_derate_map_;
   bool is_disabled_constraint_;
   Vector<LibertyCell*> corner_cells_;
+  unsigned equiv_signature_;
   float leakage_power_;
   bool leakage_power_exists_;
   LibertyPgPortMap pg_port_map_;
@@ -848,18 +856,31 @@ public:
   Pvt(float process,
       float voltage,
       float temperature);
-  virtual ~Pvt() {}
+  virtual ~Pvt();
   float process() const { return process_; }
   void setProcess(float process);
   float voltage() const { return voltage_; }
   void setVoltage(float voltage);
   float temperature() const { return temperature_; }
   void setTemperature(float temp);
+  // Scale factor at this pvt wrt library nominal pvt.
+  // All of the scale factors for scale_factors are evaluated on first
+  // use and cached so table lookups do not re-evaluate them.
+  // Thread safe.
+  float scaleFactor(ScaleFactorType type,
+		    int tr_index,
+		    ScaleFactors *scale_factors,
+		    const LibertyLibrary *library) const;
 
 protected:
+  void deleteScaleFactors();
+
   float process_;
   float voltage_;
   float temperature_;
+  // Singly linked list of evaluated scale factors.
+  mutable std::atomic<PvtScaleFactors*> scale_factors_;
+  mutable std::mutex scale_factors_lock_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Pvt);
@@ -893,6 +914,8 @@ public:
   explicit ScaleFactors(const char *name);
   ~ScaleFactors();
   const char *name() const { return name_; }
+  // Unique id used to validate cached pvt scale factors.
+  uint64_t id() const { return id_; }
   float scale(ScaleFactorType type,
 	      ScaleFactorPvt pvt,
 	      RiseFall *rf);
@@ -912,6 +935,7 @@ public:
 
 protected:
   const char *name_;
+  uint64_t id_;
   float scales_[scale_factor_type_count][int(ScaleFactorPvt::count)][RiseFall::index_count];
 
 private:
@@ -88,5 +88,16 @@ systemRunTime();
 size_t
 memoryUsage();
 
+// Allocate memory for large tables.
+// Where supported, allocations of at least huge_page_size are aligned
+// to and advised to use (transparent) huge pages.
+void *
+largeMemoryAlloc(size_t size);
+void
+largeMemoryFree(void *memory,
+		size_t size);
+
+static const size_t huge_page_size = 2 * 1024 * 1024;
+
 } // namespace sta
 
@@ -17,9 +17,83 @@
 #pragma once
 
 #include <mutex>
+#include <condition_variable>
 
 namespace sta {
 
 typedef std::unique_lock<std::mutex> UniqueLock;
 
+// Reader/writer lock (std::shared_mutex requires c++17).
+// Any number of readers or one writer hold the lock at a time.
+// Waiting writers block new readers so updates are not starved.
+class ReadWriteLock
+{
+public:
+  ReadWriteLock() :
+    readers_(0),
+    writers_waiting_(0),
+    writer_(false)
+  {}
+  void lockRead()
+  {
+    UniqueLock lock(lock_);
+    cv_.wait(lock, [this] { return !writer_ && writers_waiting_ == 0; });
+    readers_++;
+  }
+  void unlockRead()
+  {
+    UniqueLock lock(lock_);
+    readers_--;
+    if (readers_ == 0)
+      cv_.notify_all();
+  }
+  void lockWrite()
+  {
+    UniqueLock lock(lock_);
+    writers_waiting_++;
+    cv_.wait(lock, [this] { return !writer_ && readers_ == 0; });
+    writers_waiting_--;
+    writer_ = true;
+  }
+  void unlockWrite()
+  {
+    UniqueLock lock(lock_);
+    writer_ = false;
+    cv_.notify_all();
+  }
+
+private:
+  std::mutex lock_;
+  std::condition_variable cv_;
+  int readers_;
+  int writers_waiting_;
+  bool writer_;
+};
+
+// Scoped read lock.
+class ReadLock
+{
+public:
+  explicit ReadLock(ReadWriteLock &lock) :
+    lock_(lock)
+  { lock_.lockRead(); }
+  ~ReadLock() { lock_.unlockRead(); }
+
+private:
+  ReadWriteLock &lock_;
+};
+
+// Scoped write lock.
+class WriteLock
+{
+public:
+  explicit WriteLock(ReadWriteLock &lock) :
+    lock_(lock)
+  { lock_.lockWrite(); }
+  ~WriteLock() { lock_.unlockWrite(); }
+
+private:
+  ReadWriteLock &lock_;
+};
+
 } // namespace
@@ -182,6 +182,7 @@ public:
 		   const ParasiticAnalysisPt *ap);
 
   virtual void disconnectPinBefore(const Pin *pin);
+  virtual void deletePinBefore(const Pin *pin);
   virtual void loadPinCapacitanceChanged(const Pin *pin);
 
 private:
@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include <new>
+
 #include "Vector.hh"
 #include "Error.hh"
 #include "ObjectId.hh"
+#include "BlockArena.hh"
 
 namespace sta {
 
@@ -38,6 +41,11 @@ public:
   void destroy(TYPE *object);
   TYPE *pointer(ObjectId id) const;
   TYPE &ref(ObjectId id) const;
+  // True if id references an object that has been made and not
+  // destroyed. Ids of free objects are not valid.
+  bool isValid(ObjectId id) const;
+  // One more than the largest allocated object id.
+  ObjectId idEnd() const { return blocks_.size() << idx_bits; }
   ObjectId objectId(const TYPE *object);
   size_t size() const { return size_; }
   void clear();
@@ -49,6 +57,7 @@ public:
 
 private:
   void makeBlock();
+  void deleteBlocks();
   void freePush(TYPE *object,
 		ObjectId id);
 
@@ -56,6 +65,11 @@ private:
   // Object ID of next free object.
   ObjectId free_;
   Vector<TableBlock<TYPE>*> blocks_;
+  // Indexed by ObjectId; true for objects that are made and not destroyed.
+  // Free objects hold the free list link, so they cannot be marked.
+  std::vector<bool> valid_;
+  // Memory for blocks_.
+  BlockArena arena_;
   static constexpr ObjectId idx_mask_ = block_object_count - 1;
 };
 
@@ -69,7 +83,17 @@ ObjectTable<TYPE>::ObjectTable() :
 template <class TYPE>
 ObjectTable<TYPE>::~ObjectTable()
 {
-  blocks_.deleteContents();
+  deleteBlocks();
+}
+
+template <class TYPE>
+void
+ObjectTable<TYPE>::deleteBlocks()
+{
+  for (TableBlock<TYPE> *block : blocks_)
+    block->~TableBlock<TYPE>();
+  blocks_.clear();
+  arena_.clear();
 }
 
 template <class TYPE>
@@ -81,6 +105,7 @@ ObjectTable<TYPE>::make()
   TYPE *object = pointer(free_);
   ObjectIdx idx = free_ & idx_mask_;
   object->setObjectIdx(idx);
+  valid_[free_] = true;
   ObjectId *free_next = reinterpret_cast<ObjectId*>(object);
   free_ = *free_next;
   size_++;
@@ -103,8 +128,10 @@ void
 ObjectTable<TYPE>::makeBlock()
 {
   BlockIdx block_index = blocks_.size();
-  TableBlock<TYPE> *block = new TableBlock<TYPE>(block_index, this);
+  void *memory = arena_.alloc(sizeof(TableBlock<TYPE>));
+  TableBlock<TYPE> *block = new (memory) TableBlock<TYPE>(block_index, this);
   blocks_.push_back(block);
+  valid_.resize(idEnd(), false);
   if (blocks_.size() >= block_id_max)
     criticalError(224, "max object table block count exceeded.");
   // ObjectId zero is reserved for object_id_null.
@@ -129,6 +156,14 @@ ObjectTable<TYPE>::pointer(ObjectId id) const
   }
 }
 
+template <class TYPE>
+bool
+ObjectTable<TYPE>::isValid(ObjectId id) const
+{
+  return id < valid_.size()
+    && valid_[id];
+}
+
 template <class TYPE>
 TYPE &
 ObjectTable<TYPE>::ref(ObjectId id) const
@@ -158,6 +193,7 @@ ObjectTable<TYPE>::destroy(TYPE *object)
 {
   ObjectId object_id = objectId(object);
   object->~TYPE();
+  valid_[object_id] = false;
   size_--;
   freePush(object, object_id);
 }
@@ -166,8 +202,10 @@ template <class TYPE>
 void
 ObjectTable<TYPE>::clear()
 {
-  blocks_.deleteContentsClear();
+  deleteBlocks();
+  valid_.clear();
   size_ = 0;
+  free_ = object_id_null;
 }
 
 ////////////////////////////////////////////////////////////////
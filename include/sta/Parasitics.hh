@@ -260,6 +260,8 @@ public:
 				      const ParasiticAnalysisPt *ap) = 0;
 
   // Estimate parasitic as pi elmore using wireload model.
+  // The estimate is owned by the parasitics and reused until the
+  // wireload, fanout or net pin capacitance of the driver changes.
   virtual Parasitic *estimatePiElmore(const Pin *drvr_pin,
 				      const RiseFall *rf,
 				      const Wireload *wireload,
@@ -276,6 +278,7 @@ public:
 				 const ParasiticAnalysisPt *ap);
   // Network edit before/after methods.
   virtual void disconnectPinBefore(const Pin *pin) = 0;
+  virtual void deletePinBefore(const Pin *pin) = 0;
   virtual void loadPinCapacitanceChanged(const Pin *pin) = 0;
 
 protected:
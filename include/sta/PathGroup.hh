@@ -144,7 +144,7 @@ protected:
 			 const Corner *corner,
 			 const MinMaxAll *min_max,
 			 PathEndVisitor *visitor);
-  void makeGroupPathEnds(VertexSet *endpoints,
+  void makeGroupPathEnds(VertexSeq &endpoints,
 			 const Corner *corner,
 			 const MinMaxAll *min_max,
 			 PathEndVisitor *visitor);
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <functional>
 #include "DisallowCopyAssign.hh"
 #include "Error.hh"
 
@@ -29,12 +31,17 @@ namespace sta {
 using ::Tcl_RegExp;
 using ::Tcl_Interp;
 
+class DispatchQueue;
+
 class PatternMatch
 {
 public:
   // If regexp is false, use unix glob style matching.
   // If regexp is true, use TCL regular expression matching.
   //   Regular expressions are always anchored.
+  //   Simple regular expressions with literals, '.', '.*' and '.+'
+  //   are matched natively; others use the TCL regexp engine.
+  // Glob and simple regexp matching is thread safe.
   // If nocase is true, ignore case in the pattern.
   // Tcl_Interp is optional for reporting regexp compile errors.
   PatternMatch(const char *pattern,
@@ -52,16 +59,23 @@ public:
   bool nocase() const { return nocase_; }
   Tcl_Interp *tclInterp() const { return interp_; }
   bool hasWildcards() const;
+  // TCL regexps cannot be matched by multiple threads.
+  bool isThreadSafe() const { return regexp_ == nullptr; }
 
 private:
   DISALLOW_COPY_AND_ASSIGN(PatternMatch);
   void compileRegexp();
+  bool compileSimpleRegexp();
+  bool matchSimpleRegexp(const char *str) const;
 
   const char *pattern_;
   bool is_regexp_;
   bool nocase_;
   Tcl_Interp *interp_;
   Tcl_RegExp regexp_;
+  // Compiled simple regexp (literal characters, pattern_any, pattern_star).
+  std::vector<int> simple_regexp_;
+  bool is_simple_regexp_;
 };
 
 // Error thrown by Pattern constructor.
@@ -90,4 +104,17 @@ patternMatchNoCase(const char *pattern,
 bool
 patternWildcards(const char *pattern);
 
+// Match an array of count names. name(index) returns the name at index.
+// Long arrays are split across the threads of dispatch_queue if the
+// pattern is thread safe, so name must be thread safe.
+// matches[index] is set if the name at index matches.
+void
+patternMatchNames(const PatternMatch *pattern,
+		  size_t count,
+		  const std::function<const char *(size_t index)> &name,
+		  DispatchQueue *dispatch_queue,
+		  int thread_count,
+		  // Return value.
+		  std::vector<char> &matches);
+
 } // namespace
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <string>
+#include <vector>
 #include <mutex>
 #include "DisallowCopyAssign.hh"
 
@@ -106,7 +107,10 @@ public:
   // Redirect append output to filename until redirectFileEnd is called.
   virtual void redirectFileAppendBegin(const char *filename);
   virtual void redirectFileEnd();
+  // Write buffered log and redirect file output.
+  void flushFiles();
   // Redirect output to a string until redirectStringEnd is called.
+  // String redirects can be nested.
   virtual void redirectStringBegin();
   virtual const char *redirectStringEnd();
   virtual void setTclInterp(Tcl_Interp *) {}
@@ -139,11 +143,23 @@ protected:
   void printBufferLine();
   void redirectStringPrint(const char *buffer,
                            size_t length);
+  FILE *openFile(const char *filename,
+                 const char *mode,
+                 // Return value.
+                 char *&file_buffer);
+  void closeFile(FILE *&stream,
+                 char *&file_buffer);
 
   FILE *log_stream_;
+  char *log_buffer_;
   FILE *redirect_stream_;
+  char *redirect_buffer_;
   bool redirect_to_string_;
   string redirect_string_;
+  // Strings of enclosing string redirects.
+  std::vector<string> redirect_strings_;
+  // Result of the last nested redirectStringEnd.
+  string nested_string_;
   // Buffer to support printf style arguments.
   size_t buffer_size_;
   char *buffer_;
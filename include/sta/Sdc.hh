@@ -17,6 +17,7 @@
 #pragma once
 
 #include <mutex>
+#include <functional>
 
 #include "DisallowCopyAssign.hh"
 #include "StringUtil.hh"
@@ -175,6 +176,8 @@ class Sdc : public StaState
 public:
   explicit Sdc(StaState *sta);
   ~Sdc();
+  // Each mode has its own Sdc, so sdc_ is always this.
+  virtual void copyState(const StaState *sta);
   // Note that Search may reference a Filter exception removed by clear().
   void clear();
   // Return true if pin is referenced by any constraint.
@@ -590,6 +593,13 @@ public:
 		       const OperatingConditions *op_cond,
 		       const Corner *corner,
 		       const MinMax *min_max);
+  // Liberty port capacitance of an instance derated by operating
+  // conditions and instance pvt.
+  float portCapacitance(Instance *inst, LibertyPort *port,
+			const RiseFall *rf,
+			const OperatingConditions *op_cond,
+			const Corner *corner,
+			const MinMax *min_max) const;
   void setResistance(Net *net,
 		     const MinMaxAll *min_max,
 		     float res);
@@ -891,6 +901,8 @@ public:
 
   PortExtCap *portExtCap(Port *port) const;
   bool hasPortExtCap(Port *port) const;
+  // Remove the pin, wire and fanout loads of port.
+  void removePortExtCap(Port *port);
   void portExtCap(Port *port,
 		  const RiseFall *rf,
 		  const MinMax *min_max,
@@ -992,6 +1004,22 @@ public:
   void unrecordException(ExceptionPath *exception);
   void annotateGraph();
   void removeGraphAnnotations();
+  // Annotate constraints added after annotateGraph without
+  // re-annotating the entire graph.
+  void annotateGraphDisable(const Pin *pin);
+  void annotateGraphDisable(Instance *inst);
+  void annotateGraphDisable(LibertyPort *port);
+  void annotateGraphOutputDelay(Pin *pin);
+  void annotateGraphDataCheck(const Pin *to);
+  // Set (or clear) the disabled flags of the liberty cells, ports and
+  // timing arc sets disabled by set_disable_timing. These are shared
+  // by all modes, so they follow the current mode.
+  void annotateLibertyDisables(bool disabled);
+  bool hasLibertyDisables() const;
+  // Pins with delays that depend on these constraints but not on
+  // the graph annotations: top level ports (input drives, port loads),
+  // nets with set_load or set_resistance and instances with set_pvt.
+  void delayConstraintPins(PinSet &pins) const;
 
   // Network edit before/after methods.
   void disconnectPinBefore(Pin *pin);
@@ -1177,6 +1205,7 @@ protected:
   void deleteMasterClkRefs(Clock *clk);
   // Liberty library to look for defaults.
   LibertyLibrary *defaultLibertyLibrary();
+  void visitGraphVertices(const std::function<void (Vertex *vertex)> &visit);
   void annotateGraphConstrainOutputs();
   void annotateDisables();
   void annotateGraphDisabled(const Pin *pin);
@@ -1223,11 +1252,6 @@ protected:
 			const OperatingConditions *op_cond,
 			const Corner *corner,
 			const MinMax *min_max);
-  float portCapacitance(Instance *inst, LibertyPort *port,
-			const RiseFall *rf,
-			const OperatingConditions *op_cond,
-			const Corner *corner,
-			const MinMax *min_max) const;
   void removeClockGroups(ClockGroups *groups);
   void ensureClkGroupExclusions();
   void makeClkGroupExclusions(ClockGroups *clk_groups);
@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 #include "MinMax.hh"
 #include "HashSet.hh"
+#include "UnorderedMap.hh"
 #include "Transition.hh"
 #include "LibertyClass.hh"
 #include "NetworkClass.hh"
@@ -28,6 +31,7 @@
 #include "SdcClass.hh"
 #include "StaState.hh"
 #include "SearchClass.hh"
+#include "Corner.hh"
 #include "SearchPred.hh"
 #include "VertexVisitor.hh"
 
@@ -52,6 +56,7 @@ class VisitPathEnds;
 class GatedClk;
 class CheckCrpr;
 class Genclks;
+class SearchObserver;
 class Corner;
 
 typedef Set<ClkInfo*, ClkInfoLess> ClkInfoSet;
@@ -78,6 +83,29 @@ public:
   // disables additional search to returns approximate required times.
   bool crprApproxMissingRequireds() const;
   void setCrprApproxMissingRequireds(bool enabled);
+  // Incremental arrival propagation does not enqueue the fanout of a
+  // vertex when none of its arrivals change by more than tolerance.
+  // Vertex arrivals are only updated when they change, so each vertex
+  // arrival is within tolerance of the arrival found from its fanin
+  // arrivals. The error accumulates along paths, so an arrival may
+  // differ from a full update by up to tolerance times the number of
+  // levels between it and the changed vertices. Use updateTiming(true)
+  // to remove the accumulated error.
+  float arrivalTolerance() const { return arrival_tolerance_; }
+  void setArrivalTolerance(float tolerance);
+  // Copy the options above from search.
+  void copyOptions(const Search *search);
+  void setObserver(SearchObserver *observer);
+  // Statistics summed over the findArrivals calls since the last
+  // resetArrivalUpdateStats. Sta::updateTiming resets them.
+  // Vertices queued before propagation starts.
+  int arrivalSeedCount() const { return arrival_seed_count_; }
+  // Vertices visited, including seeds.
+  int arrivalVisitCount() const { return arrival_visit_count_; }
+  // Vertices with arrivals that changed.
+  int arrivalChangeCount() const { return arrival_change_count_; }
+  void incrArrivalChangeCount() { arrival_change_count_++; }
+  void resetArrivalUpdateStats();
 
   bool unconstrainedPaths() const { return unconstrained_paths_; }
   // from/thrus/to are owned and deleted by Search.
@@ -104,8 +132,22 @@ public:
 			   bool clk_gating_setup,
 			   bool clk_gating_hold);
   bool arrivalsValid();
+  // Set by Sta::freezeTiming. Invalidating arrivals, requireds or
+  // endpoints (network edits, constraint changes) thaws timing.
+  bool timingFrozen() const { return timing_frozen_; }
+  void setTimingFrozen(bool frozen);
+  // Only seed arrivals for the path analysis points of corner so the
+  // arrivals, tags and path storage are for that corner only.
+  // corner=nullptr searches all corners. Invalidates arrivals.
+  const Corner *searchCorner() const { return search_corner_; }
+  void setSearchCorner(const Corner *corner);
+  // Path analysis points of the search corner.
+  const PathAnalysisPtSeq &searchPathAnalysisPts() const;
   // Invalidate all arrival and required times.
   void arrivalsInvalid();
+  // The paths of this search were deleted without visiting the
+  // vertices (see Graph::swapPaths).
+  void arrivalsDeleted();
   // Invalidate vertex arrival time.
   void arrivalInvalid(Vertex *vertex);
   void arrivalInvalidDelete(Vertex *vertex);
@@ -146,6 +188,11 @@ public:
 		  // Return values.
 		  Slack &worst_slack,
 		  Vertex *&worst_vertex);
+  // Endpoint slacks indexed by path analysis point index.
+  // Requires arrivals and required times.
+  void wnsSlacks(Vertex *vertex,
+		 // Return values.
+		 SlackSeq &slacks);
   // Clock arrival respecting ideal clock insertion delay and latency.
   Arrival clkPathArrival(const Path *clk_path) const;
   Arrival clkPathArrival(const Path *clk_path,
@@ -169,10 +216,21 @@ public:
   FilterPath *filter() const { return filter_; }
   void deleteFilter();
   void deleteFilteredArrivals();
+  // True if the filtered arrivals from the last findPathEnds can be
+  // used for a findPathEnds with the same from/thrus/to.
+  bool filteredArrivalsReusable(ExceptionFrom *from,
+				ExceptionThruSeq *thrus,
+				ExceptionTo *to);
+  // Filtered arrival search is restricted to the vertices in the
+  // fanin cone of -to (or fanin/fanout cone of the last -thru).
+  bool inFilterCone(const Vertex *vertex) const;
 
   // Endpoints are discovered during arrival search, so are only
   // defined after findArrivals.
   VertexSet *endpoints();
+  // The endpoints in an array for chunked (parallel) visiting.
+  // Updated incrementally with endpoints(); the order is arbitrary.
+  VertexSeq &endpointSeq();
   void endpointsInvalid();
 
   // Clock tree vertices between the clock source pin and register clk pins.
@@ -211,11 +269,17 @@ public:
   TagGroupIndex tagGroupCount() const;
   void reportTagGroups() const;
   void reportArrivalCountHistogram() const;
+  // Report live/free/dead arrival and prev path array memory.
+  void reportPathMemory() const;
+  // Copy arrival arrays to release memory held by deleted arrays.
+  void compactPaths();
   virtual int clkInfoCount() const;
   virtual bool isEndpoint(Vertex *vertex) const;
   virtual bool isEndpoint(Vertex *vertex,
 			  SearchPred *pred) const;
   void endpointInvalid(Vertex *vertex);
+  void insertEndpoint(Vertex *vertex);
+  void eraseEndpoint(Vertex *vertex);
   Tag *fromUnclkedInputTag(const Pin *pin,
 			   const RiseFall *rf,
 			   const MinMax *min_max,
@@ -475,6 +539,17 @@ protected:
   void findFilteredArrivals();
   void findArrivals1();
   void seedFilterStarts();
+  void filterConePins(ExceptionThruSeq *thrus,
+		      ExceptionTo *to,
+		      // Return values.
+		      PinSet &pins,
+		      bool &fanout);
+  void findFilterCone();
+  void findFilterCone(VertexSeq &roots,
+		      bool fanin,
+		      std::vector<bool> &cone);
+  bool filterMatches(ExceptionFrom *from,
+		     ExceptionThruSeq *thrus);
   bool hasEnabledChecks(Vertex *vertex) const;
   virtual float timingDerate(Vertex *from_vertex,
 			     TimingArc *arc,
@@ -482,7 +557,13 @@ protected:
 			     bool is_clk,
 			     const PathAnalysisPt *path_ap);
   void deletePaths();
+  void deleteArrivalState();
   void deletePaths(Vertex *vertex);
+  void deletePathArrays(Vertex *vertex);
+  void pathArrayCounts(const Vertex *vertex,
+		       // Return values.
+		       uint32_t &arrival_count,
+		       uint32_t &prev_path_count) const;
   TagGroup *findTagGroup(TagGroupBldr *group_bldr);
   void deleteFilterTags();
   void deleteFilterTagGroups();
@@ -492,9 +573,6 @@ protected:
   void findTotalNegativeSlacks();
   void updateInvalidTns();
   void clearWorstSlack();
-  void wnsSlacks(Vertex *vertex,
-		 // Return values.
-		 SlackSeq &slacks);
   void wnsTnsPreamble();
   void worstSlackPreamble();
   void deleteWorstSlacks();
@@ -530,6 +608,13 @@ protected:
   bool unconstrained_paths_;
   bool crpr_path_pruning_enabled_;
   bool crpr_approx_missing_requireds_;
+  float arrival_tolerance_;
+  bool timing_frozen_;
+  const Corner *search_corner_;
+  int arrival_seed_count_;
+  int arrival_visit_count_;
+  std::atomic<int> arrival_change_count_;
+  SearchObserver *observer_;
   // Search predicates.
   SearchPred *search_adj_;
   SearchPred *search_clk_;
@@ -589,6 +674,9 @@ protected:
   std::mutex pending_latch_outputs_lock_;
   VertexSet *endpoints_;
   VertexSet *invalid_endpoints_;
+  // endpoints_ in an array and the index of each endpoint in it.
+  VertexSeq endpoint_seq_;
+  UnorderedMap<Vertex*, size_t> endpoint_index_;
   // Filter exception to tag arrivals for
   // report_timing -from pin|inst -through.
   // -to is always nullptr.
@@ -596,6 +684,12 @@ protected:
   // filter_from_ is owned by filter_ if it exists.
   ExceptionFrom *filter_from_;
   ExceptionTo *filter_to_;
+  // Pins the filter cone is found from and if it includes their fanout.
+  PinSet filter_cone_pins_;
+  bool filter_cone_fanout_;
+  // Filter cone vertices indexed by VertexId.
+  // Empty if the filtered search is not restricted.
+  std::vector<bool> filter_cone_;
   bool found_downstream_clk_pins_;
   PathGroups *path_groups_;
   VisitPathEnds *visit_path_ends_;
@@ -794,6 +888,19 @@ protected:
   VisitPathEnds *visit_path_ends_;
 };
 
+// Notified of vertex arrival and required invalidations.
+class SearchObserver
+{
+public:
+  SearchObserver() {}
+  virtual ~SearchObserver() {}
+  virtual void arrivalInvalid(Vertex *vertex) = 0;
+  virtual void requiredInvalid(Vertex *vertex) = 0;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SearchObserver);
+};
+
 // This does not use SearchPred as a base class to avoid getting
 // two sets of StaState variables when multiple inheritance is used
 // to add the functions in this class to another.
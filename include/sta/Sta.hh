@@ -20,6 +20,8 @@
 
 #include "DisallowCopyAssign.hh"
 #include "StringSeq.hh"
+#include "StringUtil.hh"
+#include "Map.hh"
 #include "LibertyClass.hh"
 #include "NetworkClass.hh"
 #include "SdcClass.hh"
@@ -62,11 +64,18 @@ class Power;
 class PowerResult;
 class ClockIterator;
 class EquivCells;
+class RegisterIndex;
+class ArcDelayAnnotation;
+class SlewAnnotation;
+class SwapCellDelay;
+class StaMode;
 
 typedef InstanceSeq::Iterator SlowDrvrIterator;
+typedef Vector<SwapCellDelay> SwapCellDelaySeq;
 typedef Vector<const char*> CheckError;
 typedef Vector<CheckError*> CheckErrorSeq;
 typedef Vector<Corner*> CornerSeq;
+typedef Map<const char*, StaMode*, CharPtrLess> StaModeMap;
 
 enum class CmdNamespace { sta, sdc };
 
@@ -107,6 +116,10 @@ public:
   // Default number of threads to use.
   virtual int defaultThreadCount() const;
   void setThreadCount(int thread_count);
+  // Call in a process forked from this one. The dispatch queue
+  // threads are not copied by fork, so the queue is abandoned and
+  // the process runs single threaded.
+  void forkedProcessInit();
 
   virtual LibertyLibrary *readLiberty(const char *filename,
 				      Corner *corner,
@@ -595,6 +608,8 @@ public:
 		      int pin_levels,
 		      bool thru_disabled,
 		      bool thru_constants);
+  // True if the edge from/to pin instances have different parents.
+  bool crossesHierarchy(Edge *edge) const;
 
   // The set of clocks that reach pin.
   void clocks(const Pin *pin,
@@ -751,6 +766,17 @@ public:
 			const MinMaxAll *min_max,
 			const RiseFallBoth *rf,
 			float slew);
+  // Bulk annotation of delays/slews found by an external delay calculator.
+  // Delays and arrivals are invalidated once for all of the annotations
+  // instead of incrementally for each value.
+  // Annotations that reference deleted or unknown ids or out of range
+  // indices are ignored. Returns the number of values annotated.
+  size_t setArcDelays(const ArcDelayAnnotation *delays,
+		      size_t count);
+  size_t setAnnotatedSlews(const SlewAnnotation *slews,
+			   size_t count);
+  // Read a binary bulk annotation file (see BulkAnnotation.hh).
+  void readBulkAnnotations(const char *filename);
   void writeSdf(const char *filename,
 		Corner *corner,
 		char sdf_divider,
@@ -758,6 +784,13 @@ public:
 		bool gzip,
 		bool no_timestamp,
 		bool no_version);
+  // Write a liberty timing model of the design for corner
+  // (see MakeTimingModel.hh).
+  void writeTimingModel(const char *filename,
+			const char *min_filename,
+			const char *lib_name,
+			const char *cell_name,
+			const Corner *corner);
   // Remove all delay and slew annotations.
   void removeDelaySlewAnnotations();
   // TCL variable sta_crpr_enabled.
@@ -879,6 +912,39 @@ public:
 		     const SetupHold *setup_hold,
 		     int digits);
   float findWorstClkSkew(const SetupHold *setup_hold);
+  // Report the count largest register boundary partitions of the
+  // timing graph (see TimingPartition.hh).
+  void reportTimingPartitions(int count);
+  // Find the endpoint slacks of the register boundary partitions in
+  // worker_count forked processes and report the merged slacks
+  // (see PartitionWorkers.hh).
+  void reportPartitionSlacks(int worker_count,
+			     int digits);
+  // Find the arrivals of one corner at a time and report the merged
+  // slacks for each corner (see CornerSearch.hh).
+  void reportCornerSlacks(int digits);
+  // Find the path ends of one corner at a time and report them merged.
+  // Arguments are the same as findPathEnds.
+  // Returns false if there are no path ends.
+  bool reportCornerPathEnds(ExceptionFrom *from,
+			    ExceptionThruSeq *thrus,
+			    ExceptionTo *to,
+			    bool unconstrained,
+			    const Corner *corner,
+			    const MinMaxAll *min_max,
+			    int group_count,
+			    int endpoint_count,
+			    bool unique_pins,
+			    float slack_min,
+			    float slack_max,
+			    bool sort_by_slack,
+			    PathGroupNameSet *group_names,
+			    bool setup,
+			    bool hold,
+			    bool recovery,
+			    bool removal,
+			    bool clk_gating_setup,
+			    bool clk_gating_hold);
   // Header above reportPathEnd results.
   void reportPathEndHeader();
   // Footer below reportPathEnd results.
@@ -898,9 +964,22 @@ public:
   // If full=false update arrivals incrementally.
   // If full=true update all arrivals from scratch.
   void updateTiming(bool full);
+  // Update all arrivals, requireds, worst slacks and total negative
+  // slacks and freeze them. While timing is frozen the vertex/pin
+  // slew, arrival, required and slack functions, vertexWorst*Path,
+  // worstSlack and totalNegativeSlack do not update timing, so they
+  // can be called concurrently from multiple threads.
+  // The network, libraries, constraints and parasitics must not be
+  // changed by other threads while timing is frozen. Changing them
+  // from the calling thread or invalidating delays or arrivals
+  // thaws timing.
+  void freezeTiming();
+  void thawTiming();
+  bool timingFrozen() const;
   // Invalidate all delay calculations. Arrivals also invalidated.
   void delaysInvalid();
-  // Invalidate all arrival and required times.
+  // Invalidate all arrival and required times, including the arrivals
+  // kept for modes that are not current.
   void arrivalsInvalid();
   void visitStartpoints(VertexVisitor *visitor);
   void visitEndpoints(VertexVisitor *visitor);
@@ -1125,6 +1204,24 @@ public:
 			   Cell *to_cell);
   virtual void replaceCell(Instance *inst,
 			   LibertyCell *to_lib_cell);
+  // What-if evaluation of replaceCell(inst, swap_cell) for an
+  // equivalent cell that does not change the network or graph.
+  // Timing must be updated first (findRequireds), after which these
+  // may be called from multiple threads.
+  // Delays and slews that change (see GraphDelayCalc::swapCellDelays).
+  void swapCellDelays(const Instance *inst,
+		      LibertyCell *swap_cell,
+		      // nullptr for all corners.
+		      const Corner *corner,
+		      // Return value.
+		      SwapCellDelaySeq &delays);
+  // Estimated worst slack of paths thru the driver pins of inst
+  // with swap_cell.
+  Slack swapCellSlack(const Instance *inst,
+		      LibertyCell *swap_cell,
+		      // nullptr for all corners.
+		      const Corner *corner,
+		      const MinMax *min_max);
   virtual Net *makeNet(const char *name,
 		       Instance *parent);
   virtual void deleteNet(Net *net);
@@ -1185,6 +1282,25 @@ public:
   Corner *findCorner(const char *corner_name);
   bool multiCorner();
   void makeCorners(StringSet *corner_names);
+  // Modes are named sets of constraints that share the network,
+  // libraries, graph and parasitics. The constraints before the
+  // first mode is defined are the mode "default".
+  // Timing results are for the current mode only.
+  void makeMode(const char *mode_name);
+  bool modeExists(const char *mode_name);
+  const char *currentMode();
+  // Make mode_name the current mode.
+  // Each mode keeps its own arrivals and requireds while it is not
+  // current, and they are updated incrementally for the network,
+  // parasitic and annotation changes made in other modes. Delays that
+  // depend on the constraints of the previous and new mode are updated
+  // incrementally unless the modes have different analysis types,
+  // operating conditions, wireloads or liberty cell/port disables.
+  void setMode(const char *mode_name);
+  // updateTiming for every mode. The current mode is not changed.
+  void updateTimingModes(bool full);
+  // Caller owns the returned sequence but not the names.
+  StringSeq *modeNames();
   // Find all arc delays and vertex slews with delay calculator.
   virtual void findDelays();
   // Find arc delays and vertex slews thru to level of to_vertex.
@@ -1195,8 +1311,17 @@ public:
   // delays to be recomputed during incremental delay calculation.
   // Defaults to 0.0 for maximum accuracy and slowest incremental speed.
   void setIncrementalDelayTolerance(float tol);
+  // TCL variable sta_parallel_corner_delay_calc.
+  // Find the delays for each corner of a vertex in separate threads.
+  bool parallelCornerDelayCalc() const;
+  void setParallelCornerDelayCalc(bool parallel);
   // Make graph and find delays.
   void searchPreamble();
+  // searchPreamble that keeps the filtered arrivals from the last
+  // findPathEnds if they can be reused for from/thrus/to.
+  void searchPreamble(ExceptionFrom *from,
+		      ExceptionThruSeq *thrus,
+		      ExceptionTo *to);
 
   // Define the delay calculator implementation.
   void setArcDelayCalc(const char *delay_calc_name);
@@ -1238,6 +1363,10 @@ public:
   void makeEquivCells(LibertyLibrarySeq *equiv_libs,
 		      LibertyLibrarySeq *map_libs);
   LibertyCellSeq *equivCells(LibertyCell *cell);
+  // Equivalent cells sorted by drive resistance at corner/min_max.
+  LibertyCellSeq *equivCells(LibertyCell *cell,
+			     const Corner *corner,
+			     const MinMax *min_max);
 
 protected:
   // Default constructors that are called by makeComponents in the Sta
@@ -1345,7 +1474,7 @@ protected:
 		      int inst_level,
 		      int pin_level);
   void findRegisterPreamble();
-  bool crossesHierarchy(Edge *edge) const;
+  void registerIndexInvalid();
   void readLibertyAfter(LibertyLibrary *liberty,
 			Corner *corner,
 			const MinMax *min_max);
@@ -1357,6 +1486,17 @@ protected:
                            LibertyCell *to_lib_cell);
   void sdcChangedGraph();
   void ensureGraphSdcAnnotated();
+  void ensureModes();
+  StaMode *makeStaMode(Sdc *sdc,
+		       Search *search);
+  void saveModePaths(StaMode *mode);
+  void restoreModePaths(StaMode *mode);
+  // Delete the paths saved for the modes that are not current.
+  void deleteModePaths();
+  bool modeDelaysCompatible(Sdc *sdc1,
+			    Sdc *sdc2);
+  void modeDelaysInvalid();
+  void modeDelayInvalid(Vertex *vertex);
   CornerSeq makeCornerSeq(Corner *corner) const;
   void makeParasiticAnalysisPts();
 
@@ -1377,9 +1517,20 @@ protected:
   bool link_make_black_boxes_;
   bool update_genclks_;
   EquivCells *equiv_cells_;
+  // Register clock pins in the fanout of each clock for findRegister*.
+  RegisterIndex *register_index_;
   bool graph_sdc_annotated_;
+  // Constraints and search for each mode, including the current
+  // mode sdc_ and search_.
+  StaModeMap modes_;
+  const char *mode_name_;
   bool parasitics_per_corner_;
   bool parasitics_per_min_max_;
+  // Worst slack, worst vertex and tns indexed by path_ap_index
+  // while timing is frozen.
+  SlackSeq frozen_worst_slacks_;
+  VertexSeq frozen_worst_vertices_;
+  SlackSeq frozen_tns_;
 
   // Singleton sta used by tcl command interpreter.
   static Sta *sta_;
@@ -32,11 +32,19 @@ public:
   virtual void visit(Vertex *vertex) = 0;
   void operator()(Vertex *vertex) { visit(vertex); }
   virtual void levelFinished() {}
+  // BfsIterator::visitParallel with a sequence of visitors visits
+  // vertex with every visitor if this returns true and only with the
+  // first visitor otherwise.
+  virtual bool splitVisit(Vertex *) { return true; }
+  // Visit a vertex that splitVisit did not split with the first visitor.
+  virtual void visitUnsplit(Vertex *vertex) { visit(vertex); }
 
 private:
   DISALLOW_COPY_AND_ASSIGN(VertexVisitor);
 };
 
+typedef Vector<VertexVisitor*> VertexVisitorSeq;
+
 // Collect visited pins into a PinSet.
 class VertexPinCollector : public VertexVisitor
 {
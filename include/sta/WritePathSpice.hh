@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "SearchClass.hh"
+
 namespace sta {
 
 class Path;
@@ -37,4 +39,18 @@ writePathSpice(Path *path,
 	       const char *gnd_name,
 	       StaState *sta);
 
+// Write spice decks for path_ends to spice_directory/path_<n>.sp with
+// the subckts they use in spice_directory/path_<n>.subckt, where n
+// starts at 1. lib_subckt_filename is read once for all of the paths
+// and the decks are written in parallel when there are multiple threads.
+// Throws FileNotReadable, FileNotWritable, SubcktEndsMissing
+void
+writePathSpice(PathEndSeq *path_ends,
+	       const char *spice_directory,
+	       const char *lib_subckt_filename,
+	       const char *model_filename,
+	       const char *power_name,
+	       const char *gnd_name,
+	       StaState *sta);
+
 } // namespace
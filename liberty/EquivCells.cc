@@ -16,7 +16,11 @@
 
 #include "EquivCells.hh"
 
+#include <algorithm>
+#include <cstdint>
+
 #include "Hash.hh"
+#include "StringUtil.hh"
 #include "MinMax.hh"
 #include "PortDirection.hh"
 #include "Transition.hh"
@@ -31,8 +35,8 @@ namespace sta {
 
 using std::max;
 
-static unsigned
-hashCell(const LibertyCell *cell);
+typedef std::pair<float, LibertyCell*> DriveResistanceCell;
+
 static unsigned
 hashCellPorts(const LibertyCell *cell);
 static unsigned
@@ -40,6 +44,11 @@ hashCellSequentials(const LibertyCell *cell);
 static unsigned
 hashFuncExpr(const FuncExpr *expr);
 static unsigned
+hashFuncExprSignature(const FuncExpr *expr);
+static bool
+equivFuncExprs(const FuncExpr *expr1,
+	       const FuncExpr *expr2);
+static unsigned
 hashPort(const LibertyPort *port);
 static unsigned
 hashCellPgPorts(const LibertyCell *cell);
@@ -62,18 +71,38 @@ cellDriveResistance(const LibertyCell *cell)
   return 0.0;
 }
 
-class CellDriveResistanceGreater
+// Sort cells by decreasing drive resistance.
+// The resistances are found once per cell rather than per comparison.
+static void
+sortDriveResistance(const LibertyCellSeq *cells,
+		    int lib_ap_index,
+		    // Return value.
+		    LibertyCellSeq &sorted_cells)
 {
-public:
-  bool operator()(const LibertyCell *cell1,
-		  const LibertyCell *cell2) const
-  {
-    return cellDriveResistance(cell1) > cellDriveResistance(cell2);
+  Vector<DriveResistanceCell> cell_drives;
+  for (LibertyCell *cell : *cells) {
+    LibertyCell *drive_cell = cell;
+    if (lib_ap_index >= 0) {
+      LibertyCell *corner_cell = cell->cornerCell(lib_ap_index);
+      if (corner_cell)
+	drive_cell = corner_cell;
+    }
+    cell_drives.push_back(DriveResistanceCell(cellDriveResistance(drive_cell),
+					      cell));
   }
-};
+  std::stable_sort(cell_drives.begin(), cell_drives.end(),
+		   [] (const DriveResistanceCell &drive1,
+		       const DriveResistanceCell &drive2) {
+		     return drive1.first > drive2.first;
+		   });
+  sorted_cells.clear();
+  for (DriveResistanceCell &cell_drive : cell_drives)
+    sorted_cells.push_back(cell_drive.second);
+}
 
 EquivCells::EquivCells(LibertyLibrarySeq *equiv_libs,
-		       LibertyLibrarySeq *map_libs)
+		       LibertyLibrarySeq *map_libs,
+		       int lib_ap_count)
 {
   LibertyCellHashMap hash_matches;
   for (auto lib : *equiv_libs)
@@ -81,8 +110,11 @@ EquivCells::EquivCells(LibertyLibrarySeq *equiv_libs,
   // Sort the equiv sets by drive resistance.
   for (auto cell : unique_equiv_cells_) {
     auto equivs = equiv_cells_.findKey(cell);
-    sort(equivs, CellDriveResistanceGreater());
+    LibertyCellSeq sorted_equivs;
+    sortDriveResistance(equivs, -1, sorted_equivs);
+    *equivs = sorted_equivs;
   }
+  sortCornerEquivCells(lib_ap_count);
   if (map_libs) {
     for (auto lib : *map_libs)
       mapEquivCells(lib, hash_matches);
@@ -92,18 +124,59 @@ EquivCells::EquivCells(LibertyLibrarySeq *equiv_libs,
 
 EquivCells::~EquivCells()
 {
-  for (auto cell : unique_equiv_cells_)
-    delete equiv_cells_.findKey(cell);
+  for (auto cell : unique_equiv_cells_) {
+    LibertyCellSeq *equivs = equiv_cells_.findKey(cell);
+    CornerEquivCells *corner_equivs = corner_equiv_cells_.findKey(equivs);
+    if (corner_equivs) {
+      corner_equivs->deleteContents();
+      delete corner_equivs;
+    }
+    delete equivs;
+  }
 }
 
 LibertyCellSeq *
-EquivCells::equivs(LibertyCell *cell)
+EquivCells::equivs(const LibertyCell *cell) const
 {
   return equiv_cells_.findKey(cell);
 }
 
-// Use a comprehensive hash on cell properties to segregate
-// cells into groups of potential matches.
+LibertyCellSeq *
+EquivCells::equivs(const LibertyCell *cell,
+		   int lib_ap_index) const
+{
+  LibertyCellSeq *equivs = equiv_cells_.findKey(cell);
+  if (equivs) {
+    CornerEquivCells *corner_equivs = corner_equiv_cells_.findKey(equivs);
+    if (corner_equivs
+	&& lib_ap_index >= 0
+	&& lib_ap_index < static_cast<int>(corner_equivs->size()))
+      return (*corner_equivs)[lib_ap_index];
+  }
+  return equivs;
+}
+
+void
+EquivCells::sortCornerEquivCells(int lib_ap_count)
+{
+  if (lib_ap_count > 0) {
+    for (auto cell : unique_equiv_cells_) {
+      LibertyCellSeq *equivs = equiv_cells_.findKey(cell);
+      CornerEquivCells *corner_equivs = new CornerEquivCells;
+      for (int ap_index = 0; ap_index < lib_ap_count; ap_index++) {
+	LibertyCellSeq *sorted_equivs = new LibertyCellSeq;
+	sortDriveResistance(equivs, ap_index, *sorted_equivs);
+	corner_equivs->push_back(sorted_equivs);
+      }
+      corner_equiv_cells_[equivs] = corner_equivs;
+    }
+  }
+}
+
+// Use the cell signatures found when the cells are read to segregate
+// cells into groups of potential matches. Each group only holds the
+// first cell of each equivalence class, so a cell is compared to one
+// cell per class with the same signature.
 void
 EquivCells::findEquivCells(const LibertyLibrary *library,
 			   LibertyCellHashMap &hash_matches)
@@ -112,12 +185,11 @@ EquivCells::findEquivCells(const LibertyLibrary *library,
   while (cell_iter.hasNext()) {
     LibertyCell *cell = cell_iter.next();
     if (!cell->dontUse()) {
-      unsigned hash = hashCell(cell);
+      unsigned hash = cell->equivSignature();
       LibertyCellSeq *matches = hash_matches.findKey(hash);
       if (matches) {
-	LibertyCellSeq::Iterator match_iter(matches);
-	while (match_iter.hasNext()) {
-	  LibertyCell *match = match_iter.next();
+	bool found_match = false;
+	for (LibertyCell *match : *matches) {
 	  if (equivCells(match, cell)) {
 	    LibertyCellSeq *equivs = equiv_cells_.findKey(match);
 	    if (equivs == nullptr) {
@@ -128,10 +200,12 @@ EquivCells::findEquivCells(const LibertyLibrary *library,
 	    }
 	    equivs->push_back(cell);
 	    equiv_cells_[cell] = equivs;
+	    found_match = true;
 	    break;
 	  }
 	}
-	matches->push_back(cell);
+	if (!found_match)
+	  matches->push_back(cell);
       }
       else {
 	matches = new LibertyCellSeq;
@@ -152,12 +226,10 @@ EquivCells::mapEquivCells(const LibertyLibrary *library,
   while (cell_iter.hasNext()) {
     LibertyCell *cell = cell_iter.next();
     if (!cell->dontUse()) {
-      unsigned hash = hashCell(cell);
+      unsigned hash = cell->equivSignature();
       LibertyCellSeq *matches = hash_matches.findKey(hash);
       if (matches) {
-	LibertyCellSeq::Iterator match_iter(matches);
-	while (match_iter.hasNext()) {
-	  LibertyCell *match = match_iter.next();
+	for (LibertyCell *match : *matches) {
 	  if (equivCells(match, cell)) {
 	    LibertyCellSeq *equivs = equiv_cells_.findKey(match);
 	    equiv_cells_[cell] = equivs;
@@ -169,12 +241,13 @@ EquivCells::mapEquivCells(const LibertyLibrary *library,
   }
 }
 
-static unsigned
-hashCell(const LibertyCell *cell)
+unsigned
+equivCellSignature(const LibertyCell *cell)
 {
   return hashCellPorts(cell)
     + hashCellPgPorts(cell)
-    + hashCellSequentials(cell);
+    + hashCellSequentials(cell)
+    + cell->timingArcSetCount() * 23;
 }
 
 static unsigned
@@ -185,8 +258,8 @@ hashCellPorts(const LibertyCell *cell)
   while (port_iter.hasNext()) {
     LibertyPort *port = port_iter.next();
     hash += hashPort(port);
-    hash += hashFuncExpr(port->function()) * 3;
-    hash += hashFuncExpr(port->tristateEnable()) * 5;
+    hash += hashFuncExprSignature(port->function()) * 3;
+    hash += hashFuncExprSignature(port->tristateEnable()) * 5;
   }
   return hash;
 }
@@ -256,6 +329,140 @@ hashFuncExpr(const FuncExpr *expr)
   }
 }
 
+// Truth table of the function of up to 6 ports in 64 bits.
+static const size_t truth_table_port_count_max = 6;
+static const uint64_t truth_table_port_bits[truth_table_port_count_max] = {
+  0xaaaaaaaaaaaaaaaaULL,
+  0xccccccccccccccccULL,
+  0xf0f0f0f0f0f0f0f0ULL,
+  0xff00ff00ff00ff00ULL,
+  0xffff0000ffff0000ULL,
+  0xffffffff00000000ULL
+};
+
+static void
+funcExprPorts(const FuncExpr *expr,
+	      // Return value.
+	      LibertyPortSeq &ports)
+{
+  switch (expr->op()) {
+  case FuncExpr::op_port: {
+    LibertyPort *port = expr->port();
+    if (std::find(ports.begin(), ports.end(), port) == ports.end())
+      ports.push_back(port);
+    break;
+  }
+  case FuncExpr::op_not:
+    funcExprPorts(expr->left(), ports);
+    break;
+  case FuncExpr::op_or:
+  case FuncExpr::op_and:
+  case FuncExpr::op_xor:
+    funcExprPorts(expr->left(), ports);
+    funcExprPorts(expr->right(), ports);
+    break;
+  case FuncExpr::op_one:
+  case FuncExpr::op_zero:
+    break;
+  }
+}
+
+// ports are the truth table variables, matched by name so the
+// functions of different cells can be compared.
+static uint64_t
+funcExprTruthTable(const FuncExpr *expr,
+		   const LibertyPortSeq &ports)
+{
+  switch (expr->op()) {
+  case FuncExpr::op_port: {
+    const char *port_name = expr->port()->name();
+    auto port_iter = std::find_if(ports.begin(), ports.end(),
+				  [port_name] (const LibertyPort *port) {
+				    return stringEq(port->name(), port_name);
+				  });
+    return truth_table_port_bits[port_iter - ports.begin()];
+  }
+  case FuncExpr::op_not:
+    return ~funcExprTruthTable(expr->left(), ports);
+  case FuncExpr::op_or:
+    return funcExprTruthTable(expr->left(), ports)
+      | funcExprTruthTable(expr->right(), ports);
+  case FuncExpr::op_and:
+    return funcExprTruthTable(expr->left(), ports)
+      & funcExprTruthTable(expr->right(), ports);
+  case FuncExpr::op_xor:
+    return funcExprTruthTable(expr->left(), ports)
+      ^ funcExprTruthTable(expr->right(), ports);
+  case FuncExpr::op_one:
+    return ~static_cast<uint64_t>(0);
+  case FuncExpr::op_zero:
+    return 0;
+  }
+  return 0;
+}
+
+// Hash functions by truth table so the hash does not depend on how
+// the function is written. Functions of bus ports or too many ports
+// to tabulate use the expression hash.
+static unsigned
+hashFuncExprSignature(const FuncExpr *expr)
+{
+  if (expr == nullptr)
+    return 0;
+  else {
+    LibertyPortSeq ports;
+    funcExprPorts(expr, ports);
+    if (ports.size() > truth_table_port_count_max)
+      return hashFuncExpr(expr);
+    for (LibertyPort *port : ports) {
+      if (port->isBus())
+	return hashFuncExpr(expr);
+    }
+    // Order the truth table variables by name so equivalent cells
+    // have the same tables.
+    sort(ports, LibertyPortNameLess());
+    unsigned hash = 0;
+    for (LibertyPort *port : ports)
+      hash += hashPort(port);
+    uint64_t truth_table = funcExprTruthTable(expr, ports);
+    hash += hashSum(truth_table >> 32, truth_table & 0xffffffff) * 7;
+    return hash;
+  }
+}
+
+// Functions are equivalent if they have the same truth table, so
+// !(A*B) and !A+!B match. Functions of bus ports or too many ports to
+// tabulate are compared by expression.
+static bool
+equivFuncExprs(const FuncExpr *expr1,
+	       const FuncExpr *expr2)
+{
+  if (expr1 == nullptr || expr2 == nullptr)
+    return expr1 == expr2;
+  else {
+    LibertyPortSeq ports1, ports2;
+    funcExprPorts(expr1, ports1);
+    funcExprPorts(expr2, ports2);
+    // Truth table variables are the ports of either function.
+    LibertyPortSeq ports = ports1;
+    for (LibertyPort *port2 : ports2) {
+      const char *port_name = port2->name();
+      if (std::find_if(ports1.begin(), ports1.end(),
+		       [port_name] (const LibertyPort *port1) {
+			 return stringEq(port1->name(), port_name);
+		       }) == ports1.end())
+	ports.push_back(port2);
+    }
+    if (ports.size() > truth_table_port_count_max)
+      return FuncExpr::equiv(expr1, expr2);
+    for (LibertyPort *port : ports) {
+      if (port->isBus())
+	return FuncExpr::equiv(expr1, expr2);
+    }
+    return funcExprTruthTable(expr1, ports) == funcExprTruthTable(expr2, ports);
+  }
+}
+
 bool
 equivCells(const LibertyCell *cell1,
 	   const LibertyCell *cell2)
@@ -280,9 +487,9 @@ equivCellPortsAndFuncs(const LibertyCell *cell1,
       LibertyPort *port2 = cell2->findLibertyPort(name);
       if (!(port2
 	    && LibertyPort::equiv(port1, port2)
-	    && FuncExpr::equiv(port1->function(), port2->function())
-	    && FuncExpr::equiv(port1->tristateEnable(),
-			       port2->tristateEnable()))){
+	    && equivFuncExprs(port1->function(), port2->function())
+	    && equivFuncExprs(port1->tristateEnable(),
+			      port2->tristateEnable()))){
         return false;
       }
     }
@@ -263,16 +263,8 @@ LibertyLibrary::scaleFactor(ScaleFactorType type,
       scale_factors = cell->scaleFactors();
     if (scale_factors == nullptr)
       scale_factors = scale_factors_;
-    if (scale_factors) {
-      float process_scale = 1.0F + (pvt->process() - nominal_process_)
-	* scale_factors->scale(type, ScaleFactorPvt::process, tr_index);
-      float temp_scale = 1.0F + (pvt->temperature() - nominal_temperature_)
-	* scale_factors->scale(type, ScaleFactorPvt::temp, tr_index);
-      float volt_scale = 1.0F + (pvt->voltage() - nominal_voltage_)
-	* scale_factors->scale(type, ScaleFactorPvt::volt, tr_index);
-      float scale = process_scale * temp_scale * volt_scale;
-      return scale;
-    }
+    if (scale_factors)
+      return pvt->scaleFactor(type, tr_index, scale_factors, this);
   }
   return 1.0F;
 }
@@ -862,6 +854,7 @@ LibertyCell::LibertyCell(LibertyLibrary *library,
   ocv_arc_depth_(0.0),
   ocv_derate_(nullptr),
   is_disabled_constraint_(false),
+  equiv_signature_(0),
   leakage_power_(0.0),
   leakage_power_exists_(false)
 {
@@ -1222,6 +1215,7 @@ LibertyCell::finish(bool infer_latches,
   if (infer_latches
       && !interface_timing_)
     inferLatchRoles(debug);
+  equiv_signature_ = equivCellSignature(this);
 }
 
 void
@@ -2580,31 +2574,110 @@ TableTemplate::setAxis3(TableAxis *axis)
 
 ////////////////////////////////////////////////////////////////
 
+// Scale factors of a ScaleFactors evaluated at a pvt.
+class PvtScaleFactors
+{
+public:
+  ScaleFactors *scale_factors_;
+  uint64_t scale_factors_id_;
+  float scales_[scale_factor_type_count][RiseFall::index_count];
+  PvtScaleFactors *next_;
+};
+
 Pvt::Pvt(float process,
 	 float voltage,
 	 float temperature) :
   process_(process),
   voltage_(voltage),
-  temperature_(temperature)
+  temperature_(temperature),
+  scale_factors_(nullptr)
 {
 }
 
+Pvt::~Pvt()
+{
+  deleteScaleFactors();
+}
+
+void
+Pvt::deleteScaleFactors()
+{
+  PvtScaleFactors *pvt_scales = scale_factors_.exchange(nullptr);
+  while (pvt_scales) {
+    PvtScaleFactors *next = pvt_scales->next_;
+    delete pvt_scales;
+    pvt_scales = next;
+  }
+}
+
 void
 Pvt::setProcess(float process)
 {
   process_ = process;
+  deleteScaleFactors();
 }
 
 void
 Pvt::setVoltage(float voltage)
 {
   voltage_ = voltage;
+  deleteScaleFactors();
 }
 
 void
 Pvt::setTemperature(float temp)
 {
   temperature_ = temp;
+  deleteScaleFactors();
+}
+
+static PvtScaleFactors *
+findPvtScaleFactors(PvtScaleFactors *pvt_scales,
+		    const ScaleFactors *scale_factors)
+{
+  // The id guards against a deleted ScaleFactors address being reused.
+  while (pvt_scales
+	 && !(pvt_scales->scale_factors_ == scale_factors
+	      && pvt_scales->scale_factors_id_ == scale_factors->id()))
+    pvt_scales = pvt_scales->next_;
+  return pvt_scales;
+}
+
+float
+Pvt::scaleFactor(ScaleFactorType type,
+		 int tr_index,
+		 ScaleFactors *scale_factors,
+		 const LibertyLibrary *library) const
+{
+  PvtScaleFactors *pvt_scales =
+    findPvtScaleFactors(scale_factors_.load(std::memory_order_acquire),
+			scale_factors);
+  if (pvt_scales == nullptr) {
+    std::lock_guard<std::mutex> lock(scale_factors_lock_);
+    PvtScaleFactors *head = scale_factors_.load(std::memory_order_relaxed);
+    pvt_scales = findPvtScaleFactors(head, scale_factors);
+    if (pvt_scales == nullptr) {
+      pvt_scales = new PvtScaleFactors;
+      pvt_scales->scale_factors_ = scale_factors;
+      pvt_scales->scale_factors_id_ = scale_factors->id();
+      for (int type_index = 0; type_index < scale_factor_type_count; type_index++) {
+	ScaleFactorType type1 = static_cast<ScaleFactorType>(type_index);
+	for (auto tr_index1 : RiseFall::rangeIndex()) {
+	  float process_scale = 1.0F + (process_ - library->nominalProcess())
+	    * scale_factors->scale(type1, ScaleFactorPvt::process, tr_index1);
+	  float temp_scale = 1.0F + (temperature_-library->nominalTemperature())
+	    * scale_factors->scale(type1, ScaleFactorPvt::temp, tr_index1);
+	  float volt_scale = 1.0F + (voltage_ - library->nominalVoltage())
+	    * scale_factors->scale(type1, ScaleFactorPvt::volt, tr_index1);
+	  pvt_scales->scales_[type_index][tr_index1] =
+	    process_scale * temp_scale * volt_scale;
+	}
+      }
+      pvt_scales->next_ = head;
+      scale_factors_.store(pvt_scales, std::memory_order_release);
+    }
+  }
+  return pvt_scales->scales_[int(type)][tr_index];
 }
 
 OperatingConditions::OperatingConditions(const char *name) :
@@ -2715,8 +2788,11 @@ scaleFactorPvtName(ScaleFactorPvt pvt)
 
 ////////////////////////////////////////////////////////////////
 
+static std::atomic<uint64_t> scale_factors_next_id(0);
+
 ScaleFactors::ScaleFactors(const char *name) :
-  name_(stringCopy(name))
+  name_(stringCopy(name)),
+  id_(scale_factors_next_id++)
 {
   for (int type = 0; type < scale_factor_type_count; type++) {
     for (int pvt = 0; pvt < int(ScaleFactorPvt::count); pvt++) {
@@ -963,7 +963,7 @@ ConcreteNetwork::findInstNetsMatching(const Instance *instance,
 {
   const ConcreteInstance *inst =
     reinterpret_cast<const ConcreteInstance*>(instance);
-  inst->findNetsMatching(pattern, nets);
+  inst->findNetsMatching(pattern, dispatch_queue_, thread_count_, nets);
 }
 
 ////////////////////////////////////////////////////////////////
@@ -1566,16 +1566,28 @@ ConcreteInstance::findNet(const char *net_name) const
 
 void
 ConcreteInstance::findNetsMatching(const PatternMatch *pattern,
+				   DispatchQueue *dispatch_queue,
+				   int thread_count,
 				   NetSeq *nets) const
 {
   if (pattern->hasWildcards()) {
+    std::vector<const char*> net_names;
+    std::vector<ConcreteNet*> cnets;
     ConcreteInstanceNetMap::Iterator net_iter(nets_);
     while (net_iter.hasNext()) {
       const char *net_name;
       ConcreteNet *cnet;
       net_iter.next(net_name, cnet);
-      if (pattern->match(net_name))
-	nets->push_back(reinterpret_cast<Net*>(cnet));
+      net_names.push_back(net_name);
+      cnets.push_back(cnet);
+    }
+    std::vector<char> matches;
+    patternMatchNames(pattern, net_names.size(),
+		      [&] (size_t index) { return net_names[index]; },
+		      dispatch_queue, thread_count, matches);
+    for (size_t i = 0; i < cnets.size(); i++) {
+      if (matches[i])
+	nets->push_back(reinterpret_cast<Net*>(cnets[i]));
     }
   }
   else {
@@ -635,18 +635,26 @@ Network::findInstancesMatching1(const Instance *context,
 				const PatternMatch *pattern,
 				InstanceSeq *insts) const
 {
+  InstanceSeq children;
   InstanceChildIterator *child_iter = childIterator(context);
-  while (child_iter->hasNext()) {
-    Instance *child = child_iter->next();
-    const char *child_name = pathName(child);
-    // Remove context prefix from the name.
-    const char *child_context_name = &child_name[context_name_length];
-    if (pattern->match(child_context_name))
+  while (child_iter->hasNext())
+    children.push_back(child_iter->next());
+  delete child_iter;
+  std::vector<char> matches;
+  patternMatchNames(pattern, children.size(),
+		    [&] (size_t index) {
+		      const char *child_name = pathName(children[index]);
+		      // Remove context prefix from the name.
+		      return &child_name[context_name_length];
+		    },
+		    dispatch_queue_, thread_count_, matches);
+  for (size_t i = 0; i < children.size(); i++) {
+    Instance *child = children[i];
+    if (matches[i])
       insts->push_back(child);
     if (!isLeaf(child))
       findInstancesMatching1(child, context_name_length, pattern, insts);
   }
-  delete child_iter;
 }
 
 void
@@ -672,13 +680,19 @@ Network::findChildrenMatching(const Instance *parent,
 			      InstanceSeq *insts) const
 {
   if (pattern->hasWildcards()) {
+    InstanceSeq children;
     InstanceChildIterator *child_iter = childIterator(parent);
-    while (child_iter->hasNext()) {
-      Instance *child = child_iter->next();
-      if (pattern->match(name(child)))
-	insts->push_back(child);
-    }
+    while (child_iter->hasNext())
+      children.push_back(child_iter->next());
     delete child_iter;
+    std::vector<char> matches;
+    patternMatchNames(pattern, children.size(),
+		      [&] (size_t index) { return name(children[index]); },
+		      dispatch_queue_, thread_count_, matches);
+    for (size_t i = 0; i < children.size(); i++) {
+      if (matches[i])
+	insts->push_back(children[i]);
+    }
   }
   else {
     Instance *child = findChild(parent, pattern->pattern());
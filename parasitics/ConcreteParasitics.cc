@@ -23,6 +23,7 @@
 #include "Debug.hh"
 #include "Error.hh"
 #include "Mutex.hh"
+#include "Hash.hh"
 #include "Set.hh"
 #include "MinMax.hh"
 #include "Network.hh"
@@ -35,6 +36,7 @@
 #include "Parasitics.hh"
 #include "ConcreteParasiticsPvt.hh"
 #include "Corner.hh"
+#include "DcalcAnalysisPt.hh"
 
 // Multiple inheritance is used to share elmore and pi model base
 // classes, but care is taken to make sure there are no loops in the
@@ -295,6 +297,9 @@ ConcretePiElmoreEstimated::ConcretePiElmoreEstimated(float c2,
 						     const OperatingConditions *op,
 						     const Corner *corner,
 						     const MinMax *min_max,
+						     const Wireload *wireload,
+						     float fanout,
+						     float net_pin_cap,
 						     Sdc *sdc):
   ConcretePi(c2, rpi, c1),
   elmore_res_(elmore_res),
@@ -304,10 +309,29 @@ ConcretePiElmoreEstimated::ConcretePiElmoreEstimated(float c2,
   op_cond_(op),
   corner_(corner),
   min_max_(min_max),
+  wireload_(wireload),
+  fanout_(fanout),
+  net_pin_cap_(net_pin_cap),
   sdc_(sdc)
 {
 }
 
+bool
+ConcretePiElmoreEstimated::isEstimate(const Wireload *wireload,
+				      float fanout,
+				      float net_pin_cap,
+				      const OperatingConditions *op_cond,
+				      const Corner *corner,
+				      const MinMax *min_max) const
+{
+  return wireload == wireload_
+    && fanout == fanout_
+    && net_pin_cap == net_pin_cap_
+    && op_cond == op_cond_
+    && corner == corner_
+    && min_max == min_max_;
+}
+
 float
 ConcretePiElmoreEstimated::capacitance() const
 {
@@ -905,6 +929,49 @@ ConcreteParasitics::deleteParasitics()
     }
   }
   parasitic_network_map_.clear();
+
+  deleteEstimatedParasitics();
+}
+
+void
+ConcreteParasitics::deleteEstimatedParasitics()
+{
+  for (int i = 0; i < estimate_shard_count; i++) {
+    ConcreteEstimatedMap &estimated_map = estimated_parasitic_maps_[i];
+    for (auto &drvr_estimates : estimated_map)
+      drvr_estimates.second.deleteContents();
+    estimated_map.clear();
+  }
+}
+
+// Delete estimated parasitics on pin's net.
+void
+ConcreteParasitics::deleteEstimatedParasitics(const Pin *pin)
+{
+  PinSet *drivers = network_->drivers(pin);
+  if (drivers) {
+    for (auto drvr_pin : *drivers)
+      deleteDrvrEstimatedParasitics(drvr_pin);
+  }
+}
+
+void
+ConcreteParasitics::deleteDrvrEstimatedParasitics(const Pin *drvr_pin)
+{
+  size_t shard = estimateShard(drvr_pin);
+  ConcreteEstimatedMap &estimated_map = estimated_parasitic_maps_[shard];
+  UniqueLock lock(estimate_locks_[shard]);
+  auto itr = estimated_map.find(drvr_pin);
+  if (itr != estimated_map.end()) {
+    itr->second.deleteContents();
+    estimated_map.erase(itr);
+  }
+}
+
+size_t
+ConcreteParasitics::estimateShard(const Pin *drvr_pin) const
+{
+  return hashPtr(drvr_pin) % estimate_shard_count;
 }
 
 void
@@ -974,6 +1041,7 @@ ConcreteParasitics::setIsReducedParasiticNetwork(Parasitic *parasitic,
 void
 ConcreteParasitics::disconnectPinBefore(const Pin *pin)
 {
+  deleteEstimatedParasitics(pin);
   if (haveParasitics()) {
     deleteReducedParasitics(pin);
 
@@ -992,11 +1060,20 @@ ConcreteParasitics::disconnectPinBefore(const Pin *pin)
   }
 }
 
+void
+ConcreteParasitics::deletePinBefore(const Pin *pin)
+{
+  if (network_->isDriver(pin))
+    deleteDrvrEstimatedParasitics(pin);
+}
+
 void
 ConcreteParasitics::loadPinCapacitanceChanged(const Pin *pin)
 {
-  // Delete reduced models that depend on load pin capacitances.
+  // Delete reduced and estimated models that depend on load pin
+  // capacitances.
   deleteReducedParasitics(pin);
+  deleteEstimatedParasitics(pin);
 }
 
 // Delete reduced models on pin's net.
@@ -1664,6 +1741,23 @@ ConcreteParasitics::estimatePiElmore(const Pin *drvr_pin,
 				     const MinMax *min_max,
 				     const ParasiticAnalysisPt *)
 {
+  // Estimates depend on the delay calc analysis pt operating conditions
+  // so they are indexed by it rather than the parasitic analysis pt.
+  const DcalcAnalysisPt *dcalc_ap = corner->findDcalcAnalysisPt(min_max);
+  size_t estimate_index = dcalc_ap->index() * RiseFall::index_count
+    + rf->index();
+  size_t shard = estimateShard(drvr_pin);
+  UniqueLock lock(estimate_locks_[shard]);
+  ConcretePiElmoreEstimatedSeq &estimates =
+    estimated_parasitic_maps_[shard][drvr_pin];
+  if (estimate_index >= estimates.size())
+    estimates.resize(estimate_index + 1, nullptr);
+  ConcretePiElmoreEstimated *&estimate = estimates[estimate_index];
+  if (estimate
+      && estimate->isEstimate(wireload, fanout, net_pin_cap,
+			      op_cond, corner, min_max))
+    return estimate;
+
   float c2, rpi, c1, elmore_res, elmore_cap;
   bool elmore_use_load_cap;
   estimatePiElmore(drvr_pin, rf, wireload, fanout, net_pin_cap,
@@ -1671,13 +1765,15 @@ ConcreteParasitics::estimatePiElmore(const Pin *drvr_pin,
 		   c2, rpi, c1,
 		   elmore_res, elmore_cap, elmore_use_load_cap);
 
+  delete estimate;
+  estimate = nullptr;
   if (c1 > 0.0 || c2 > 0.0)
-    return new ConcretePiElmoreEstimated(c2, rpi, c1, elmore_res, elmore_cap,
-					 elmore_use_load_cap,
-					 rf, op_cond, corner, min_max,
-					 sdc_);
-  else
-    return nullptr;
+    estimate = new ConcretePiElmoreEstimated(c2, rpi, c1, elmore_res,
+					     elmore_cap, elmore_use_load_cap,
+					     rf, op_cond, corner, min_max,
+					     wireload, fanout, net_pin_cap,
+					     sdc_);
+  return estimate;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -32,8 +32,11 @@ class ConcretePiPoleResidue;
 class ConcreteParasiticNetwork;
 class ConcreteParasiticNode;
 class ConcreteParasiticDevice;
+class ConcretePiElmoreEstimated;
 
 typedef Map<const Pin*, ConcreteParasitic**> ConcreteParasiticMap;
+typedef Vector<ConcretePiElmoreEstimated*> ConcretePiElmoreEstimatedSeq;
+typedef Map<const Pin*, ConcretePiElmoreEstimatedSeq> ConcreteEstimatedMap;
 typedef Map<const Net*, ConcreteParasiticNetwork**> ConcreteParasiticNetworkMap;
 
 // This class acts as a BUILDER for all parasitics.
@@ -159,6 +162,7 @@ public:
 				      const MinMax *min_max,
 				      const ParasiticAnalysisPt *ap);
   virtual void disconnectPinBefore(const Pin *pin);
+  virtual void deletePinBefore(const Pin *pin);
   virtual void loadPinCapacitanceChanged(const Pin *pin);
 
   virtual void reduceTo(Parasitic *parasitic,
@@ -200,12 +204,23 @@ protected:
   Parasitic *ensureRspf(const Pin *drvr_pin);
   void makeAnalysisPtAfter();
   void deleteReducedParasitics(const Pin *pin);
+  void deleteEstimatedParasitics();
+  void deleteEstimatedParasitics(const Pin *pin);
+  void deleteDrvrEstimatedParasitics(const Pin *drvr_pin);
+  size_t estimateShard(const Pin *drvr_pin) const;
 
   // Driver pin to array of parasitics indexed by analysis pt index
   // and transition.
   ConcreteParasiticMap drvr_parasitic_map_;
   ConcreteParasiticNetworkMap parasitic_network_map_;
   mutable std::mutex lock_;
+  // Driver pin to wireload estimated parasitics indexed by
+  // delay calc analysis pt index and transition.
+  // Delay calc threads estimate drivers concurrently, so the map is
+  // sharded by driver pin with a lock per shard.
+  static const int estimate_shard_count = 64;
+  ConcreteEstimatedMap estimated_parasitic_maps_[estimate_shard_count];
+  std::mutex estimate_locks_[estimate_shard_count];
 
   using EstimateParasitics::estimatePiElmore;
   friend class ConcretePiElmore;
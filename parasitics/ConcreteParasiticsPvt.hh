@@ -160,7 +160,17 @@ public:
 			    const OperatingConditions *op_cond,
 			    const Corner *corner,
 			    const MinMax *min_max,
+			    const Wireload *wireload,
+			    float fanout,
+			    float net_pin_cap,
 			    Sdc *sdc);
+  // True if the estimate was made with the same wireload and loads.
+  bool isEstimate(const Wireload *wireload,
+		  float fanout,
+		  float net_pin_cap,
+		  const OperatingConditions *op_cond,
+		  const Corner *corner,
+		  const MinMax *min_max) const;
   virtual float capacitance() const;
   virtual bool isPiElmore() const { return true; }
   virtual bool isPiModel() const { return true; }
@@ -177,6 +187,9 @@ private:
   const OperatingConditions *op_cond_;
   const Corner *corner_;
   const MinMax *min_max_;
+  const Wireload *wireload_;
+  float fanout_;
+  float net_pin_cap_;
   Sdc *sdc_;
 };
 
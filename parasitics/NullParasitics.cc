@@ -448,6 +448,11 @@ NullParasitics::disconnectPinBefore(const Pin *)
 {
 }
 
+void
+NullParasitics::deletePinBefore(const Pin *)
+{
+}
+
 void
 NullParasitics::loadPinCapacitanceChanged(const Pin *)
 {
@@ -134,6 +134,13 @@ Sdc::~Sdc()
   deleteConstraints();
 }
 
+void
+Sdc::copyState(const StaState *sta)
+{
+  StaState::copyState(sta);
+  sdc_ = this;
+}
+
 // This does NOT call initVariables() because those variable values
 // survive linking a new design.
 void
@@ -349,31 +356,37 @@ Sdc::removeLoadCaps()
 
 void
 Sdc::removeLibertyAnnotations()
+{
+  annotateLibertyDisables(false);
+}
+
+void
+Sdc::annotateLibertyDisables(bool disabled)
 {
   DisabledCellPortsMap::Iterator disabled_iter(disabled_cell_ports_);
   while (disabled_iter.hasNext()) {
     DisabledCellPorts *disable = disabled_iter.next();
     LibertyCell *cell = disable->cell();
     if (disable->all())
-      cell->setIsDisabledConstraint(false);
+      cell->setIsDisabledConstraint(disabled);
 
     LibertyPortSet::Iterator from_iter(disable->from());
     while (from_iter.hasNext()) {
       LibertyPort *from = from_iter.next();
-      from->setIsDisabledConstraint(false);
+      from->setIsDisabledConstraint(disabled);
     }
 
     LibertyPortSet::Iterator to_iter(disable->to());
     while (to_iter.hasNext()) {
       LibertyPort *to = to_iter.next();
-      to->setIsDisabledConstraint(false);
+      to->setIsDisabledConstraint(disabled);
     }
 
     if (disable->timingArcSets()) {
       TimingArcSetSet::Iterator arc_iter(disable->timingArcSets());
       while (arc_iter.hasNext()) {
 	TimingArcSet *arc_set = arc_iter.next();
-	arc_set->setIsDisabledConstraint(false);
+	arc_set->setIsDisabledConstraint(disabled);
       }
     }
 
@@ -385,7 +398,7 @@ Sdc::removeLibertyAnnotations()
       LibertyCellTimingArcSetIterator arc_iter(cell, from, to);
       while (arc_iter.hasNext()) {
 	TimingArcSet *arc_set = arc_iter.next();
-	arc_set->setIsDisabledConstraint(false);
+	arc_set->setIsDisabledConstraint(disabled);
       }
     }
   }
@@ -393,7 +406,55 @@ Sdc::removeLibertyAnnotations()
   LibertyPortSet::Iterator port_iter(disabled_lib_ports_);
   while (port_iter.hasNext()) {
     LibertyPort *port = port_iter.next();
-    port->setIsDisabledConstraint(false);
+    port->setIsDisabledConstraint(disabled);
+  }
+}
+
+bool
+Sdc::hasLibertyDisables() const
+{
+  return !disabled_cell_ports_.empty()
+    || !disabled_lib_ports_.empty();
+}
+
+void
+Sdc::delayConstraintPins(PinSet &pins) const
+{
+  Instance *top_inst = network_->topInstance();
+  InstancePinIterator *pin_iter = network_->pinIterator(top_inst);
+  while (pin_iter->hasNext())
+    pins.insert(pin_iter->next());
+  delete pin_iter;
+
+  NetSet nets;
+  if (net_wire_cap_map_) {
+    for (int i = 0; i < corners_->count(); i++) {
+      for (auto net_cap : net_wire_cap_map_[i])
+	nets.insert(net_cap.first);
+    }
+  }
+  for (auto net_res : net_res_map_)
+    nets.insert(net_res.first);
+  for (Net *net : nets) {
+    NetConnectedPinIterator *pin_iter = network_->connectedPinIterator(net);
+    while (pin_iter->hasNext()) {
+      Pin *pin = pin_iter->next();
+      if (!network_->isHierarchical(pin))
+	pins.insert(pin);
+    }
+    delete pin_iter;
+  }
+
+  for (auto mm_index : MinMax::rangeIndex()) {
+    InstancePvtMap *pvt_map = instance_pvt_maps_[mm_index];
+    if (pvt_map) {
+      for (auto inst_pvt : *pvt_map) {
+	InstancePinIterator *pin_iter = network_->pinIterator(inst_pvt.first);
+	while (pin_iter->hasNext())
+	  pins.insert(pin_iter->next());
+	delete pin_iter;
+      }
+    }
   }
 }
 
@@ -3060,6 +3121,18 @@ Sdc::hasPortExtCap(Port *port) const
     return false;
 }
 
+void
+Sdc::removePortExtCap(Port *port)
+{
+  if (port_cap_map_) {
+    PortExtCap *port_cap = port_cap_map_->findKey(port);
+    if (port_cap) {
+      port_cap_map_->erase(port);
+      delete port_cap;
+    }
+  }
+}
+
 void
 Sdc::portExtCap(Port *port,
 		const RiseFall *rf,
@@ -14,7 +14,10 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
+
 #include "Stats.hh"
+#include "DispatchQueue.hh"
 #include "PortDirection.hh"
 #include "Network.hh"
 #include "Graph.hh"
@@ -46,6 +49,35 @@ Sdc::annotateGraph()
   stats.report("Annotate constraints to graph");
 }
 
+// Call visit for each graph vertex on the thread pool.
+// visit may only change the vertex and its out edges.
+void
+Sdc::visitGraphVertices(const std::function<void (Vertex *vertex)> &visit)
+{
+  if (thread_count_ <= 1) {
+    VertexIterator vertex_iter(graph_);
+    while (vertex_iter.hasNext())
+      visit(vertex_iter.next());
+  }
+  else {
+    VertexSeq vertices;
+    vertices.reserve(graph_->vertexCount());
+    VertexIterator vertex_iter(graph_);
+    while (vertex_iter.hasNext())
+      vertices.push_back(vertex_iter.next());
+    size_t vertex_count = vertices.size();
+    size_t chunk_size = (vertex_count + thread_count_ - 1) / thread_count_;
+    for (size_t start = 0; start < vertex_count; start += chunk_size) {
+      size_t end = std::min(start + chunk_size, vertex_count);
+      dispatch_queue_->dispatch([&vertices, &visit, start, end](int) {
+	for (size_t i = start; i < end; i++)
+	  visit(vertices[i]);
+      });
+    }
+    dispatch_queue_->finishTasks();
+  }
+}
+
 void
 Sdc::annotateGraphConstrainOutputs()
 {
@@ -69,14 +101,13 @@ Sdc::annotateDisables()
   }
 
   if (!disabled_lib_ports_.empty()) {
-    VertexIterator vertex_iter(graph_);
-    while (vertex_iter.hasNext()) {
-      Vertex *vertex = vertex_iter.next();
-      Pin *pin = vertex->pin();
-      LibertyPort *port = network_->libertyPort(pin);
+    // Bidirect driver vertices are visited separately, so only
+    // the visited vertex is annotated.
+    visitGraphVertices([this] (Vertex *vertex) {
+      LibertyPort *port = network_->libertyPort(vertex->pin());
       if (disabled_lib_ports_.hasKey(port))
-	annotateGraphDisabled(pin);
-    }
+	vertex->setIsDisabledConstraint(true);
+    });
   }
 
   Instance *top_inst = network_->topInstance();
@@ -252,6 +283,48 @@ Sdc::setEdgeDisabledInstFrom(Pin *from_pin,
   }
 }
 
+void
+Sdc::annotateGraphDisable(const Pin *pin)
+{
+  if (network_->isHierarchical(pin)) {
+    DisableHpinEdgeVisitor visitor(graph_);
+    visitDrvrLoadsThruHierPin(pin, network_, &visitor);
+  }
+  else
+    annotateGraphDisabled(pin);
+}
+
+void
+Sdc::annotateGraphDisable(Instance *inst)
+{
+  DisabledInstancePorts *disabled_inst = disabled_inst_ports_.findKey(inst);
+  if (disabled_inst)
+    setEdgeDisabledInstPorts(disabled_inst);
+}
+
+void
+Sdc::annotateGraphDisable(LibertyPort *port)
+{
+  visitGraphVertices([this, port] (Vertex *vertex) {
+    if (network_->libertyPort(vertex->pin()) == port)
+      vertex->setIsDisabledConstraint(true);
+  });
+}
+
+void
+Sdc::annotateGraphOutputDelay(Pin *pin)
+{
+  PinSet leaf_pins;
+  findLeafDriverPins(pin, network_, &leaf_pins);
+  annotateGraphConstrained(&leaf_pins);
+}
+
+void
+Sdc::annotateGraphDataCheck(const Pin *to)
+{
+  annotateGraphConstrained(to);
+}
+
 void
 Sdc::annotateGraphOutputDelays()
 {
@@ -372,9 +445,7 @@ Sdc::clockLatency(Edge *edge,
 void
 Sdc::removeGraphAnnotations()
 {
-  VertexIterator vertex_iter(graph_);
-  while (vertex_iter.hasNext()) {
-    Vertex *vertex = vertex_iter.next();
+  visitGraphVertices([this] (Vertex *vertex) {
     vertex->setIsDisabledConstraint(false);
     vertex->setIsConstrained(false);
 
@@ -383,7 +454,7 @@ Sdc::removeGraphAnnotations()
       Edge *edge = edge_iter.next();
       edge->setIsDisabledConstraint(false);
     }
-  }
+  });
   edge_clk_latency_.clear();
 }
 
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <climits>
+#include <functional>
+
 #include "DisallowCopyAssign.hh"
 #include "Zlib.hh"
 #include "Vector.hh"
@@ -41,8 +45,13 @@ namespace sta {
 class Report;
 class SdfTriple;
 class SdfPortSpec;
+class SdfCell;
+class SdfAnnotation;
+class SdfReader;
 
 typedef Vector<SdfTriple*> SdfTripleSeq;
+typedef Vector<SdfCell*> SdfCellSeq;
+typedef std::function<void (SdfReader *reader)> SdfEntryFunc;
 
 class SdfReader : public StaState
 {
@@ -162,6 +171,31 @@ public:
 
 private:
   DISALLOW_COPY_AND_ASSIGN(SdfReader);
+  // Annotator used by a thread to annotate the cells read by reader.
+  explicit SdfReader(SdfReader *reader);
+  void makeAnnotators();
+  void deleteAnnotators();
+  void deferEntry(SdfEntryFunc entry);
+  void annotateDeferredCell();
+  void annotateCell(SdfCell *cell);
+  void discardCell(SdfCell *cell);
+  void finishDeferredCells();
+  void deleteDeferredCells();
+  void annotateError(int line);
+  void applyAnnotations(SdfCell *cell);
+  void annotateArcDelay(Edge *edge,
+			TimingArc *arc,
+			int arc_delay_index,
+			float value,
+			bool in_incremental,
+			const MinMax *cond_use_min_max);
+  void annotateWidthCheck(const Pin *pin,
+			  const RiseFall *rf,
+			  int arc_delay_index,
+			  float value);
+  void annotatePeriodCheck(const Pin *pin,
+			   int arc_delay_index,
+			   float value);
   int readSdfFile1(Network *network,
 		   Graph *graph,
 		   const char *filename);
@@ -219,7 +253,29 @@ private:
   bool in_incremental_;
   float timescale_;
 
+  // With multiple threads the statements of each CELL are saved while
+  // parsing and matched to graph edges by the annotators in parallel
+  // with the parser. The annotators only read the graph; the delays and
+  // checks they find are saved with the cell and set by the reader in
+  // file order, so later entries for an edge replace earlier ones.
+  SdfReader *reader_;
+  std::vector<SdfReader*> annotators_;
+  // CELL being read.
+  SdfCell *defer_cell_;
+  // Cells dispatched to the annotators in file order.
+  SdfCellSeq deferred_cells_;
+  // Cell being annotated by an annotator.
+  SdfCell *annotate_cell_;
+  // Entries are run only to delete their arguments.
+  bool discard_;
+  // First line with an error found by the annotators. Statements at or
+  // after it are discarded by the annotators that have not run them yet.
+  std::atomic<int> error_line_;
+  int cell_count_;
+
   static const int null_index_ = -1;
+  static const int error_line_none_ = INT_MAX;
+  static const size_t deferred_cell_max_ = 4096;
 };
 
 extern SdfReader *sdf_reader;
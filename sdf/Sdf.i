@@ -69,7 +69,7 @@ read_sdf_file_single(const char *filename,
   bool success = readSdfSingle(filename, path, corner, sdf_index,
 			       analysis_type, unescaped_dividers,
 			       incremental_only, cond_use, sta);
-  sta->search()->arrivalsInvalid();
+  sta->arrivalsInvalid();
   return success;
 }
 
@@ -95,7 +95,7 @@ read_sdf_file_min_max(const char *filename,
 			       sdf_max_index, analysis_type,
 			       unescaped_dividers, incremental_only,
 			       cond_use, sta);
-  sta->search()->arrivalsInvalid();
+  sta->arrivalsInvalid();
   return success;
 }
 
@@ -22,6 +22,9 @@
 #include "DisallowCopyAssign.hh"
 #include "Error.hh"
 #include "Report.hh"
+#include "Debug.hh"
+#include "Machine.hh"
+#include "DispatchQueue.hh"
 #include "MinMax.hh"
 #include "TimingArc.hh"
 #include "Network.hh"
@@ -76,6 +79,121 @@ private:
   const char *cond_;   // timing checks only
 };
 
+class SdfCellEntry
+{
+public:
+  SdfCellEntry(int line,
+	       bool in_incremental,
+	       SdfEntryFunc func) :
+    line_(line), in_incremental_(in_incremental), func_(func) {}
+  int line() const { return line_; }
+  bool inIncremental() const { return in_incremental_; }
+  const SdfEntryFunc &func() const { return func_; }
+
+private:
+  int line_;
+  bool in_incremental_;
+  SdfEntryFunc func_;
+};
+
+class SdfMsg
+{
+public:
+  SdfMsg(int id,
+	 int line,
+	 bool is_error,
+	 string msg) :
+    id_(id), line_(line), is_error_(is_error), msg_(msg) {}
+  int id() const { return id_; }
+  int line() const { return line_; }
+  bool isError() const { return is_error_; }
+  const char *msg() const { return msg_.c_str(); }
+
+private:
+  int id_;
+  int line_;
+  bool is_error_;
+  string msg_;
+};
+
+enum class SdfAnnotationType { arc_delay, width_check, period_check };
+
+// Graph annotation found by an annotator, set by the reader in file order.
+class SdfAnnotation
+{
+public:
+  SdfAnnotation(SdfAnnotationType type,
+		Edge *edge,
+		TimingArc *arc,
+		const Pin *pin,
+		const RiseFall *rf,
+		int arc_delay_index,
+		float value,
+		bool in_incremental,
+		const MinMax *cond_use_min_max) :
+    type_(type), edge_(edge), arc_(arc), pin_(pin), rf_(rf),
+    arc_delay_index_(arc_delay_index), value_(value),
+    in_incremental_(in_incremental), cond_use_min_max_(cond_use_min_max) {}
+  SdfAnnotationType type() const { return type_; }
+  Edge *edge() const { return edge_; }
+  TimingArc *arc() const { return arc_; }
+  const Pin *pin() const { return pin_; }
+  const RiseFall *rf() const { return rf_; }
+  int arcDelayIndex() const { return arc_delay_index_; }
+  float value() const { return value_; }
+  bool inIncremental() const { return in_incremental_; }
+  const MinMax *condUseMinMax() const { return cond_use_min_max_; }
+
+private:
+  SdfAnnotationType type_;
+  Edge *edge_;
+  TimingArc *arc_;
+  const Pin *pin_;
+  const RiseFall *rf_;
+  int arc_delay_index_;
+  float value_;
+  bool in_incremental_;
+  const MinMax *cond_use_min_max_;
+};
+
+// Statements of a CELL saved by the parser to be annotated by a thread.
+class SdfCell
+{
+public:
+  SdfCell(const char *cell_name,
+	  int line);
+  ~SdfCell();
+  const char *cellName() const { return cell_name_; }
+  int line() const { return line_; }
+  const char *instanceName() const { return instance_name_; }
+  void setInstanceName(const char *instance_name);
+  void addEntry(int line,
+		bool in_incremental,
+		SdfEntryFunc func);
+  const std::vector<SdfCellEntry> &entries() const { return entries_; }
+  void clearEntries();
+  void addAnnotation(const SdfAnnotation &annotation);
+  const std::vector<SdfAnnotation> &annotations() const { return annotations_; }
+  void addMsg(int id,
+	      int line,
+	      bool is_error,
+	      const char *fmt,
+	      va_list args);
+  const std::vector<SdfMsg> &msgs() const { return msgs_; }
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SdfCell);
+
+  const char *cell_name_;
+  int line_;
+  const char *instance_name_;
+  std::vector<SdfCellEntry> entries_;
+  std::vector<SdfAnnotation> annotations_;
+  // Warnings and errors found by the annotator, reported in file order
+  // by the reader.
+  std::vector<SdfMsg> msgs_;
+};
+
 SdfReader *sdf_reader = nullptr;
 
 bool
@@ -149,15 +267,52 @@ SdfReader::SdfReader(const char *filename,
   cell_name_(nullptr),
   in_timing_check_(false),
   in_incremental_(false),
-  timescale_(1.0E-9F)		// default units of ns
+  timescale_(1.0E-9F),		// default units of ns
+  reader_(nullptr),
+  defer_cell_(nullptr),
+  annotate_cell_(nullptr),
+  discard_(false),
+  error_line_(error_line_none_),
+  cell_count_(0)
 {
   if (unescaped_dividers)
     network_ = makeSdcNetwork(network_);
 }
 
+SdfReader::SdfReader(SdfReader *reader) :
+  StaState(reader),
+  filename_(reader->filename_),
+  path_(reader->path_),
+  triple_min_index_(reader->triple_min_index_),
+  triple_max_index_(reader->triple_max_index_),
+  arc_delay_min_index_(reader->arc_delay_min_index_),
+  arc_delay_max_index_(reader->arc_delay_max_index_),
+  analysis_type_(reader->analysis_type_),
+  unescaped_dividers_(reader->unescaped_dividers_),
+  is_incremental_only_(reader->is_incremental_only_),
+  cond_use_(reader->cond_use_),
+  line_(1),
+  stream_(nullptr),
+  divider_(reader->divider_),
+  escape_(reader->escape_),
+  instance_(nullptr),
+  cell_name_(nullptr),
+  in_timing_check_(false),
+  in_incremental_(false),
+  timescale_(reader->timescale_),
+  reader_(reader),
+  defer_cell_(nullptr),
+  annotate_cell_(nullptr),
+  discard_(false),
+  error_line_(error_line_none_),
+  cell_count_(0)
+{
+}
+
 SdfReader::~SdfReader()
 {
-  if (unescaped_dividers_)
+  // Annotators share the reader network.
+  if (unescaped_dividers_ && reader_ == nullptr)
     delete network_;
 }
 
@@ -167,15 +322,182 @@ SdfReader::read()
   // Use zlib to uncompress gzip'd files automagically.
   stream_ = gzopen(filename_, "rb");
   if (stream_) {
-    // yyparse returns 0 on success.
-    bool success = (::SdfParse_parse() == 0);
+    double begin = elapsedRunTime();
+    makeAnnotators();
+    bool success;
+    try {
+      // yyparse returns 0 on success.
+      success = (::SdfParse_parse() == 0);
+      finishDeferredCells();
+    }
+    catch (...) {
+      gzclose(stream_);
+      // Annotate the cells read before the error like the single
+      // threaded reader. An error in one of them is reported instead.
+      try {
+	if (defer_cell_) {
+	  SdfCell *cell = defer_cell_;
+	  defer_cell_ = nullptr;
+	  deferred_cells_.push_back(cell);
+	  dispatch_queue_->finishTasks();
+	  annotators_[0]->annotateCell(cell);
+	}
+	finishDeferredCells();
+      }
+      catch (...) {
+	deleteAnnotators();
+	throw;
+      }
+      deleteAnnotators();
+      throw;
+    }
     gzclose(stream_);
+    deleteAnnotators();
+    double elapsed = elapsedRunTime() - begin;
+    debugPrint(debug_, "sdf", 1, "%d cells in %.2f seconds, %.0f cells/second",
+	       cell_count_,
+	       elapsed,
+	       (elapsed > 0.0) ? cell_count_ / elapsed : 0.0);
     return success;
   }
   else
     throw FileNotReadable(filename_);
 }
 
+void
+SdfReader::makeAnnotators()
+{
+  if (thread_count_ > 1 && dispatch_queue_) {
+    for (int i = 0; i < thread_count_; i++)
+      annotators_.push_back(new SdfReader(this));
+  }
+}
+
+void
+SdfReader::deleteAnnotators()
+{
+  for (SdfReader *annotator : annotators_)
+    delete annotator;
+  annotators_.clear();
+}
+
+////////////////////////////////////////////////////////////////
+
+void
+SdfReader::deferEntry(SdfEntryFunc entry)
+{
+  defer_cell_->addEntry(line_, in_incremental_, entry);
+}
+
+void
+SdfReader::annotateDeferredCell()
+{
+  SdfCell *cell = defer_cell_;
+  defer_cell_ = nullptr;
+  deferred_cells_.push_back(cell);
+  dispatch_queue_->dispatch([this, cell](int i) {
+      annotators_[i]->annotateCell(cell);
+    });
+  // Bound the memory used by saved cells and stop reading at the
+  // first error.
+  if (deferred_cells_.size() >= deferred_cell_max_
+      || error_line_ != error_line_none_)
+    finishDeferredCells();
+}
+
+void
+SdfReader::annotateCell(SdfCell *cell)
+{
+  annotate_cell_ = cell;
+  // The reader divider is set by the header before any cells.
+  divider_ = reader_->divider_;
+  line_ = cell->line();
+  setCell(stringCopy(cell->cellName()));
+  setInstance(cell->instanceName() ? stringCopy(cell->instanceName()) : nullptr);
+  for (const SdfCellEntry &entry : cell->entries()) {
+    line_ = entry.line();
+    in_incremental_ = entry.inIncremental();
+    // The single threaded reader stops at the first error, so statements
+    // after it are not annotated. Annotations found by statements after
+    // it that another annotator has already run are not set by the reader.
+    if (!discard_ && line_ >= reader_->error_line_) {
+      discard_ = true;
+      instance_ = nullptr;
+    }
+    entry.func()(this);
+  }
+  cell->clearEntries();
+  cellFinish();
+  discard_ = false;
+  in_incremental_ = false;
+  annotate_cell_ = nullptr;
+}
+
+// Run the entries of a cell that is not annotated to delete their
+// arguments.
+void
+SdfReader::discardCell(SdfCell *cell)
+{
+  discard_ = true;
+  // Without an instance only INTERCONNECT and PORT look at discard_.
+  instance_ = nullptr;
+  for (const SdfCellEntry &entry : cell->entries())
+    entry.func()(this);
+  cell->clearEntries();
+  discard_ = false;
+}
+
+// Record the error line if it is the first one in the file.
+void
+SdfReader::annotateError(int line)
+{
+  int error_line = error_line_;
+  while (line < error_line
+	 && !error_line_.compare_exchange_weak(error_line, line)) {
+  }
+}
+
+// Wait for the annotators, then report their warnings/errors and set
+// the annotations they found in file order up to the first error.
+void
+SdfReader::finishDeferredCells()
+{
+  if (!deferred_cells_.empty()) {
+    dispatch_queue_->finishTasks();
+    const SdfMsg *error = nullptr;
+    for (SdfCell *cell : deferred_cells_) {
+      for (const SdfMsg &msg : cell->msgs()) {
+	if (msg.isError()) {
+	  error = &msg;
+	  break;
+	}
+	report_->fileWarn(msg.id(), filename_, msg.line(), "%s", msg.msg());
+      }
+      // Annotations of the cell with the error were found before it.
+      applyAnnotations(cell);
+      if (error)
+	break;
+    }
+    if (error) {
+      int id = error->id();
+      int line = error->line();
+      string msg = error->msg();
+      deleteDeferredCells();
+      report_->fileError(id, filename_, line, "%s", msg.c_str());
+    }
+    deferred_cells_.deleteContentsClear();
+  }
+}
+
+// Delete the deferred cells, including entries that were not annotated.
+void
+SdfReader::deleteDeferredCells()
+{
+  for (SdfCell *cell : deferred_cells_)
+    annotators_[0]->discardCell(cell);
+  deferred_cells_.deleteContentsClear();
+}
+
 void
 SdfReader::setDivider(char divider)
 {
@@ -208,8 +530,15 @@ SdfReader::interconnect(const char *from_pin_name,
 			const char *to_pin_name,
 			SdfTripleSeq *triples)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->interconnect(from_pin_name, to_pin_name, triples);
+      });
+    return;
+  }
   // Ignore non-incremental annotations in incremental only mode.
-  if (!(is_incremental_only_ && !in_incremental_)) {
+  if (!discard_
+      && !(is_incremental_only_ && !in_incremental_)) {
     Pin *from_pin = findPin(from_pin_name);
     Pin *to_pin = findPin(to_pin_name);
     if (from_pin && to_pin) {
@@ -247,8 +576,15 @@ void
 SdfReader::port(const char *to_pin_name,
 		SdfTripleSeq *triples)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->port(to_pin_name, triples);
+      });
+    return;
+  }
   // Ignore non-incremental annotations in incremental only mode.
-  if (!(is_incremental_only_ && !in_incremental_)) {
+  if (!discard_
+      && !(is_incremental_only_ && !in_incremental_)) {
     Pin *to_pin = (instance_)
       ? network_->findPinRelative(instance_, to_pin_name)
       : network_->findPin(to_pin_name);
@@ -317,13 +653,22 @@ SdfReader::setEdgeDelays(Edge *edge,
 void
 SdfReader::setCell(const char *cell_name)
 {
-  cell_name_ = cell_name;
+  if (reader_ == nullptr)
+    cell_count_++;
+  if (!annotators_.empty())
+    defer_cell_ = new SdfCell(cell_name, line_);
+  else
+    cell_name_ = cell_name;
 }
 
 void
 SdfReader::setInstance(const char *instance_name)
 {
-  if (instance_name) {
+  if (defer_cell_
+      && !(instance_name && stringEq(instance_name, "*")))
+    // Find the instance in the annotator thread.
+    defer_cell_->setInstanceName(instance_name);
+  else if (instance_name) {
     if (stringEq(instance_name, "*")) {
       notSupported("INSTANCE wildcards");
       instance_ = nullptr;
@@ -356,6 +701,8 @@ SdfReader::setInstanceWildcard()
 void
 SdfReader::cellFinish()
 {
+  if (defer_cell_)
+    annotateDeferredCell();
   stringDelete(cell_name_);
   cell_name_ = nullptr;
   instance_ = nullptr;
@@ -368,6 +715,12 @@ SdfReader::iopath(SdfPortSpec *from_edge,
 		  const char *cond,
 		  bool condelse)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->iopath(from_edge, to_port_name, triples, cond, condelse);
+      });
+    return;
+  }
   if (instance_) {
     const char *from_port_name = from_edge->port();
     Cell *cell = network_->cell(instance_);
@@ -446,6 +799,12 @@ void
 SdfReader::timingCheck(TimingRole *role, SdfPortSpec *data_edge,
 		       SdfPortSpec *clk_edge, SdfTriple *triple)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->timingCheck(role, data_edge, clk_edge, triple);
+      });
+    return;
+  }
   timingCheck1(role, data_edge, clk_edge, triple, true);
   deletePortSpec(data_edge);
   deletePortSpec(clk_edge);
@@ -571,6 +930,12 @@ void
 SdfReader::timingCheckWidth(SdfPortSpec *edge,
 			    SdfTriple *triple)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->timingCheckWidth(edge, triple);
+      });
+    return;
+  }
   // Ignore non-incremental annotations in incremental only mode.
   if (!(is_incremental_only_ && !in_incremental_)
       && instance_) {
@@ -585,18 +950,12 @@ SdfReader::timingCheckWidth(SdfPortSpec *edge,
 	const RiseFall *rf = edge->transition()->asRiseFall();
 	float **values = triple->values();
 	float *value_ptr = values[triple_min_index_];
-	if (value_ptr) {
-	  float value = *value_ptr;
-	  graph_->setWidthCheckAnnotation(pin, rf, arc_delay_min_index_,
-					  value);
-	}
+	if (value_ptr)
+	  annotateWidthCheck(pin, rf, arc_delay_min_index_, *value_ptr);
 	if (triple_max_index_ != null_index_) {
 	  value_ptr = values[triple_max_index_];
-	  if (value_ptr) {
-	    float value = *value_ptr;
-	    graph_->setWidthCheckAnnotation(pin, rf, arc_delay_max_index_,
-					    value);
-	  }
+	  if (value_ptr)
+	    annotateWidthCheck(pin, rf, arc_delay_max_index_, *value_ptr);
 	}
       }
     }
@@ -609,6 +968,12 @@ void
 SdfReader::timingCheckPeriod(SdfPortSpec *edge,
 			     SdfTriple *triple)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->timingCheckPeriod(edge, triple);
+      });
+    return;
+  }
   // Ignore non-incremental annotations in incremental only mode.
   if (!(is_incremental_only_ && !in_incremental_)
       && instance_) {
@@ -623,16 +988,12 @@ SdfReader::timingCheckPeriod(SdfPortSpec *edge,
       if (pin) {
 	float **values = triple->values();
 	float *value_ptr = values[triple_min_index_];
-	if (value_ptr) {
-	  float value = *value_ptr;
-	  graph_->setPeriodCheckAnnotation(pin, arc_delay_min_index_, value);
-	}
+	if (value_ptr)
+	  annotatePeriodCheck(pin, arc_delay_min_index_, *value_ptr);
 	if (triple_max_index_ != null_index_) {
 	  value_ptr = values[triple_max_index_];
-	  if (value_ptr) {
-	    float value = *value_ptr;
-	    graph_->setPeriodCheckAnnotation(pin, arc_delay_max_index_, value);
-	  }
+	  if (value_ptr)
+	    annotatePeriodCheck(pin, arc_delay_max_index_, *value_ptr);
 	}
       }
     }
@@ -647,6 +1008,13 @@ SdfReader::timingCheckSetupHold(SdfPortSpec *data_edge,
 				SdfTriple *setup_triple,
 				SdfTriple *hold_triple)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->timingCheckSetupHold(data_edge, clk_edge, setup_triple,
+				     hold_triple);
+      });
+    return;
+  }
   timingCheck1(TimingRole::setup(), data_edge, clk_edge, setup_triple, true);
   timingCheck1(TimingRole::hold(), data_edge, clk_edge, hold_triple, false);
   deletePortSpec(data_edge);
@@ -661,6 +1029,12 @@ SdfReader::timingCheckRecRem(SdfPortSpec *data_edge,
 			     SdfTriple *rec_triple,
 			     SdfTriple *rem_triple)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->timingCheckRecRem(data_edge, clk_edge, rec_triple, rem_triple);
+      });
+    return;
+  }
   timingCheck1(TimingRole::recovery(), data_edge, clk_edge, rec_triple, true);
   timingCheck1(TimingRole::removal(), data_edge, clk_edge, rem_triple, false);
   deletePortSpec(data_edge);
@@ -685,6 +1059,12 @@ SdfReader::timingCheckNochange(SdfPortSpec *data_edge,
 void
 SdfReader::device(SdfTripleSeq *triples)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->device(triples);
+      });
+    return;
+  }
   // Ignore non-incremental annotations in incremental only mode.
   if (!(is_incremental_only_ && !in_incremental_)
       && instance_) {
@@ -702,6 +1082,12 @@ void
 SdfReader::device(const char *to_port_name,
 		  SdfTripleSeq *triples)
 {
+  if (defer_cell_) {
+    deferEntry([=](SdfReader *reader) {
+	reader->device(to_port_name, triples);
+      });
+    return;
+  }
   // Ignore non-incremental annotations in incremental only mode.
   if (!(is_incremental_only_ && !in_incremental_)
       && instance_) {
@@ -750,16 +1136,9 @@ SdfReader::setEdgeArcDelays(Edge *edge,
   if (triple_index != null_index_) {
     float **values = triple->values();
     float *value_ptr = values[triple_index];
-    if (value_ptr) {
-      ArcDelay delay;
-      if (in_incremental_)
-	delay = *value_ptr + graph_->arcDelay(edge, arc, arc_delay_index);
-      else
-	delay = *value_ptr;
-      graph_->setArcDelay(edge, arc, arc_delay_index, delay);
-      graph_->setArcDelayAnnotated(edge, arc, arc_delay_index, true);
-      edge->setDelayAnnotationIsIncremental(is_incremental_only_);
-    }
+    if (value_ptr)
+      annotateArcDelay(edge, arc, arc_delay_index, *value_ptr,
+		       in_incremental_, nullptr);
   }
 }
 
@@ -803,13 +1182,41 @@ SdfReader::setEdgeArcDelaysCondUse(Edge *edge,
 				   const MinMax *min_max)
 {
   if (value
-      && triple_index != null_index_) {
-    ArcDelay delay(*value);
-    if (!is_incremental_only_ && in_incremental_)
-      delay = graph_->arcDelay(edge, arc, arc_delay_index) + *value;
+      && triple_index != null_index_)
+    annotateArcDelay(edge, arc, arc_delay_index, *value,
+		     in_incremental_, min_max);
+}
+
+// Annotators save the annotation with the cell for the reader to set.
+void
+SdfReader::annotateArcDelay(Edge *edge,
+			    TimingArc *arc,
+			    int arc_delay_index,
+			    float value,
+			    bool in_incremental,
+			    // Keep the previous annotation if it is worse.
+			    const MinMax *cond_use_min_max)
+{
+  if (annotate_cell_) {
+    if (!discard_)
+      annotate_cell_->addAnnotation(SdfAnnotation(SdfAnnotationType::arc_delay,
+						  edge, arc,
+						  nullptr, nullptr,
+						  arc_delay_index, value,
+						  in_incremental,
+						  cond_use_min_max));
+  }
+  else {
+    ArcDelay delay(value);
+    if (cond_use_min_max == nullptr) {
+      if (in_incremental)
+	delay = value + graph_->arcDelay(edge, arc, arc_delay_index);
+    }
+    else if (!is_incremental_only_ && in_incremental)
+      delay = graph_->arcDelay(edge, arc, arc_delay_index) + value;
     else if (graph_->arcDelayAnnotated(edge, arc, arc_delay_index)) {
       ArcDelay prev_value = graph_->arcDelay(edge, arc, arc_delay_index);
-      if (delayGreater(prev_value, delay, min_max, this))
+      if (delayGreater(prev_value, delay, cond_use_min_max, this))
 	delay = prev_value;
     }
     graph_->setArcDelay(edge, arc, arc_delay_index, delay);
@@ -818,6 +1225,62 @@ SdfReader::setEdgeArcDelaysCondUse(Edge *edge,
   }
 }
 
+void
+SdfReader::annotateWidthCheck(const Pin *pin,
+			      const RiseFall *rf,
+			      int arc_delay_index,
+			      float value)
+{
+  if (annotate_cell_) {
+    if (!discard_)
+      annotate_cell_->addAnnotation(SdfAnnotation(SdfAnnotationType::width_check,
+						  nullptr, nullptr,
+						  pin, rf, arc_delay_index,
+						  value, false, nullptr));
+  }
+  else
+    graph_->setWidthCheckAnnotation(pin, rf, arc_delay_index, value);
+}
+
+void
+SdfReader::annotatePeriodCheck(const Pin *pin,
+			       int arc_delay_index,
+			       float value)
+{
+  if (annotate_cell_) {
+    if (!discard_)
+      annotate_cell_->addAnnotation(SdfAnnotation(SdfAnnotationType::period_check,
+						  nullptr, nullptr,
+						  pin, nullptr, arc_delay_index,
+						  value, false, nullptr));
+  }
+  else
+    graph_->setPeriodCheckAnnotation(pin, arc_delay_index, value);
+}
+
+// Set the annotations found by an annotator for a cell.
+void
+SdfReader::applyAnnotations(SdfCell *cell)
+{
+  for (const SdfAnnotation &annotation : cell->annotations()) {
+    switch (annotation.type()) {
+    case SdfAnnotationType::arc_delay:
+      annotateArcDelay(annotation.edge(), annotation.arc(),
+		       annotation.arcDelayIndex(), annotation.value(),
+		       annotation.inIncremental(), annotation.condUseMinMax());
+      break;
+    case SdfAnnotationType::width_check:
+      annotateWidthCheck(annotation.pin(), annotation.rf(),
+			 annotation.arcDelayIndex(), annotation.value());
+      break;
+    case SdfAnnotationType::period_check:
+      annotatePeriodCheck(annotation.pin(), annotation.arcDelayIndex(),
+			  annotation.value());
+      break;
+    }
+  }
+}
+
 bool
 SdfReader::condMatch(const char *sdf_cond,
 		     const char *lib_cond)
@@ -1038,7 +1501,10 @@ SdfReader::sdfWarn(int id,
 {
   va_list args;
   va_start(args, fmt);
-  report_->vfileWarn(id, filename_, line_, fmt, args);
+  if (annotate_cell_)
+    annotate_cell_->addMsg(id, line_, false, fmt, args);
+  else
+    report_->vfileWarn(id, filename_, line_, fmt, args);
   va_end(args);
 }
 
@@ -1048,7 +1514,15 @@ SdfReader::sdfError(int id,
 {
   va_list args;
   va_start(args, fmt);
-  report_->vfileError(id, filename_, line_, fmt, args);
+  if (annotate_cell_) {
+    // Reported by the reader after the annotators finish.
+    annotate_cell_->addMsg(id, line_, true, fmt, args);
+    reader_->annotateError(line_);
+    // Keep the annotations found before the error like the reader does.
+    discard_ = true;
+  }
+  else
+    report_->vfileError(id, filename_, line_, fmt, args);
   va_end(args);
 }
 
@@ -1079,6 +1553,61 @@ SdfReader::findInstance(const char *name)
 
 ////////////////////////////////////////////////////////////////
 
+SdfCell::SdfCell(const char *cell_name,
+		 int line) :
+  cell_name_(cell_name),
+  line_(line),
+  instance_name_(nullptr)
+{
+}
+
+SdfCell::~SdfCell()
+{
+  stringDelete(cell_name_);
+  stringDelete(instance_name_);
+}
+
+void
+SdfCell::setInstanceName(const char *instance_name)
+{
+  instance_name_ = instance_name;
+}
+
+void
+SdfCell::addEntry(int line,
+		  bool in_incremental,
+		  SdfEntryFunc func)
+{
+  entries_.push_back(SdfCellEntry(line, in_incremental, func));
+}
+
+void
+SdfCell::addAnnotation(const SdfAnnotation &annotation)
+{
+  annotations_.push_back(annotation);
+}
+
+void
+SdfCell::clearEntries()
+{
+  entries_.clear();
+  entries_.shrink_to_fit();
+}
+
+void
+SdfCell::addMsg(int id,
+		int line,
+		bool is_error,
+		const char *fmt,
+		va_list args)
+{
+  char *msg = stringPrintArgs(fmt, args);
+  msgs_.push_back(SdfMsg(id, line, is_error, msg));
+  stringDelete(msg);
+}
+
+////////////////////////////////////////////////////////////////
+
 SdfTriple::SdfTriple(float *min,
 		     float *typ,
 		     float *max)
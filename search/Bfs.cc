@@ -116,6 +116,20 @@ BfsIterator::empty() const
   return levelLess(last_level_, first_level_);
 }
 
+int
+BfsIterator::queueCount() const
+{
+  int count = 0;
+  for (const VertexSeq &level_vertices : queue_) {
+    for (Vertex *vertex : level_vertices) {
+      // Removed vertices are nulled.
+      if (vertex)
+	count++;
+    }
+  }
+  return count;
+}
+
 void
 BfsIterator::enqueueAdjacentVertices(Vertex *vertex)
 {
@@ -196,6 +210,74 @@ BfsIterator::visitParallel(Level to_level,
   return visit_count;
 }
 
+int
+BfsIterator::visitParallel(Level to_level,
+			   VertexVisitorSeq &visitors)
+{
+  int visit_count = 0;
+  if (!empty()) {
+    if (thread_count_ <= 1) {
+      while (levelLessOrEqual(first_level_, last_level_)
+	     && levelLessOrEqual(first_level_, to_level)) {
+	VertexSeq &level_vertices = queue_[first_level_];
+	incrLevel(first_level_);
+	if (!level_vertices.empty()) {
+	  for (auto vertex : level_vertices) {
+	    if (vertex) {
+	      vertex->setBfsInQueue(bfs_index_, false);
+	      if (visitors[0]->splitVisit(vertex)) {
+		for (VertexVisitor *visitor : visitors)
+		  visitor->visit(vertex);
+	      }
+	      else
+		visitors[0]->visitUnsplit(vertex);
+	      visit_count++;
+	    }
+	  }
+	  level_vertices.clear();
+	  for (VertexVisitor *visitor : visitors)
+	    visitor->levelFinished();
+	}
+      }
+    }
+    else {
+      size_t visitor_count = visitors.size();
+      // Thread copies of each visitor indexed by [thread][visitor].
+      std::vector<VertexVisitorSeq> thread_visitors(thread_count_);
+      for (int i = 0; i < thread_count_; i++) {
+	for (VertexVisitor *visitor : visitors)
+	  thread_visitors[i].push_back(visitor->copy());
+      }
+      while (levelLessOrEqual(first_level_, last_level_)
+	     && levelLessOrEqual(first_level_, to_level)) {
+	VertexSeq &level_vertices = queue_[first_level_];
+	incrLevel(first_level_);
+	if (!level_vertices.empty()) {
+	  for (auto vertex : level_vertices) {
+	    if (vertex) {
+	      vertex->setBfsInQueue(bfs_index_, false);
+	      if (visitors[0]->splitVisit(vertex)) {
+		for (size_t v = 0; v < visitor_count; v++)
+		  dispatch_queue_->dispatch( [vertex, v, &thread_visitors](int i){ thread_visitors[i][v]->visit(vertex); } );
+	      }
+	      else
+		dispatch_queue_->dispatch( [vertex, &thread_visitors](int i){ thread_visitors[i][0]->visitUnsplit(vertex); } );
+	      visit_count++;
+	    }
+	  }
+	  dispatch_queue_->finishTasks();
+	  for (VertexVisitor *visitor : visitors)
+	    visitor->levelFinished();
+	  level_vertices.clear();
+	}
+      }
+      for (VertexVisitorSeq &visitors1 : thread_visitors)
+	visitors1.deleteContents();
+    }
+  }
+  return visit_count;
+}
+
 bool
 BfsIterator::hasNext()
 {
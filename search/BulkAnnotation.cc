@@ -0,0 +1,228 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "BulkAnnotation.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Zlib.hh"
+#include "Error.hh"
+#include "Report.hh"
+#include "Debug.hh"
+#include "TimingArc.hh"
+#include "Corner.hh"
+#include "Graph.hh"
+#include "GraphDelayCalc.hh"
+#include "Sta.hh"
+
+namespace sta {
+
+static_assert(sizeof(ArcDelayAnnotation) == 16,
+	      "ArcDelayAnnotation file record size");
+static_assert(sizeof(SlewAnnotation) == 16,
+	      "SlewAnnotation file record size");
+
+static const char bulk_annotation_magic[] = "STAANNO1";
+// Annotations per read/annotate call.
+static const size_t bulk_annotation_chunk = 1 << 16;
+
+class BulkAnnotationReader
+{
+public:
+  BulkAnnotationReader(const char *filename,
+		       Sta *sta);
+  void read();
+
+private:
+  void readHeader();
+  uint64_t readCount();
+  void readBytes(void *buffer,
+		 size_t size);
+  template <class ANNOTATION>
+  void readAnnotations(size_t (*annotate)(const ANNOTATION *annotations,
+					  size_t count,
+					  const StaState *sta),
+		       size_t &annotated_count);
+  void annotationsInvalid();
+
+  const char *filename_;
+  Sta *sta_;
+  gzFile stream_;
+  size_t delay_count_;
+  size_t slew_count_;
+};
+
+size_t
+annotateArcDelays(const ArcDelayAnnotation *delays,
+		  size_t count,
+		  const StaState *sta)
+{
+  Graph *graph = sta->graph();
+  DcalcAPIndex ap_count = sta->corners()->dcalcAnalysisPtCount();
+  size_t annotated_count = 0;
+  for (size_t i = 0; i < count; i++) {
+    const ArcDelayAnnotation &annotation = delays[i];
+    if (graph->isValidEdgeId(annotation.edge_id)
+	&& annotation.ap_index < static_cast<uint32_t>(ap_count)) {
+      Edge *edge = graph->edge(annotation.edge_id);
+      TimingArcSet *arc_set = edge->timingArcSet();
+      if (annotation.arc_index < arc_set->arcCount()) {
+	TimingArc *arc = arc_set->findTimingArc(annotation.arc_index);
+	DcalcAPIndex ap_index = annotation.ap_index;
+	graph->setArcDelay(edge, arc, ap_index, annotation.delay);
+	// Don't let delay calculation clobber the value.
+	graph->setArcDelayAnnotated(edge, arc, ap_index, true);
+	annotated_count++;
+      }
+    }
+  }
+  return annotated_count;
+}
+
+size_t
+annotateSlews(const SlewAnnotation *slews,
+	      size_t count,
+	      const StaState *sta)
+{
+  Graph *graph = sta->graph();
+  DcalcAPIndex ap_count = sta->corners()->dcalcAnalysisPtCount();
+  size_t annotated_count = 0;
+  for (size_t i = 0; i < count; i++) {
+    const SlewAnnotation &annotation = slews[i];
+    if (graph->isValidVertexId(annotation.vertex_id)
+	&& annotation.rf_index < RiseFall::index_count
+	&& annotation.ap_index < static_cast<uint32_t>(ap_count)) {
+      Vertex *vertex = graph->vertex(annotation.vertex_id);
+      const RiseFall *rf = RiseFall::find(annotation.rf_index);
+      DcalcAPIndex ap_index = annotation.ap_index;
+      graph->setSlew(vertex, rf, ap_index, annotation.slew);
+      // Don't let delay calculation clobber the value.
+      vertex->setSlewAnnotated(true, rf, ap_index);
+      annotated_count++;
+    }
+  }
+  return annotated_count;
+}
+
+////////////////////////////////////////////////////////////////
+
+void
+readBulkAnnotations(const char *filename,
+		    Sta *sta)
+{
+  BulkAnnotationReader reader(filename, sta);
+  reader.read();
+}
+
+BulkAnnotationReader::BulkAnnotationReader(const char *filename,
+					   Sta *sta) :
+  filename_(filename),
+  sta_(sta),
+  stream_(nullptr),
+  delay_count_(0),
+  slew_count_(0)
+{
+}
+
+void
+BulkAnnotationReader::read()
+{
+  // Use zlib to uncompress gzip'd files automagically.
+  stream_ = gzopen(filename_, "rb");
+  if (stream_ == nullptr)
+    throw FileNotReadable(filename_);
+  try {
+    readHeader();
+    readAnnotations(&annotateArcDelays, delay_count_);
+    readAnnotations(&annotateSlews, slew_count_);
+    debugPrint(sta_->debug(), "bulk_annotation", 1,
+	       "%zu delays %zu slews annotated", delay_count_, slew_count_);
+  }
+  catch (...) {
+    gzclose(stream_);
+    // Values in the chunks read before the error are annotated.
+    annotationsInvalid();
+    throw;
+  }
+  gzclose(stream_);
+  annotationsInvalid();
+}
+
+// Invalidate once for the whole file instead of once per chunk.
+void
+BulkAnnotationReader::annotationsInvalid()
+{
+  if (slew_count_ > 0)
+    sta_->delaysInvalid();
+  else if (delay_count_ > 0)
+    sta_->arrivalsInvalid();
+}
+
+void
+BulkAnnotationReader::readHeader()
+{
+  char magic[sizeof(bulk_annotation_magic) - 1];
+  readBytes(magic, sizeof(magic));
+  if (memcmp(magic, bulk_annotation_magic, sizeof(magic)) != 0)
+    sta_->report()->error(623, "%s is not a bulk annotation file.", filename_);
+}
+
+uint64_t
+BulkAnnotationReader::readCount()
+{
+  uint64_t count;
+  readBytes(&count, sizeof(count));
+  return count;
+}
+
+void
+BulkAnnotationReader::readBytes(void *buffer,
+				size_t size)
+{
+  int length = gzread(stream_, buffer, size);
+  if (length < 0
+      || static_cast<size_t>(length) != size)
+    sta_->report()->error(624, "%s is truncated.", filename_);
+}
+
+// Read and annotate a section of the file in chunks.
+template <class ANNOTATION>
+void
+BulkAnnotationReader::readAnnotations(size_t (*annotate)(const ANNOTATION *annotations,
+							 size_t count,
+							 const StaState *sta),
+				      size_t &annotated_count)
+{
+  uint64_t count = readCount();
+  std::vector<ANNOTATION> annotations(bulk_annotation_chunk);
+  uint64_t read_count = 0;
+  while (read_count < count) {
+    size_t chunk_count = std::min(count - read_count,
+				  static_cast<uint64_t>(bulk_annotation_chunk));
+    readBytes(annotations.data(), chunk_count * sizeof(ANNOTATION));
+    annotated_count += annotate(annotations.data(), chunk_count, sta_);
+    read_count += chunk_count;
+  }
+  size_t ignored_count = count - annotated_count;
+  if (ignored_count > 0)
+    sta_->report()->warn(625, "%s %zu annotations with unknown ids ignored.",
+			 filename_,
+			 ignored_count);
+}
+
+} // namespace
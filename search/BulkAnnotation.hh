@@ -0,0 +1,80 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+
+#include "GraphClass.hh"
+
+namespace sta {
+
+class Sta;
+class StaState;
+
+// Delay annotation for bulk annotation by external delay calculators.
+//  edge_id is Graph::id(edge)
+//  arc_index is TimingArc::index()
+//  ap_index is DcalcAnalysisPt::index()
+class ArcDelayAnnotation
+{
+public:
+  EdgeId edge_id;
+  uint32_t arc_index;
+  uint32_t ap_index;
+  float delay;
+};
+
+// Slew annotation for bulk annotation by external delay calculators.
+//  vertex_id is Graph::id(vertex)
+//  rf_index is RiseFall::index()
+//  ap_index is DcalcAnalysisPt::index()
+class SlewAnnotation
+{
+public:
+  VertexId vertex_id;
+  uint32_t rf_index;
+  uint32_t ap_index;
+  float slew;
+};
+
+// Annotate delays/slews without invalidating delays or arrivals.
+// Annotations that reference deleted or unknown ids or out of range
+// indices are ignored. Returns the number of values annotated.
+size_t
+annotateArcDelays(const ArcDelayAnnotation *delays,
+		  size_t count,
+		  const StaState *sta);
+size_t
+annotateSlews(const SlewAnnotation *slews,
+	      size_t count,
+	      const StaState *sta);
+
+// Read a bulk annotation file (optionally gzip'd).
+// The file is binary in native byte order:
+//  char magic[8]                  "STAANNO1"
+//  uint64_t delay_count
+//  ArcDelayAnnotation delays[delay_count]
+//  uint64_t slew_count
+//  SlewAnnotation slews[slew_count]
+// Each annotation is 16 bytes. Ids are only meaningful for the graph
+// of the design that the file was written for.
+// Delays and arrivals are invalidated once after the file is read.
+void
+readBulkAnnotations(const char *filename,
+		    Sta *sta);
+
+} // namespace
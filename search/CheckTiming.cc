@@ -16,6 +16,9 @@
 
 #include "CheckTiming.hh"
 
+#include <algorithm>
+
+#include "DispatchQueue.hh"
 #include "Error.hh"
 #include "TimingRole.hh"
 #include "Network.hh"
@@ -152,18 +155,28 @@ void
 CheckTiming::checkRegClks(bool reg_multiple_clks,
 			  bool reg_no_clks)
 {
-  PinSet no_clk_pins, multiple_clk_pins;
+  VertexSeq reg_clk_vertices;
   VertexSet::ConstIterator reg_clk_iter(graph_->regClkVertices());
   while (reg_clk_iter.hasNext()) {
     Vertex *vertex = reg_clk_iter.next();
+    reg_clk_vertices.push_back(vertex);
+  }
+  int thread_count = visitThreadCount();
+  Vector<PinSet> thread_no_clk_pins(thread_count);
+  Vector<PinSet> thread_multiple_clk_pins(thread_count);
+  visitVertices(reg_clk_vertices, [&](Vertex *vertex,
+				      int thread_index) {
     Pin *pin = vertex->pin();
     ClockSet clks;
     search_->clocks(vertex, clks);
     if (reg_no_clks && clks.empty())
-      no_clk_pins.insert(pin);
+      thread_no_clk_pins[thread_index].insert(pin);
     if (reg_multiple_clks && clks.size() > 1)
-      multiple_clk_pins.insert(pin);
-  }
+      thread_multiple_clk_pins[thread_index].insert(pin);
+  });
+  PinSet no_clk_pins, multiple_clk_pins;
+  mergePinSets(thread_no_clk_pins, no_clk_pins);
+  mergePinSets(thread_multiple_clk_pins, multiple_clk_pins);
   pushPinErrors("Warning: There %is %d unclocked register/latch pin%s.",
 		no_clk_pins);
   pushPinErrors("Warning: There %is %d register/latch pin%s with multiple clocks.",
@@ -230,6 +243,8 @@ CheckTiming::checkUnconstrainedEndpoints()
 void
 CheckTiming::checkUnconstraintedOutputs(PinSet &unconstrained_ends)
 {
+  PinSet max_delay_pins;
+  findMaxDelayPins(max_delay_pins);
   Instance *top_inst = network_->topInstance();
   InstancePinIterator *pin_iter = network_->pinIterator(top_inst);
   while (pin_iter->hasNext()) {
@@ -238,7 +253,7 @@ CheckTiming::checkUnconstraintedOutputs(PinSet &unconstrained_ends)
     if (dir->isAnyOutput()
 	&& !((hasClkedDepature(pin)
 	      && hasClkedArrival(graph_->pinLoadVertex(pin)))
-	     || hasMaxDelay(pin)))
+	     || max_delay_pins.hasKey(pin)))
       unconstrained_ends.insert(pin);
   }
   delete pin_iter;
@@ -258,9 +273,9 @@ CheckTiming::hasClkedDepature(Pin *pin)
   return false;
 }
 
-// Check for max delay exception that ends at pin.
-bool
-CheckTiming::hasMaxDelay(Pin *pin)
+// Find the pins that max delay exceptions end at.
+void
+CheckTiming::findMaxDelayPins(PinSet &max_delay_pins)
 {
   ExceptionPathSet *exceptions = sdc_->exceptions();
   ExceptionPathSet::Iterator exception_iter(exceptions);
@@ -270,30 +285,39 @@ CheckTiming::hasMaxDelay(Pin *pin)
     if (exception->isPathDelay()
 	&& exception->minMax() == MinMaxAll::max()
 	&& to
-	&& to->hasPins()
-	&& to->pins()->hasKey(pin))
-      return true;
+	&& to->hasPins()) {
+      for (Pin *pin : *to->pins())
+	max_delay_pins.insert(pin);
+    }
   }
-  return false;
 }
 
 void
 CheckTiming::checkUnconstrainedSetups(PinSet &unconstrained_ends)
 {
+  // Setup check edges are only to vertices with checks.
+  VertexSeq check_vertices;
   VertexIterator vertex_iter(graph_);
   while (vertex_iter.hasNext()) {
     Vertex *vertex = vertex_iter.next();
+    if (vertex->hasChecks())
+      check_vertices.push_back(vertex);
+  }
+  Vector<PinSet> thread_ends(visitThreadCount());
+  visitVertices(check_vertices, [&](Vertex *vertex,
+				    int thread_index) {
     VertexInEdgeIterator edge_iter(vertex, graph_);
     while (edge_iter.hasNext()) {
       Edge *edge = edge_iter.next();
       if (edge->role() == TimingRole::setup()
 	  && (!search_->isClock(edge->from(graph_))
 	       || !hasClkedArrival(edge->to(graph_)))) {
-	unconstrained_ends.insert(vertex->pin());
+	thread_ends[thread_index].insert(vertex->pin());
 	break;
       }
     }
-  }
+  });
+  mergePinSets(thread_ends, unconstrained_ends);
 }
 
 bool
@@ -308,6 +332,45 @@ CheckTiming::hasClkedArrival(Vertex *vertex)
   return false;
 }
 
+int
+CheckTiming::visitThreadCount() const
+{
+  return std::max(thread_count_, 1);
+}
+
+// Call visit for each vertex on the thread pool.
+// Checks collect errors in sets indexed by thread_index and merge them
+// afterwards, so the errors are the same for any thread count.
+void
+CheckTiming::visitVertices(VertexSeq &vertices,
+			   const CheckVertexFunc &visit)
+{
+  size_t vertex_count = vertices.size();
+  if (thread_count_ <= 1) {
+    for (Vertex *vertex : vertices)
+      visit(vertex, 0);
+  }
+  else {
+    size_t chunk_size = (vertex_count + thread_count_ - 1) / thread_count_;
+    for (size_t start = 0; start < vertex_count; start += chunk_size) {
+      size_t end = std::min(start + chunk_size, vertex_count);
+      dispatch_queue_->dispatch([&vertices, &visit, start, end](int i) {
+	for (size_t j = start; j < end; j++)
+	  visit(vertices[j], i);
+      });
+    }
+    dispatch_queue_->finishTasks();
+  }
+}
+
+void
+CheckTiming::mergePinSets(Vector<PinSet> &thread_pins,
+			  PinSet &pins)
+{
+  for (PinSet &pins1 : thread_pins)
+    pins.insert(pins1.begin(), pins1.end());
+}
+
 void
 CheckTiming::checkGeneratedClocks()
 {
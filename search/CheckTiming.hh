@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "DisallowCopyAssign.hh"
 #include "Vector.hh"
 #include "StringSeq.hh"
@@ -28,6 +30,7 @@ namespace sta {
 
 typedef StringSeq CheckError;
 typedef Vector<CheckError*> CheckErrorSeq;
+typedef std::function<void (Vertex *vertex, int thread_index)> CheckVertexFunc;
 
 class CheckTiming : public StaState
 {
@@ -57,7 +60,12 @@ protected:
   void checkLoops();
   bool hasClkedDepature(Pin *pin);
   bool hasClkedCheck(Vertex *vertex);
-  bool hasMaxDelay(Pin *pin);
+  void findMaxDelayPins(PinSet &max_delay_pins);
+  void visitVertices(VertexSeq &vertices,
+		     const CheckVertexFunc &visit);
+  int visitThreadCount() const;
+  void mergePinSets(Vector<PinSet> &thread_pins,
+		    PinSet &pins);
   void checkGeneratedClocks();
   void pushPinErrors(const char *msg,
 		     PinSet &pins);
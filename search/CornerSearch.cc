@@ -0,0 +1,352 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "CornerSearch.hh"
+
+#include <algorithm>
+#include <map>
+
+#include "StringUtil.hh"
+#include "Report.hh"
+#include "MinMax.hh"
+#include "Corner.hh"
+#include "PathAnalysisPt.hh"
+#include "ExceptionPath.hh"
+#include "PathEnd.hh"
+#include "PathGroup.hh"
+#include "ReportPath.hh"
+#include "Search.hh"
+#include "Sta.hh"
+
+namespace sta {
+
+using std::string;
+
+// Report of a path end found by the search of one corner.
+class CornerPathEnd
+{
+public:
+  // Path group name and min/max.
+  string group_;
+  size_t group_index_;
+  const Vertex *vertex_;
+  Slack slack_;
+  bool unconstrained_;
+  string text_;
+  // Report when the path end is the first of its group, if different.
+  string first_text_;
+};
+
+CornerSearch::CornerSearch(Sta *sta) :
+  StaState(sta),
+  sta_(sta),
+  endpoint_count_(0)
+{
+}
+
+CornerSearch::~CornerSearch()
+{
+  for (CornerPathEnd *path_end : path_ends_)
+    delete path_end;
+}
+
+void
+CornerSearch::findSlacks()
+{
+  PathAPIndex path_ap_count = corners_->pathAnalysisPtCount();
+  worst_slacks_.assign(path_ap_count, MinMax::min()->initValue());
+  tns_.assign(path_ap_count, 0.0);
+  endpoint_count_ = 0;
+  try {
+    for (Corner *corner : *corners_)
+      findCornerSlacks(corner);
+  }
+  catch (...) {
+    search_->setSearchCorner(nullptr);
+    throw;
+  }
+  search_->setSearchCorner(nullptr);
+}
+
+void
+CornerSearch::findCornerSlacks(const Corner *corner)
+{
+  search_->setSearchCorner(corner);
+  sta_->findRequireds();
+  VertexSet *endpoints = search_->endpoints();
+  endpoint_count_ = endpoints->size();
+  SlackSeq slacks(corners_->pathAnalysisPtCount());
+  for (Vertex *vertex : *endpoints) {
+    search_->wnsSlacks(vertex, slacks);
+    for (const PathAnalysisPt *path_ap : corner->pathAnalysisPts()) {
+      PathAPIndex i = path_ap->index();
+      Slack slack = slacks[i];
+      if (delayLess(slack, worst_slacks_[i], this))
+	worst_slacks_[i] = slack;
+      if (delayLess(slack, 0.0, this))
+	tns_[i] += slack;
+    }
+  }
+}
+
+Slack
+CornerSearch::worstSlack(const MinMax *min_max) const
+{
+  Slack worst_slack = MinMax::min()->initValue();
+  for (Corner *corner : *corners_) {
+    PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+    Slack slack = worst_slacks_[path_ap_index];
+    if (delayLess(slack, worst_slack, this))
+      worst_slack = slack;
+  }
+  return worst_slack;
+}
+
+Slack
+CornerSearch::totalNegativeSlack(const MinMax *min_max) const
+{
+  Slack tns = 0.0;
+  for (Corner *corner : *corners_) {
+    PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+    Slack tns1 = tns_[path_ap_index];
+    if (delayLess(tns1, tns, this))
+      tns = tns1;
+  }
+  return tns;
+}
+
+void
+CornerSearch::reportSlacks(int digits)
+{
+  report_->reportLine("Corners    %d", corners_->count());
+  report_->reportLine("Endpoints  %zu", endpoint_count_);
+  report_->reportBlankLine();
+  report_->reportLine("Corner     Max Slack    Max TNS  Min Slack    Min TNS");
+  report_->reportLine("-----------------------------------------------------");
+  for (Corner *corner : *corners_) {
+    string line;
+    stringPrint(line, "%-8s", corner->name());
+    for (const MinMax *min_max : {MinMax::max(), MinMax::min()}) {
+      PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+      line += stdstrPrint(" %10s",
+			  delayAsString(worst_slacks_[path_ap_index],
+					this, digits));
+      line += stdstrPrint(" %10s",
+			  delayAsString(tns_[path_ap_index], this, digits));
+    }
+    report_->reportLineString(line);
+  }
+  report_->reportBlankLine();
+  for (const MinMax *min_max : MinMax::range()) {
+    report_->reportLine("%s worst slack %s",
+			min_max->asString(),
+			delayAsString(worstSlack(min_max), this, digits));
+    report_->reportLine("%s tns %s",
+			min_max->asString(),
+			delayAsString(totalNegativeSlack(min_max), this, digits));
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+bool
+CornerSearch::reportPathEnds(ExceptionFrom *from,
+			     ExceptionThruSeq *thrus,
+			     ExceptionTo *to,
+			     bool unconstrained,
+			     const Corner *corner,
+			     const MinMaxAll *min_max,
+			     int group_count,
+			     int endpoint_count,
+			     bool unique_pins,
+			     float slack_min,
+			     float slack_max,
+			     bool sort_by_slack,
+			     PathGroupNameSet *group_names,
+			     bool setup,
+			     bool hold,
+			     bool recovery,
+			     bool removal,
+			     bool clk_gating_setup,
+			     bool clk_gating_hold)
+{
+  try {
+    for (Corner *corner1 : *corners_) {
+      if (corner == nullptr || corner1 == corner) {
+	search_->setSearchCorner(corner1);
+	// findPathEnds takes ownership of from/thrus/to.
+	ExceptionFrom *from1 = from ? from->clone() : nullptr;
+	ExceptionThruSeq *thrus1 = nullptr;
+	if (thrus) {
+	  thrus1 = new ExceptionThruSeq;
+	  for (ExceptionThru *thru : *thrus)
+	    thrus1->push_back(thru->clone(network_));
+	}
+	ExceptionTo *to1 = to ? to->clone() : nullptr;
+	PathEndSeq *path_ends = sta_->findPathEnds(from1, thrus1, to1,
+						   unconstrained, corner1,
+						   min_max, group_count,
+						   endpoint_count, unique_pins,
+						   slack_min, slack_max,
+						   sort_by_slack, group_names,
+						   setup, hold,
+						   recovery, removal,
+						   clk_gating_setup,
+						   clk_gating_hold);
+	savePathEnds(path_ends);
+	delete path_ends;
+      }
+    }
+  }
+  catch (...) {
+    search_->setSearchCorner(nullptr);
+    throw;
+  }
+  search_->setSearchCorner(nullptr);
+  delete from;
+  if (thrus) {
+    thrus->deleteContents();
+    delete thrus;
+  }
+  delete to;
+
+  mergePathEnds(group_count, endpoint_count, sort_by_slack);
+  if (path_ends_.empty())
+    return false;
+  else {
+    reportMergedPathEnds();
+    return true;
+  }
+}
+
+void
+CornerSearch::savePathEnds(PathEndSeq *path_ends)
+{
+  ReportPath *report_path = sta_->reportPath();
+  bool group_headers =
+    report_path->pathFormat() == ReportPathFormat::endpoint;
+  int prev_group_index = -1;
+  for (PathEnd *path_end : *path_ends) {
+    CornerPathEnd *corner_end = new CornerPathEnd;
+    corner_end->group_ = stdstrPrint("%s %s",
+				     path_end->minMax(this)->asString(),
+				     search_->pathGroup(path_end)->name());
+    groupIndex(corner_end->group_, prev_group_index);
+    corner_end->vertex_ = path_end->vertex(this);
+    corner_end->slack_ = path_end->slack(this);
+    corner_end->unconstrained_ = path_end->isUnconstrained();
+    // Passing the path end as its own previous path end leaves out
+    // the group header.
+    report_->redirectStringBegin();
+    report_path->reportPathEnd(path_end, path_end);
+    corner_end->text_ = report_->redirectStringEnd();
+    if (group_headers) {
+      report_->redirectStringBegin();
+      report_path->reportPathEnd(path_end, nullptr);
+      corner_end->first_text_ = report_->redirectStringEnd();
+    }
+    path_ends_.push_back(corner_end);
+  }
+}
+
+// Every corner reports the groups in the same order, but a corner may
+// not have path ends in every group. Insert a group that has not been
+// seen after the previous group of the corner.
+void
+CornerSearch::groupIndex(const string &group,
+			 int &prev_group_index)
+{
+  auto group_iter = std::find(group_names_.begin(), group_names_.end(),
+			      group);
+  if (group_iter == group_names_.end()) {
+    int index = prev_group_index + 1;
+    group_names_.insert(group_names_.begin() + index, group);
+    prev_group_index = index;
+  }
+  else
+    prev_group_index = group_iter - group_names_.begin();
+}
+
+// Sort the path ends of all corners and keep the group_count worst
+// path ends of each group and endpoint_count of each endpoint.
+void
+CornerSearch::mergePathEnds(int group_count,
+			    int endpoint_count,
+			    bool sort_by_slack)
+{
+  std::map<string, size_t> group_indices;
+  for (size_t i = 0; i < group_names_.size(); i++)
+    group_indices[group_names_[i]] = i;
+  bool constrained = false;
+  for (CornerPathEnd *path_end : path_ends_) {
+    path_end->group_index_ = group_indices[path_end->group_];
+    if (!path_end->unconstrained_)
+      constrained = true;
+  }
+  const StaState *sta = this;
+  std::stable_sort(path_ends_.begin(), path_ends_.end(),
+		   [sort_by_slack, sta] (const CornerPathEnd *end1,
+					 const CornerPathEnd *end2) {
+		     if (!sort_by_slack
+			 && end1->group_index_ != end2->group_index_)
+		       return end1->group_index_ < end2->group_index_;
+		     return delayLess(end1->slack_, end2->slack_, sta);
+		   });
+
+  std::vector<CornerPathEnd*> merged_ends;
+  std::vector<int> group_counts(group_names_.size(), 0);
+  std::map<std::pair<size_t, const Vertex*>, int> endpoint_counts;
+  for (CornerPathEnd *path_end : path_ends_) {
+    size_t group_index = path_end->group_index_;
+    int &endpoint_count1 = endpoint_counts[{group_index, path_end->vertex_}];
+    // Unconstrained paths are only reported when no corner has
+    // constrained paths.
+    if (!(constrained && path_end->unconstrained_)
+	&& group_counts[group_index] < group_count
+	&& endpoint_count1 < endpoint_count
+	&& !(sort_by_slack
+	     && merged_ends.size() >= static_cast<size_t>(group_count))) {
+      merged_ends.push_back(path_end);
+      group_counts[group_index]++;
+      endpoint_count1++;
+    }
+    else
+      delete path_end;
+  }
+  path_ends_.swap(merged_ends);
+}
+
+void
+CornerSearch::reportMergedPathEnds()
+{
+  sta_->reportPathEndHeader();
+  const CornerPathEnd *prev_end = nullptr;
+  for (const CornerPathEnd *path_end : path_ends_) {
+    const string *text = &path_end->text_;
+    if (!path_end->first_text_.empty()
+	&& (prev_end == nullptr
+	    || path_end->group_index_ != prev_end->group_index_)) {
+      if (prev_end)
+	report_->reportBlankLine();
+      text = &path_end->first_text_;
+    }
+    report_->printString(text->c_str(), text->size());
+    prev_end = path_end;
+  }
+  sta_->reportPathEndFooter();
+}
+
+} // namespace
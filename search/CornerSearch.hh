@@ -0,0 +1,102 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DisallowCopyAssign.hh"
+#include "GraphClass.hh"
+#include "SdcClass.hh"
+#include "SearchClass.hh"
+#include "Delay.hh"
+#include "StaState.hh"
+
+namespace sta {
+
+class Sta;
+class MinMax;
+class MinMaxAll;
+class Corner;
+class CornerPathEnd;
+
+// Find the arrivals of one corner at a time and merge the results.
+// Only the path analysis points of the corner being searched are seeded
+// (Search::setSearchCorner), so the tags and path storage are for that
+// corner alone. The delays for all corners are found once.
+// 
+// Path ends are reported while their corner is searched. The reports
+// are merged by path group and slack with the group and endpoint path
+// counts applied across corners, so they match a report of a search of
+// all corners.
+class CornerSearch : public StaState
+{
+public:
+  explicit CornerSearch(Sta *sta);
+  ~CornerSearch();
+  // Endpoint slacks for each path analysis point.
+  void findSlacks();
+  void reportSlacks(int digits);
+  Slack worstSlack(const MinMax *min_max) const;
+  Slack totalNegativeSlack(const MinMax *min_max) const;
+  // Arguments are the same as Sta::findPathEnds.
+  // corner=nullptr searches every corner.
+  // Returns false if there are no path ends.
+  bool reportPathEnds(ExceptionFrom *from,
+		      ExceptionThruSeq *thrus,
+		      ExceptionTo *to,
+		      bool unconstrained,
+		      const Corner *corner,
+		      const MinMaxAll *min_max,
+		      int group_count,
+		      int endpoint_count,
+		      bool unique_pins,
+		      float slack_min,
+		      float slack_max,
+		      bool sort_by_slack,
+		      PathGroupNameSet *group_names,
+		      bool setup,
+		      bool hold,
+		      bool recovery,
+		      bool removal,
+		      bool clk_gating_setup,
+		      bool clk_gating_hold);
+
+protected:
+  void findCornerSlacks(const Corner *corner);
+  void savePathEnds(PathEndSeq *path_ends);
+  void groupIndex(const std::string &group,
+		  int &prev_group_index);
+  void mergePathEnds(int group_count,
+		     int endpoint_count,
+		     bool sort_by_slack);
+  void reportMergedPathEnds();
+
+  Sta *sta_;
+  size_t endpoint_count_;
+  // Merged slacks indexed by path analysis point index.
+  std::vector<Slack> worst_slacks_;
+  std::vector<Slack> tns_;
+  // Path group names in report order.
+  std::vector<std::string> group_names_;
+  std::vector<CornerPathEnd*> path_ends_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CornerSearch);
+};
+
+} // namespace
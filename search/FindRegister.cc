@@ -17,6 +17,7 @@
 #include "FindRegister.hh"
 
 #include "DisallowCopyAssign.hh"
+#include "Debug.hh"
 #include "TimingRole.hh"
 #include "FuncExpr.hh"
 #include "TimingArc.hh"
@@ -77,12 +78,130 @@ FindRegClkPred::searchThru(Edge *edge)
     && SearchPred1::searchThru(edge);
 }
 
+////////////////////////////////////////////////////////////////
+
+class ClkRegIndex
+{
+public:
+  RegClkPinSenses reg_clk_pins_;
+  // Pins in the clock fanout searched to find reg_clk_pins_.
+  PinSet fanout_pins_;
+};
+
+RegisterIndex::RegisterIndex(StaState *sta) :
+  StaState(sta)
+{
+}
+
+RegisterIndex::~RegisterIndex()
+{
+  clk_indices_.deleteContents();
+}
+
+void
+RegisterIndex::clear()
+{
+  clk_indices_.deleteContentsClear();
+}
+
+const RegClkPinSenses &
+RegisterIndex::regClkPins(Clock *clk)
+{
+  ClkRegIndex *clk_index = clk_indices_.findKey(clk);
+  if (clk_index == nullptr) {
+    debugPrint(debug_, "find_reg", 1, "index clock %s", clk->name());
+    clk_index = new ClkRegIndex;
+    // Use DFS search to find all registers downstream of the clock.
+    FindRegClkPred clk_pred(clk, this);
+    VertexSet visited_vertices;
+    for (Pin *pin : clk->leafPins()) {
+      Vertex *vertex, *bidirect_drvr_vertex;
+      graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+      findRegClkPins(vertex, TimingSense::positive_unate,
+		     clk_pred, visited_vertices, clk_index);
+      // Clocks defined on bidirect pins blow it out both ends.
+      if (bidirect_drvr_vertex)
+	findRegClkPins(bidirect_drvr_vertex, TimingSense::positive_unate,
+		       clk_pred, visited_vertices, clk_index);
+    }
+    clk_indices_[clk] = clk_index;
+  }
+  return clk_index->reg_clk_pins_;
+}
+
+void
+RegisterIndex::findRegClkPins(Vertex *from_vertex,
+			      TimingSense from_sense,
+			      SearchPred &clk_pred,
+			      VertexSet &visited_vertices,
+			      ClkRegIndex *clk_index)
+{
+  if (!visited_vertices.hasKey(from_vertex)
+      && clk_pred.searchFrom(from_vertex)) {
+    visited_vertices.insert(from_vertex);
+    clk_index->fanout_pins_.insert(from_vertex->pin());
+    VertexOutEdgeIterator edge_iter(from_vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *to_vertex = edge->to(graph_);
+      const Pin *to_pin = to_vertex->pin();
+      TimingSense to_sense = pathSenseThru(from_sense, edge->sense());
+      if (to_vertex->isRegClk()) {
+	clk_index->reg_clk_pins_[to_pin] |= 1 << int(to_sense);
+	clk_index->fanout_pins_.insert(const_cast<Pin*>(to_pin));
+      }
+      // Even register clock pins can have combinational fanout arcs.
+      if (clk_pred.searchThru(edge)
+          && clk_pred.searchTo(to_vertex))
+	findRegClkPins(to_vertex, to_sense, clk_pred,
+		       visited_vertices, clk_index);
+    }
+  }
+}
+
+void
+RegisterIndex::pinChanged(const Pin *pin)
+{
+  ClkRegIndexMap::Iterator index_iter(clk_indices_);
+  while (index_iter.hasNext()) {
+    const Clock *clk;
+    ClkRegIndex *clk_index;
+    index_iter.next(clk, clk_index);
+    if (clk_index->fanout_pins_.hasKey(const_cast<Pin*>(pin))) {
+      debugPrint(debug_, "find_reg", 1, "index clock %s invalid",
+		 clk->name());
+      clk_indices_.erase(clk);
+      delete clk_index;
+    }
+  }
+}
+
+void
+RegisterIndex::netPinsChanged(const Pin *pin)
+{
+  if (!clk_indices_.empty()) {
+    pinChanged(pin);
+    Net *net = network_->net(pin);
+    if (net) {
+      NetConnectedPinIterator *pin_iter = network_->connectedPinIterator(net);
+      while (pin_iter->hasNext()) {
+	Pin *net_pin = pin_iter->next();
+	pinChanged(net_pin);
+      }
+      delete pin_iter;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
 // Helper for "all_registers".
 // Visit all register instances.
 class FindRegVisitor : public StaState
 {
 public:
-  FindRegVisitor(StaState *sta);
+  FindRegVisitor(RegisterIndex *reg_index,
+		 StaState *sta);
   virtual ~FindRegVisitor() {}
   void visitRegs(ClockSet *clks,
 		 const RiseFallBoth *clk_rf,
@@ -99,13 +218,6 @@ private:
   virtual void visitReg(Instance *inst) = 0;
   virtual void visitSequential(Instance *inst,
 			       Sequential *seq) = 0;
-  void visitFanoutRegs(Vertex *from_vertex,
-		       TimingSense from_sense,
-		       const RiseFallBoth *clk_rf,
-		       bool edge_triggered,
-		       bool latches,
-		       SearchPred &clk_pred,
-		       VertexSet &visited_vertices);
   void findSequential(const Pin *clk_pin,
 		      Instance *inst,
 		      LibertyCell *cell,
@@ -124,10 +236,13 @@ private:
 		      LibertyPort *clk,
 		      LibertyPort *d);
 
+  RegisterIndex *reg_index_;
 };
 
-FindRegVisitor::FindRegVisitor(StaState *sta) :
-  StaState(sta)
+FindRegVisitor::FindRegVisitor(RegisterIndex *reg_index,
+			       StaState *sta) :
+  StaState(sta),
+  reg_index_(reg_index)
 {
 }
 
@@ -138,26 +253,17 @@ FindRegVisitor::visitRegs(ClockSet *clks,
 			  bool latches)
 {
   if (clks && !clks->empty()) {
-    // Use DFS search to find all registers downstream of the clocks.
     ClockSet::Iterator clk_iter(clks);
     while (clk_iter.hasNext()) {
       Clock *clk = clk_iter.next();
-      FindRegClkPred clk_pred(clk, this);
-      VertexSet visited_vertices;
-      for (Pin *pin : clk->leafPins()) {
-	Vertex *vertex, *bidirect_drvr_vertex;
-	graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
-	visitFanoutRegs(vertex, TimingSense::positive_unate,
-			clk_rf, edge_triggered,
-			latches, clk_pred,
-			visited_vertices);
-	// Clocks defined on bidirect pins blow it out both ends.
-	if (bidirect_drvr_vertex)
-	  visitFanoutRegs(bidirect_drvr_vertex,
-			  TimingSense::positive_unate,
-			  clk_rf, edge_triggered,
-			  latches, clk_pred,
-			  visited_vertices);
+      for (auto pin_senses : reg_index_->regClkPins(clk)) {
+	const Pin *clk_pin = pin_senses.first;
+	unsigned senses = pin_senses.second;
+	for (int sense = 0; sense < timing_sense_count; sense++) {
+	  if (senses & (1 << sense))
+	    visitRegs(clk_pin, static_cast<TimingSense>(sense),
+		      clk_rf, edge_triggered, latches);
+	}
       }
     }
   }
@@ -172,35 +278,6 @@ FindRegVisitor::visitRegs(ClockSet *clks,
   }
 }
 
-void
-FindRegVisitor::visitFanoutRegs(Vertex *from_vertex,
-				TimingSense from_sense,
-				const RiseFallBoth *clk_rf,
-				bool edge_triggered,
-				bool latches,
-				SearchPred &clk_pred,
-				VertexSet &visited_vertices)
-{
-  if (!visited_vertices.hasKey(from_vertex)
-      && clk_pred.searchFrom(from_vertex)) {
-    visited_vertices.insert(from_vertex);
-    VertexOutEdgeIterator edge_iter(from_vertex, graph_);
-    while (edge_iter.hasNext()) {
-      Edge *edge = edge_iter.next();
-      Vertex *to_vertex = edge->to(graph_);
-      const Pin *to_pin = to_vertex->pin();
-      TimingSense to_sense = pathSenseThru(from_sense, edge->sense());
-      if (to_vertex->isRegClk())
-	visitRegs(to_pin, to_sense, clk_rf, edge_triggered, latches);
-      // Even register clock pins can have combinational fanout arcs.
-      if (clk_pred.searchThru(edge)
-          && clk_pred.searchTo(to_vertex))
-	visitFanoutRegs(to_vertex, to_sense, clk_rf, edge_triggered, latches,
-			clk_pred, visited_vertices);
-    }
-  }
-}
-
 void
 FindRegVisitor::visitRegs(const Pin *clk_pin,
 			  TimingSense clk_sense,
@@ -321,7 +398,8 @@ FindRegVisitor::hasTimingCheck(LibertyCell *cell,
 class FindRegInstances : public FindRegVisitor
 {
 public:
-  explicit FindRegInstances(StaState *sta);
+  FindRegInstances(RegisterIndex *reg_index,
+		   StaState *sta);
   InstanceSet *findRegs(ClockSet *clks,
 			const RiseFallBoth *clk_rf,
 			bool edge_triggered,
@@ -336,8 +414,9 @@ private:
   InstanceSet *regs_;
 };
 
-FindRegInstances::FindRegInstances(StaState *sta) :
-  FindRegVisitor(sta),
+FindRegInstances::FindRegInstances(RegisterIndex *reg_index,
+				   StaState *sta) :
+  FindRegVisitor(reg_index, sta),
   regs_(nullptr)
 {
 }
@@ -370,9 +449,10 @@ findRegInstances(ClockSet *clks,
 		 const RiseFallBoth *clk_rf,
 		 bool edge_triggered,
 		 bool latches,
+		 RegisterIndex *reg_index,
 		 StaState *sta)
 {
-  FindRegInstances find_regs(sta);
+  FindRegInstances find_regs(reg_index, sta);
   return find_regs.findRegs(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -381,7 +461,8 @@ findRegInstances(ClockSet *clks,
 class FindRegPins : public FindRegVisitor
 {
 public:
-  explicit FindRegPins(StaState *sta);
+  FindRegPins(RegisterIndex *reg_index,
+	      StaState *sta);
   PinSet *findPins(ClockSet *clks,
 		   const RiseFallBoth *clk_rf,
 		   bool edge_triggered,
@@ -403,8 +484,9 @@ protected:
   PinSet *pins_;
 };
 
-FindRegPins::FindRegPins(StaState *sta) :
-  FindRegVisitor(sta),
+FindRegPins::FindRegPins(RegisterIndex *reg_index,
+			 StaState *sta) :
+  FindRegVisitor(reg_index, sta),
   pins_(nullptr)
 {
 }
@@ -465,7 +547,8 @@ FindRegPins::matchPin(Pin *)
 class FindRegDataPins : public FindRegPins
 {
 public:
-  explicit FindRegDataPins(StaState *sta);
+  FindRegDataPins(RegisterIndex *reg_index,
+		  StaState *sta);
 
 private:
   DISALLOW_COPY_AND_ASSIGN(FindRegDataPins);
@@ -474,8 +557,9 @@ private:
   virtual FuncExpr *seqExpr2(Sequential *seq);
 };
 
-FindRegDataPins::FindRegDataPins(StaState *sta) :
-  FindRegPins(sta)
+FindRegDataPins::FindRegDataPins(RegisterIndex *reg_index,
+				 StaState *sta) :
+  FindRegPins(reg_index, sta)
 {
 }
 
@@ -521,9 +605,10 @@ findRegDataPins(ClockSet *clks,
 		const RiseFallBoth *clk_rf,
 		bool edge_triggered,
 		bool latches,
+		RegisterIndex *reg_index,
 		StaState *sta)
 {
-  FindRegDataPins find_regs(sta);
+  FindRegDataPins find_regs(reg_index, sta);
   return find_regs.findPins(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -532,7 +617,8 @@ findRegDataPins(ClockSet *clks,
 class FindRegClkPins : public FindRegPins
 {
 public:
-  explicit FindRegClkPins(StaState *sta);
+  FindRegClkPins(RegisterIndex *reg_index,
+		 StaState *sta);
 
 private:
   DISALLOW_COPY_AND_ASSIGN(FindRegClkPins);
@@ -541,8 +627,9 @@ private:
   virtual FuncExpr *seqExpr2(Sequential *seq);
 };
 
-FindRegClkPins::FindRegClkPins(StaState *sta) :
-  FindRegPins(sta)
+FindRegClkPins::FindRegClkPins(RegisterIndex *reg_index,
+			       StaState *sta) :
+  FindRegPins(reg_index, sta)
 {
 }
 
@@ -579,9 +666,10 @@ findRegClkPins(ClockSet *clks,
 	       const RiseFallBoth *clk_rf,
 	       bool edge_triggered,
 	       bool latches,
+	       RegisterIndex *reg_index,
 	       StaState *sta)
 {
-  FindRegClkPins find_regs(sta);
+  FindRegClkPins find_regs(reg_index, sta);
   return find_regs.findPins(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -590,7 +678,8 @@ findRegClkPins(ClockSet *clks,
 class FindRegAsyncPins : public FindRegPins
 {
 public:
-  explicit FindRegAsyncPins(StaState *sta);
+  FindRegAsyncPins(RegisterIndex *reg_index,
+		   StaState *sta);
 
 private:
   DISALLOW_COPY_AND_ASSIGN(FindRegAsyncPins);
@@ -599,8 +688,9 @@ private:
   virtual FuncExpr *seqExpr2(Sequential *seq) { return seq->preset(); }
 };
 
-FindRegAsyncPins::FindRegAsyncPins(StaState *sta) :
-  FindRegPins(sta)
+FindRegAsyncPins::FindRegAsyncPins(RegisterIndex *reg_index,
+				   StaState *sta) :
+  FindRegPins(reg_index, sta)
 {
 }
 
@@ -624,9 +714,10 @@ findRegAsyncPins(ClockSet *clks,
 		 const RiseFallBoth *clk_rf,
 		 bool edge_triggered,
 		 bool latches,
+		 RegisterIndex *reg_index,
 		 StaState *sta)
 {
-  FindRegAsyncPins find_regs(sta);
+  FindRegAsyncPins find_regs(reg_index, sta);
   return find_regs.findPins(clks, clk_rf, edge_triggered, latches);
 }
 
@@ -635,7 +726,8 @@ findRegAsyncPins(ClockSet *clks,
 class FindRegOutputPins : public FindRegPins
 {
 public:
-  explicit FindRegOutputPins(StaState *sta);
+  FindRegOutputPins(RegisterIndex *reg_index,
+		    StaState *sta);
 
 private:
   DISALLOW_COPY_AND_ASSIGN(FindRegOutputPins);
@@ -649,8 +741,9 @@ private:
   virtual FuncExpr *seqExpr2(Sequential *seq);
 };
 
-FindRegOutputPins::FindRegOutputPins(StaState *sta) :
-  FindRegPins(sta)
+FindRegOutputPins::FindRegOutputPins(RegisterIndex *reg_index,
+				     StaState *sta) :
+  FindRegPins(reg_index, sta)
 {
 }
 
@@ -718,9 +811,10 @@ findRegOutputPins(ClockSet *clks,
 		  const RiseFallBoth *clk_rf,
 		  bool edge_triggered,
 		  bool latches,
+		  RegisterIndex *reg_index,
 		  StaState *sta)
 {
-  FindRegOutputPins find_regs(sta);
+  FindRegOutputPins find_regs(reg_index, sta);
   return find_regs.findPins(clks, clk_rf, edge_triggered, latches);
 }
 
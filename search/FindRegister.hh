@@ -16,28 +16,68 @@
 
 #pragma once
 
+#include "Map.hh"
 #include "LibertyClass.hh"
 #include "NetworkClass.hh"
+#include "GraphClass.hh"
 #include "SdcClass.hh"
 #include "StaState.hh"
 
 namespace sta {
 
+class ClkRegIndex;
+class SearchPred;
+
+// Register clock pin -> mask of (1 << TimingSense) clock senses
+// that reach the pin.
+typedef Map<const Pin*, unsigned> RegClkPinSenses;
+typedef Map<const Clock*, ClkRegIndex*> ClkRegIndexMap;
+
+// Index of the register clock pins in the fanout of each clock so
+// all_registers -clock does not search the clock network each time.
+// Clocks are indexed when they are first queried.
+class RegisterIndex : public StaState
+{
+public:
+  explicit RegisterIndex(StaState *sta);
+  ~RegisterIndex();
+  void clear();
+  const RegClkPinSenses &regClkPins(Clock *clk);
+  // Clocks with pin in their fanout are indexed again on the next query.
+  void pinChanged(const Pin *pin);
+  // pinChanged for the pins on the net connected to pin.
+  void netPinsChanged(const Pin *pin);
+
+private:
+  void findRegClkPins(Vertex *from_vertex,
+		      TimingSense from_sense,
+		      SearchPred &clk_pred,
+		      VertexSet &visited_vertices,
+		      ClkRegIndex *clk_index);
+
+  ClkRegIndexMap clk_indices_;
+};
+
 InstanceSet *
 findRegInstances(ClockSet *clks, const RiseFallBoth *clk_rf,
-		 bool edge_triggered, bool latches, StaState *sta);
+		 bool edge_triggered, bool latches,
+		 RegisterIndex *reg_index, StaState *sta);
 PinSet *
 findRegDataPins(ClockSet *clks, const RiseFallBoth *clk_rf,
-		bool edge_triggered, bool latches, StaState *sta);
+		bool edge_triggered, bool latches,
+		RegisterIndex *reg_index, StaState *sta);
 PinSet *
 findRegClkPins(ClockSet *clks, const RiseFallBoth *clk_rf,
-	       bool edge_triggered, bool latches, StaState *sta);
+	       bool edge_triggered, bool latches,
+	       RegisterIndex *reg_index, StaState *sta);
 PinSet *
 findRegAsyncPins(ClockSet *clks, const RiseFallBoth *clk_rf,
-		 bool edge_triggered, bool latches, StaState *sta);
+		 bool edge_triggered, bool latches,
+		 RegisterIndex *reg_index, StaState *sta);
 PinSet *
 findRegOutputPins(ClockSet *clks, const RiseFallBoth *clk_rf,
-		  bool edge_triggered, bool latches, StaState *sta);
+		  bool edge_triggered, bool latches,
+		  RegisterIndex *reg_index, StaState *sta);
 
 void
 initPathSenseThru();
@@ -721,7 +721,7 @@ Genclks::seedSrcPins(Clock *gclk,
     TagGroupBldr tag_bldr(true, this);
     tag_bldr.init(vertex);
     copyGenClkSrcPaths(vertex, &tag_bldr);
-    for (auto path_ap : corners_->pathAnalysisPts()) {
+    for (auto path_ap : search_->searchPathAnalysisPts()) {
       const MinMax *min_max = path_ap->pathMinMax();
       const EarlyLate *early_late = min_max;
       for (auto tr : RiseFall::range()) {
@@ -1136,7 +1136,7 @@ Genclks::seedPllPin(const Clock *gclk,
   TagGroupBldr tag_bldr(true, this);
   tag_bldr.init(vertex);
   copyGenClkSrcPaths(vertex, &tag_bldr);
-  for (auto path_ap : corners_->pathAnalysisPts()) {
+  for (auto path_ap : search_->searchPathAnalysisPts()) {
     for (auto tr : RiseFall::range()) {
       Tag *tag = makeTag(gclk, gclk, pll_out_pin, tr, pll_filter, path_ap);
       tag_bldr.setArrival(tag, 0.0, nullptr);
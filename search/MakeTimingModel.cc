@@ -0,0 +1,1124 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MakeTimingModel.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DisallowCopyAssign.hh"
+#include "Error.hh"
+#include "Debug.hh"
+#include "Transition.hh"
+#include "MinMax.hh"
+#include "RiseFallMinMax.hh"
+#include "PortDirection.hh"
+#include "TimingRole.hh"
+#include "TimingArc.hh"
+#include "Liberty.hh"
+#include "Network.hh"
+#include "Graph.hh"
+#include "PortExtCap.hh"
+#include "Sdc.hh"
+#include "ExceptionPath.hh"
+#include "Corner.hh"
+#include "DcalcAnalysisPt.hh"
+#include "GraphDelayCalc.hh"
+#include "SearchPred.hh"
+#include "Sta.hh"
+
+namespace sta {
+
+using std::pair;
+using std::string;
+using std::vector;
+
+// Table index values (seconds/farads) that the model is swept over.
+static const int model_slew_count = 4;
+static const int model_load_count = 4;
+static const float model_slews[model_slew_count] = {10e-12, 50e-12,
+						     200e-12, 600e-12};
+static const float model_loads[model_load_count] = {1e-15, 10e-15,
+						     40e-15, 150e-15};
+
+// Liberty units of the model.
+static const float model_time_scale = 1e-9;
+static const float model_cap_scale = 1e-12;
+
+// Min or max value of one model table over the sweep.
+// 1D tables indexed by load use slew index 0.
+// 1D tables indexed by slew use load index 0.
+class ModelTable
+{
+public:
+  explicit ModelTable(const MinMax *min_max = MinMax::max());
+  void merge(int slew_index,
+	     int load_index,
+	     float value);
+  void merge(const ModelTable &table);
+
+  const MinMax *min_max_;
+  bool exists_;
+  float values_[model_slew_count][model_load_count];
+};
+
+class ModelDelayArc
+{
+public:
+  ModelDelayArc();
+
+  // Indexed by min/max, from rf, to rf.
+  ModelTable delays_[MinMax::index_count][RiseFall::index_count][RiseFall::index_count];
+  // Output transition indexed by min/max, to rf.
+  ModelTable slews_[MinMax::index_count][RiseFall::index_count];
+};
+
+class ModelCheckArc
+{
+public:
+  // Indexed by clk rf, data rf.
+  ModelTable setup_[RiseFall::index_count][RiseFall::index_count];
+  ModelTable hold_[RiseFall::index_count][RiseFall::index_count];
+};
+
+// Path delays from one source pin/transition.
+class ModelArrival
+{
+public:
+  ModelArrival();
+
+  bool exists_[RiseFall::index_count];
+  float min_[RiseFall::index_count];
+  float max_[RiseFall::index_count];
+};
+
+typedef pair<const Pin*, const Pin*> ModelPinPair;
+typedef std::map<ModelPinPair, ModelDelayArc> ModelDelayArcMap;
+typedef std::map<ModelPinPair, ModelCheckArc> ModelCheckArcMap;
+typedef std::unordered_map<VertexId, ModelArrival> ModelClkArrivalMap;
+
+// Search thru data paths without starting new paths at registers.
+class ModelDataPred : public SearchPred2
+{
+public:
+  explicit ModelDataPred(const StaState *sta);
+  virtual bool searchThru(Edge *edge);
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ModelDataPred);
+};
+
+ModelDataPred::ModelDataPred(const StaState *sta) :
+  SearchPred2(sta)
+{
+}
+
+bool
+ModelDataPred::searchThru(Edge *edge)
+{
+  return SearchPred2::searchThru(edge)
+    && edge->role()->genericRole() != TimingRole::regClkToQ();
+}
+
+class MakeTimingModel : public StaState
+{
+public:
+  MakeTimingModel(const char *lib_name,
+		  const char *cell_name,
+		  const Corner *corner,
+		  Sta *sta);
+  void makeTimingModel();
+  void writeLiberty(const char *filename,
+		    const char *lib_name,
+		    const MinMax *min_max);
+
+private:
+  void findPorts();
+  void saveSweepState();
+  void restoreSweepState();
+  void setInputSlews(float slew);
+  void setOutputLoads(float load);
+  void findClkArrivals(int load_index);
+  void findDataArrivals(int slew_index,
+			int load_index);
+  void findArrivals(Vertex *from_vertex,
+		    const RiseFall *from_rf,
+		    SearchPred *pred);
+  void visitCone(Vertex *vertex);
+  void findChecks(const Pin *data_pin,
+		  const RiseFall *data_rf,
+		  int slew_index);
+  void recordOutputDelays(const Pin *from_pin,
+			  const RiseFall *from_rf,
+			  int slew_index,
+			  int load_index);
+
+  void writeHeader();
+  void writeBusTypes();
+  void writeCell();
+  void writePort(Port *port,
+		 const char *indent);
+  void writeInputPin(const Pin *pin,
+		     const char *indent);
+  void writeOutputPin(const Pin *pin,
+		      const char *indent);
+  void warnExceptions();
+  void writeCombArc(const Pin *from_pin,
+		    ModelDelayArc &arc,
+		    const char *indent);
+  void writeClkArcs(const Pin *clk_pin,
+		    ModelDelayArc &arc,
+		    const char *indent);
+  void writeCheckArcs(const Pin *clk_pin,
+		      ModelCheckArc &arc,
+		      const char *indent);
+  void writeCheckArc(const Pin *clk_pin,
+		     const RiseFall *clk_rf,
+		     const char *timing_type,
+		     ModelTable tables[RiseFall::index_count][RiseFall::index_count],
+		     const char *indent);
+  void writeTable(const char *group_name,
+		  const ModelTable &table,
+		  bool slew_index,
+		  bool load_index,
+		  const char *indent);
+  void writeIndex(const char *index_name,
+		  const float *values,
+		  int count,
+		  float scale,
+		  const char *indent);
+  float area();
+
+  const char *lib_name_;
+  const char *cell_name_;
+  const Corner *corner_;
+  Sta *sta_;
+  DcalcAPIndex min_ap_index_;
+  DcalcAPIndex max_ap_index_;
+  const DcalcAnalysisPt *max_dcalc_ap_;
+  FILE *stream_;
+  // Delays and slews written by writeLiberty.
+  const MinMax *write_min_max_;
+
+  // Data input (or bidirect) pins.
+  vector<const Pin*> inputs_;
+  // Clock input pins.
+  vector<const Pin*> clks_;
+  // Output (or bidirect) pins.
+  vector<const Pin*> outputs_;
+
+  // Saved annotated slews and port loads restored after the sweep.
+  vector<vector<float>> saved_slews_;
+  vector<int> saved_slew_annotated_;
+  vector<RiseFallMinMax> saved_loads_;
+  // Output ports with no loads before the sweep.
+  vector<bool> saved_no_load_;
+
+  // Indexed by VertexId.
+  vector<ModelArrival> arrivals_;
+  vector<bool> in_cone_;
+  VertexSeq cone_;
+  // Clock arrivals at register clock pins indexed by
+  // clks_ index * RiseFall::index_count + clk rf index.
+  vector<ModelClkArrivalMap> clk_arrivals_;
+
+  // Keyed by from pin, to pin.
+  ModelDelayArcMap comb_arcs_;
+  // Keyed by clock pin, to pin.
+  ModelDelayArcMap clk_arcs_;
+  // Keyed by data pin, clock pin.
+  ModelCheckArcMap check_arcs_;
+
+  DISALLOW_COPY_AND_ASSIGN(MakeTimingModel);
+};
+
+void
+writeTimingModel(const char *filename,
+		 const char *min_filename,
+		 const char *lib_name,
+		 const char *cell_name,
+		 const Corner *corner,
+		 Sta *sta)
+{
+  MakeTimingModel model(lib_name, cell_name, corner, sta);
+  model.makeTimingModel();
+  model.writeLiberty(filename, lib_name, MinMax::max());
+  if (min_filename) {
+    string min_lib_name = string(lib_name) + "_min";
+    model.writeLiberty(min_filename, min_lib_name.c_str(), MinMax::min());
+  }
+}
+
+MakeTimingModel::MakeTimingModel(const char *lib_name,
+				 const char *cell_name,
+				 const Corner *corner,
+				 Sta *sta) :
+  StaState(sta),
+  lib_name_(lib_name),
+  cell_name_(cell_name),
+  corner_(corner),
+  sta_(sta),
+  stream_(nullptr),
+  write_min_max_(MinMax::max())
+{
+  const DcalcAnalysisPt *min_dcalc_ap =
+    corner->findDcalcAnalysisPt(MinMax::min());
+  max_dcalc_ap_ = corner->findDcalcAnalysisPt(MinMax::max());
+  min_ap_index_ = min_dcalc_ap->index();
+  max_ap_index_ = max_dcalc_ap_->index();
+}
+
+void
+MakeTimingModel::makeTimingModel()
+{
+  sta_->ensureGraph();
+  // Sta state may have been updated by ensureGraph.
+  copyState(sta_);
+  warnExceptions();
+  findPorts();
+  size_t id_end = graph_->vertexIdEnd();
+  arrivals_.resize(id_end);
+  in_cone_.assign(id_end, false);
+  clk_arrivals_.resize(clks_.size() * RiseFall::index_count);
+
+  saveSweepState();
+  try {
+    for (int slew_index = 0; slew_index < model_slew_count; slew_index++) {
+      setInputSlews(model_slews[slew_index]);
+      for (int load_index = 0; load_index < model_load_count; load_index++) {
+	setOutputLoads(model_loads[load_index]);
+	sta_->findDelays();
+	findClkArrivals(load_index);
+	findDataArrivals(slew_index, load_index);
+      }
+    }
+  }
+  catch (...) {
+    restoreSweepState();
+    throw;
+  }
+  restoreSweepState();
+  debugPrint(debug_, "timing_model", 1, "%zu comb arcs %zu clk arcs %zu checks",
+	     comb_arcs_.size(),
+	     clk_arcs_.size(),
+	     check_arcs_.size());
+}
+
+// The model paths are found from the arc delays, so exceptions do
+// not apply to them.
+void
+MakeTimingModel::warnExceptions()
+{
+  for (ExceptionPath *exception : *sdc_->exceptions()) {
+    if (exception->isFalse()
+	|| exception->isMultiCycle()
+	|| exception->isPathDelay()) {
+      report_->warn(628, "timing model ignores false path, multicycle and path delay exceptions.");
+      break;
+    }
+  }
+}
+
+void
+MakeTimingModel::findPorts()
+{
+  Instance *top_inst = network_->topInstance();
+  Cell *top_cell = network_->cell(top_inst);
+  CellPortBitIterator *port_iter = network_->portBitIterator(top_cell);
+  while (port_iter->hasNext()) {
+    Port *port = port_iter->next();
+    Pin *pin = network_->findPin(top_inst, port);
+    PortDirection *dir = network_->direction(port);
+    if (pin && graph_->pinDrvrVertex(pin)) {
+      if (dir->isAnyInput()) {
+	if (sdc_->isLeafPinClock(pin))
+	  clks_.push_back(pin);
+	else
+	  inputs_.push_back(pin);
+      }
+      if (dir->isAnyOutput())
+	outputs_.push_back(pin);
+    }
+  }
+  delete port_iter;
+}
+
+// The sweep annotates the input port slews and sets the output port
+// loads. Save the user's values to put them back afterwards.
+void
+MakeTimingModel::saveSweepState()
+{
+  DcalcAPIndex ap_count = corners_->dcalcAnalysisPtCount();
+  for (const Pin *pin : inputs_) {
+    Vertex *vertex = graph_->pinDrvrVertex(pin);
+    vector<float> slews;
+    int annotated = 0;
+    for (RiseFall *rf : RiseFall::range()) {
+      for (DcalcAPIndex ap_index = 0; ap_index < ap_count; ap_index++)
+	slews.push_back(delayAsFloat(graph_->slew(vertex, rf, ap_index)));
+      for (MinMax *min_max : MinMax::range()) {
+	if (vertex->slewAnnotated(rf, min_max))
+	  annotated |= 1 << (min_max->index() * RiseFall::index_count
+			     + rf->index());
+      }
+    }
+    saved_slews_.push_back(slews);
+    saved_slew_annotated_.push_back(annotated);
+  }
+  for (const Pin *pin : outputs_) {
+    Port *port = network_->port(pin);
+    PortExtCap *port_cap = sdc_->portExtCap(port);
+    if (port_cap)
+      saved_loads_.push_back(RiseFallMinMax(port_cap->pinCap()));
+    else
+      saved_loads_.push_back(RiseFallMinMax());
+    saved_no_load_.push_back(port_cap == nullptr);
+  }
+}
+
+void
+MakeTimingModel::restoreSweepState()
+{
+  DcalcAPIndex ap_count = corners_->dcalcAnalysisPtCount();
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    const Pin *pin = inputs_[i];
+    Vertex *vertex = graph_->pinDrvrVertex(pin);
+    vector<float> &slews = saved_slews_[i];
+    int annotated = saved_slew_annotated_[i];
+    vertex->removeSlewAnnotated();
+    for (RiseFall *rf : RiseFall::range()) {
+      for (DcalcAPIndex ap_index = 0; ap_index < ap_count; ap_index++)
+	graph_->setSlew(vertex, rf, ap_index,
+			slews[rf->index() * ap_count + ap_index]);
+      for (MinMax *min_max : MinMax::range()) {
+	int mm_index = min_max->index();
+	if (annotated & (1 << (mm_index * RiseFall::index_count + rf->index())))
+	  vertex->setSlewAnnotated(true, rf, mm_index);
+      }
+    }
+    graph_delay_calc_->delayInvalid(vertex);
+  }
+  for (size_t i = 0; i < outputs_.size(); i++) {
+    Pin *pin = const_cast<Pin*>(outputs_[i]);
+    Port *port = network_->port(pin);
+    if (saved_no_load_[i])
+      sdc_->removePortExtCap(port);
+    else {
+      PortExtCap *port_cap = sdc_->portExtCap(port);
+      if (port_cap)
+	port_cap->pinCap()->setValues(&saved_loads_[i]);
+    }
+    sta_->delaysInvalidFromFanin(pin);
+  }
+}
+
+void
+MakeTimingModel::setInputSlews(float slew)
+{
+  for (const Pin *pin : inputs_) {
+    Vertex *vertex = graph_->pinDrvrVertex(pin);
+    sta_->setAnnotatedSlew(vertex, corner_, MinMaxAll::all(),
+			   RiseFallBoth::riseFall(), slew);
+  }
+}
+
+void
+MakeTimingModel::setOutputLoads(float load)
+{
+  for (const Pin *pin : outputs_) {
+    Port *port = network_->port(pin);
+    sta_->setPortExtPinCap(port, RiseFallBoth::riseFall(),
+			   MinMaxAll::all(), load);
+  }
+}
+
+// Clock to output delays are indexed by output load only.
+void
+MakeTimingModel::findClkArrivals(int load_index)
+{
+  SearchPred2 pred(this);
+  for (size_t clk_index = 0; clk_index < clks_.size(); clk_index++) {
+    const Pin *clk_pin = clks_[clk_index];
+    Vertex *clk_vertex = graph_->pinDrvrVertex(clk_pin);
+    for (RiseFall *clk_rf : RiseFall::range()) {
+      findArrivals(clk_vertex, clk_rf, &pred);
+      ModelClkArrivalMap &clk_arrivals =
+	clk_arrivals_[clk_index * RiseFall::index_count + clk_rf->index()];
+      clk_arrivals.clear();
+      for (Vertex *vertex : cone_) {
+	if (vertex->isRegClk()) {
+	  VertexId vertex_id = graph_->id(vertex);
+	  clk_arrivals[vertex_id] = arrivals_[vertex_id];
+	}
+      }
+      recordOutputDelays(clk_pin, clk_rf, -1, load_index);
+    }
+  }
+}
+
+void
+MakeTimingModel::findDataArrivals(int slew_index,
+				  int load_index)
+{
+  ModelDataPred pred(this);
+  for (const Pin *pin : inputs_) {
+    Vertex *vertex = graph_->pinDrvrVertex(pin);
+    for (RiseFall *rf : RiseFall::range()) {
+      findArrivals(vertex, rf, &pred);
+      recordOutputDelays(pin, rf, slew_index, load_index);
+      if (load_index == 0)
+	findChecks(pin, rf, slew_index);
+    }
+  }
+}
+
+// Find the min/max path delays from from_vertex to its fanout using
+// the arc delays found by delay calculation.
+void
+MakeTimingModel::findArrivals(Vertex *from_vertex,
+			      const RiseFall *from_rf,
+			      SearchPred *pred)
+{
+  for (Vertex *vertex : cone_) {
+    VertexId vertex_id = graph_->id(vertex);
+    arrivals_[vertex_id] = ModelArrival();
+    in_cone_[vertex_id] = false;
+  }
+  cone_.clear();
+  visitCone(from_vertex);
+  for (size_t i = 0; i < cone_.size(); i++) {
+    Vertex *vertex = cone_[i];
+    VertexOutEdgeIterator edge_iter(vertex, graph_);
+    while (edge_iter.hasNext()) {
+      Edge *edge = edge_iter.next();
+      Vertex *to_vertex = edge->to(graph_);
+      if (pred->searchThru(edge)
+	  && pred->searchTo(to_vertex))
+	visitCone(to_vertex);
+    }
+  }
+  // Loops are disabled so levels order the cone.
+  std::stable_sort(cone_.begin(), cone_.end(),
+		   [] (const Vertex *vertex1, const Vertex *vertex2) {
+		     return vertex1->level() < vertex2->level();
+		   });
+
+  ModelArrival &from_arrival = arrivals_[graph_->id(from_vertex)];
+  int from_rf_index = from_rf->index();
+  from_arrival.exists_[from_rf_index] = true;
+  from_arrival.min_[from_rf_index] = 0.0;
+  from_arrival.max_[from_rf_index] = 0.0;
+  for (Vertex *vertex : cone_) {
+    const ModelArrival &arrival = arrivals_[graph_->id(vertex)];
+    if (arrival.exists_[RiseFall::rise()->index()]
+	|| arrival.exists_[RiseFall::fall()->index()]) {
+      VertexOutEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+	Edge *edge = edge_iter.next();
+	Vertex *to_vertex = edge->to(graph_);
+	VertexId to_id = graph_->id(to_vertex);
+	if (in_cone_[to_id]
+	    && pred->searchThru(edge)) {
+	  ModelArrival &to_arrival = arrivals_[to_id];
+	  TimingArcSetArcIterator arc_iter(edge->timingArcSet());
+	  while (arc_iter.hasNext()) {
+	    TimingArc *arc = arc_iter.next();
+	    const RiseFall *arc_from_rf = arc->fromTrans()->asRiseFall();
+	    const RiseFall *arc_to_rf = arc->toTrans()->asRiseFall();
+	    if (arc_from_rf && arc_to_rf
+		&& arrival.exists_[arc_from_rf->index()]) {
+	      int from_index = arc_from_rf->index();
+	      int to_index = arc_to_rf->index();
+	      float min = arrival.min_[from_index]
+		+ delayAsFloat(graph_->arcDelay(edge, arc, min_ap_index_));
+	      float max = arrival.max_[from_index]
+		+ delayAsFloat(graph_->arcDelay(edge, arc, max_ap_index_));
+	      if (to_arrival.exists_[to_index]) {
+		to_arrival.min_[to_index] = std::min(to_arrival.min_[to_index],
+						     min);
+		to_arrival.max_[to_index] = std::max(to_arrival.max_[to_index],
+						     max);
+	      }
+	      else {
+		to_arrival.exists_[to_index] = true;
+		to_arrival.min_[to_index] = min;
+		to_arrival.max_[to_index] = max;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+}
+
+void
+MakeTimingModel::visitCone(Vertex *vertex)
+{
+  VertexId vertex_id = graph_->id(vertex);
+  if (!in_cone_[vertex_id]) {
+    in_cone_[vertex_id] = true;
+    cone_.push_back(vertex);
+  }
+}
+
+// slew_index is -1 for clock pins.
+void
+MakeTimingModel::recordOutputDelays(const Pin *from_pin,
+				    const RiseFall *from_rf,
+				    int slew_index,
+				    int load_index)
+{
+  for (const Pin *to_pin : outputs_) {
+    Vertex *to_vertex = graph_->pinLoadVertex(to_pin);
+    const ModelArrival &arrival = arrivals_[graph_->id(to_vertex)];
+    for (RiseFall *to_rf : RiseFall::range()) {
+      int to_index = to_rf->index();
+      if (arrival.exists_[to_index]
+	  && to_pin != from_pin) {
+	ModelDelayArcMap &arcs = (slew_index == -1) ? clk_arcs_ : comb_arcs_;
+	ModelDelayArc &arc = arcs[ModelPinPair(from_pin, to_pin)];
+	int table_slew_index = (slew_index == -1) ? 0 : slew_index;
+	for (MinMax *min_max : MinMax::range()) {
+	  int mm_index = min_max->index();
+	  bool is_max = (min_max == MinMax::max());
+	  DcalcAPIndex ap_index = is_max ? max_ap_index_ : min_ap_index_;
+	  float delay = is_max ? arrival.max_[to_index] : arrival.min_[to_index];
+	  float slew = delayAsFloat(graph_->slew(to_vertex, to_rf, ap_index));
+	  arc.delays_[mm_index][from_rf->index()][to_index]
+	    .merge(table_slew_index, load_index, delay);
+	  arc.slews_[mm_index][to_index].merge(table_slew_index, load_index,
+					       slew);
+	}
+      }
+    }
+  }
+}
+
+// Setup/hold checks of the registers in the fanout of data_pin
+// referenced to the clock pins.
+//  setup = max data arrival + setup time - min clock arrival
+//  hold  = max clock arrival + hold time - min data arrival
+void
+MakeTimingModel::findChecks(const Pin *data_pin,
+			    const RiseFall *data_rf,
+			    int slew_index)
+{
+  SearchPred1 check_pred(this);
+  for (Vertex *vertex : cone_) {
+    if (vertex->hasChecks()) {
+      const ModelArrival &data_arrival = arrivals_[graph_->id(vertex)];
+      VertexInEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+	Edge *edge = edge_iter.next();
+	const TimingRole *role = edge->role()->genericRole();
+	bool is_setup = (role == TimingRole::setup());
+	bool is_hold = (role == TimingRole::hold());
+	if ((is_setup || is_hold)
+	    && check_pred.searchThru(edge)) {
+	  VertexId clk_vertex_id = graph_->id(edge->from(graph_));
+	  TimingArcSetArcIterator arc_iter(edge->timingArcSet());
+	  while (arc_iter.hasNext()) {
+	    TimingArc *arc = arc_iter.next();
+	    const RiseFall *arc_clk_rf = arc->fromTrans()->asRiseFall();
+	    const RiseFall *arc_data_rf = arc->toTrans()->asRiseFall();
+	    if (arc_clk_rf && arc_data_rf
+		&& data_arrival.exists_[arc_data_rf->index()]) {
+	      int arc_clk_index = arc_clk_rf->index();
+	      int arc_data_index = arc_data_rf->index();
+	      float check_delay = delayAsFloat(graph_->arcDelay(edge, arc,
+				      is_setup ? max_ap_index_ : min_ap_index_));
+	      for (size_t clk_index = 0; clk_index < clks_.size(); clk_index++) {
+		const Pin *clk_pin = clks_[clk_index];
+		for (RiseFall *clk_rf : RiseFall::range()) {
+		  const ModelClkArrivalMap &clk_arrivals =
+		    clk_arrivals_[clk_index * RiseFall::index_count
+				  + clk_rf->index()];
+		  auto clk_itr = clk_arrivals.find(clk_vertex_id);
+		  if (clk_itr != clk_arrivals.end()) {
+		    const ModelArrival &clk_arrival = clk_itr->second;
+		    if (clk_arrival.exists_[arc_clk_index]) {
+		      ModelCheckArc &check =
+			check_arcs_[ModelPinPair(data_pin, clk_pin)];
+		      if (is_setup) {
+			float setup = data_arrival.max_[arc_data_index]
+			  + check_delay
+			  - clk_arrival.min_[arc_clk_index];
+			check.setup_[clk_rf->index()][data_rf->index()]
+			  .merge(slew_index, 0, setup);
+		      }
+		      else {
+			float hold = clk_arrival.max_[arc_clk_index]
+			  + check_delay
+			  - data_arrival.min_[arc_data_index];
+			check.hold_[clk_rf->index()][data_rf->index()]
+			  .merge(slew_index, 0, hold);
+		      }
+		    }
+		  }
+		}
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+void
+MakeTimingModel::writeLiberty(const char *filename,
+			      const char *lib_name,
+			      const MinMax *min_max)
+{
+  stream_ = fopen(filename, "w");
+  if (stream_ == nullptr)
+    throw FileNotWritable(filename);
+  lib_name_ = lib_name;
+  write_min_max_ = min_max;
+  writeHeader();
+  writeBusTypes();
+  writeCell();
+  fprintf(stream_, "}\n");
+  fclose(stream_);
+  stream_ = nullptr;
+}
+
+void
+MakeTimingModel::writeHeader()
+{
+  fprintf(stream_, "library (%s) {\n", lib_name_);
+  fprintf(stream_, "  comment : \"timing model of %s\";\n",
+	  network_->name(network_->cell(network_->topInstance())));
+  fprintf(stream_, "  delay_model : table_lookup;\n");
+  fprintf(stream_, "  time_unit : \"1ns\";\n");
+  fprintf(stream_, "  voltage_unit : \"1V\";\n");
+  fprintf(stream_, "  current_unit : \"1mA\";\n");
+  fprintf(stream_, "  capacitive_load_unit (1,pf);\n");
+  // Slews are in the units of the default library.
+  LibertyLibrary *default_lib = network_->defaultLibertyLibrary();
+  if (default_lib) {
+    fprintf(stream_, "  nom_process : %.3f;\n",
+	    default_lib->nominalProcess());
+    fprintf(stream_, "  nom_voltage : %.3f;\n",
+	    default_lib->nominalVoltage());
+    fprintf(stream_, "  nom_temperature : %.3f;\n",
+	    default_lib->nominalTemperature());
+    for (RiseFall *rf : RiseFall::range()) {
+      fprintf(stream_, "  input_threshold_pct_%s : %.1f;\n", rf->name(),
+	      default_lib->inputThreshold(rf) * 100.0);
+      fprintf(stream_, "  output_threshold_pct_%s : %.1f;\n", rf->name(),
+	      default_lib->outputThreshold(rf) * 100.0);
+      fprintf(stream_, "  slew_lower_threshold_pct_%s : %.1f;\n", rf->name(),
+	      default_lib->slewLowerThreshold(rf) * 100.0);
+      fprintf(stream_, "  slew_upper_threshold_pct_%s : %.1f;\n", rf->name(),
+	      default_lib->slewUpperThreshold(rf) * 100.0);
+    }
+    fprintf(stream_, "  slew_derate_from_library : %.3f;\n",
+	    default_lib->slewDerateFromLibrary());
+  }
+  fprintf(stream_, "\n");
+
+  fprintf(stream_, "  lu_table_template (model_delay) {\n");
+  fprintf(stream_, "    variable_1 : input_net_transition;\n");
+  fprintf(stream_, "    variable_2 : total_output_net_capacitance;\n");
+  writeIndex("index_1", model_slews, model_slew_count,
+	     model_time_scale, "    ");
+  writeIndex("index_2", model_loads, model_load_count,
+	     model_cap_scale, "    ");
+  fprintf(stream_, "  }\n");
+  fprintf(stream_, "  lu_table_template (model_clk_delay) {\n");
+  fprintf(stream_, "    variable_1 : total_output_net_capacitance;\n");
+  writeIndex("index_1", model_loads, model_load_count,
+	     model_cap_scale, "    ");
+  fprintf(stream_, "  }\n");
+  fprintf(stream_, "  lu_table_template (model_check) {\n");
+  fprintf(stream_, "    variable_1 : constrained_pin_transition;\n");
+  writeIndex("index_1", model_slews, model_slew_count,
+	     model_time_scale, "    ");
+  fprintf(stream_, "  }\n");
+}
+
+void
+MakeTimingModel::writeBusTypes()
+{
+  std::set<pair<int, int>> bus_ranges;
+  Cell *top_cell = network_->cell(network_->topInstance());
+  CellPortIterator *port_iter = network_->portIterator(top_cell);
+  while (port_iter->hasNext()) {
+    Port *port = port_iter->next();
+    if (network_->isBus(port))
+      bus_ranges.insert(pair<int, int>(network_->fromIndex(port),
+				       network_->toIndex(port)));
+  }
+  delete port_iter;
+  for (auto &bus_range : bus_ranges) {
+    int from = bus_range.first;
+    int to = bus_range.second;
+    fprintf(stream_, "  type (bus_%d_%d) {\n", from, to);
+    fprintf(stream_, "    base_type : array;\n");
+    fprintf(stream_, "    data_type : bit;\n");
+    fprintf(stream_, "    bit_width : %d;\n", std::abs(from - to) + 1);
+    fprintf(stream_, "    bit_from : %d;\n", from);
+    fprintf(stream_, "    bit_to : %d;\n", to);
+    fprintf(stream_, "    downto : %s;\n", from > to ? "true" : "false");
+    fprintf(stream_, "  }\n");
+  }
+  fprintf(stream_, "\n");
+}
+
+void
+MakeTimingModel::writeCell()
+{
+  fprintf(stream_, "  cell (%s) {\n", cell_name_);
+  fprintf(stream_, "    area : %.3f;\n", area());
+  fprintf(stream_, "    interface_timing : true;\n");
+  Cell *top_cell = network_->cell(network_->topInstance());
+  CellPortIterator *port_iter = network_->portIterator(top_cell);
+  while (port_iter->hasNext()) {
+    Port *port = port_iter->next();
+    if (network_->isBus(port)) {
+      fprintf(stream_, "    bus (%s) {\n", network_->busName(port));
+      fprintf(stream_, "      bus_type : bus_%d_%d;\n",
+	      network_->fromIndex(port),
+	      network_->toIndex(port));
+      PortMemberIterator *member_iter = network_->memberIterator(port);
+      while (member_iter->hasNext()) {
+	Port *member = member_iter->next();
+	writePort(member, "      ");
+      }
+      delete member_iter;
+      fprintf(stream_, "    }\n");
+    }
+    else
+      writePort(port, "    ");
+  }
+  delete port_iter;
+  fprintf(stream_, "  }\n");
+}
+
+float
+MakeTimingModel::area()
+{
+  float area = 0.0;
+  LeafInstanceIterator *leaf_iter = network_->leafInstanceIterator();
+  while (leaf_iter->hasNext()) {
+    Instance *inst = leaf_iter->next();
+    LibertyCell *cell = network_->libertyCell(inst);
+    if (cell)
+      area += cell->area();
+  }
+  delete leaf_iter;
+  return area;
+}
+
+void
+MakeTimingModel::writePort(Port *port,
+			   const char *indent)
+{
+  Pin *pin = network_->findPin(network_->topInstance(), port);
+  PortDirection *dir = network_->direction(port);
+  const char *direction = "internal";
+  if (dir->isInput())
+    direction = "input";
+  else if (dir->isOutput() || dir->isTristate())
+    direction = "output";
+  else if (dir->isBidirect())
+    direction = "inout";
+  fprintf(stream_, "%spin (%s) {\n", indent, network_->name(port));
+  fprintf(stream_, "%s  direction : %s;\n", indent, direction);
+  if (pin) {
+    if (dir->isAnyInput())
+      writeInputPin(pin, indent);
+    if (dir->isAnyOutput())
+      writeOutputPin(pin, indent);
+  }
+  fprintf(stream_, "%s}\n", indent);
+}
+
+void
+MakeTimingModel::writeInputPin(const Pin *pin,
+			       const char *indent)
+{
+  if (sdc_->isLeafPinClock(pin))
+    fprintf(stream_, "%s  clock : true;\n", indent);
+  float cap = 0.0;
+  if (graph_->pinDrvrVertex(pin)) {
+    for (RiseFall *rf : RiseFall::range())
+      cap = std::max(cap, graph_delay_calc_->loadCap(pin, rf, max_dcalc_ap_));
+  }
+  fprintf(stream_, "%s  capacitance : %.5f;\n", indent,
+	  cap / model_cap_scale);
+  for (const Pin *clk_pin : clks_) {
+    auto check_itr = check_arcs_.find(ModelPinPair(pin, clk_pin));
+    if (check_itr != check_arcs_.end())
+      writeCheckArcs(clk_pin, check_itr->second, indent);
+  }
+}
+
+void
+MakeTimingModel::writeOutputPin(const Pin *pin,
+				const char *indent)
+{
+  for (const Pin *clk_pin : clks_) {
+    auto arc_itr = clk_arcs_.find(ModelPinPair(clk_pin, pin));
+    if (arc_itr != clk_arcs_.end())
+      writeClkArcs(clk_pin, arc_itr->second, indent);
+  }
+  for (const Pin *from_pin : inputs_) {
+    auto arc_itr = comb_arcs_.find(ModelPinPair(from_pin, pin));
+    if (arc_itr != comb_arcs_.end())
+      writeCombArc(from_pin, arc_itr->second, indent);
+  }
+}
+
+void
+MakeTimingModel::writeCombArc(const Pin *from_pin,
+			      ModelDelayArc &arc,
+			      const char *indent)
+{
+  int rise = RiseFall::rise()->index();
+  int fall = RiseFall::fall()->index();
+  int mm_index = write_min_max_->index();
+  bool positive = arc.delays_[mm_index][rise][rise].exists_
+    || arc.delays_[mm_index][fall][fall].exists_;
+  bool negative = arc.delays_[mm_index][rise][fall].exists_
+    || arc.delays_[mm_index][fall][rise].exists_;
+  const char *sense = "non_unate";
+  if (positive && !negative)
+    sense = "positive_unate";
+  else if (negative && !positive)
+    sense = "negative_unate";
+  fprintf(stream_, "%s  timing () {\n", indent);
+  fprintf(stream_, "%s    related_pin : \"%s\";\n", indent,
+	  network_->portName(from_pin));
+  fprintf(stream_, "%s    timing_type : combinational;\n", indent);
+  fprintf(stream_, "%s    timing_sense : %s;\n", indent, sense);
+  string table_indent = string(indent) + "    ";
+  for (RiseFall *to_rf : RiseFall::range()) {
+    int to_index = to_rf->index();
+    ModelTable delays(write_min_max_);
+    for (RiseFall *from_rf : RiseFall::range())
+      delays.merge(arc.delays_[mm_index][from_rf->index()][to_index]);
+    if (delays.exists_) {
+      string cell_group = string("cell_") + to_rf->name();
+      string slew_group = string(to_rf->name()) + "_transition";
+      writeTable(cell_group.c_str(), delays, true, true,
+		 table_indent.c_str());
+      writeTable(slew_group.c_str(), arc.slews_[mm_index][to_index],
+		 true, true, table_indent.c_str());
+    }
+  }
+  fprintf(stream_, "%s  }\n", indent);
+}
+
+void
+MakeTimingModel::writeClkArcs(const Pin *clk_pin,
+			      ModelDelayArc &arc,
+			      const char *indent)
+{
+  string table_indent = string(indent) + "    ";
+  int mm_index = write_min_max_->index();
+  for (RiseFall *clk_rf : RiseFall::range()) {
+    int clk_index = clk_rf->index();
+    if (arc.delays_[mm_index][clk_index][RiseFall::rise()->index()].exists_
+	|| arc.delays_[mm_index][clk_index][RiseFall::fall()->index()].exists_) {
+      fprintf(stream_, "%s  timing () {\n", indent);
+      fprintf(stream_, "%s    related_pin : \"%s\";\n", indent,
+	      network_->portName(clk_pin));
+      fprintf(stream_, "%s    timing_type : %s_edge;\n", indent,
+	      clk_rf == RiseFall::rise() ? "rising" : "falling");
+      for (RiseFall *to_rf : RiseFall::range()) {
+	int to_index = to_rf->index();
+	const ModelTable &delays = arc.delays_[mm_index][clk_index][to_index];
+	if (delays.exists_) {
+	  string cell_group = string("cell_") + to_rf->name();
+	  string slew_group = string(to_rf->name()) + "_transition";
+	  writeTable(cell_group.c_str(), delays, false, true,
+		     table_indent.c_str());
+	  writeTable(slew_group.c_str(), arc.slews_[mm_index][to_index],
+		     false, true, table_indent.c_str());
+	}
+      }
+      fprintf(stream_, "%s  }\n", indent);
+    }
+  }
+}
+
+void
+MakeTimingModel::writeCheckArcs(const Pin *clk_pin,
+				ModelCheckArc &arc,
+				const char *indent)
+{
+  for (RiseFall *clk_rf : RiseFall::range()) {
+    const char *edge = (clk_rf == RiseFall::rise()) ? "rising" : "falling";
+    string setup_type = string("setup_") + edge;
+    string hold_type = string("hold_") + edge;
+    writeCheckArc(clk_pin, clk_rf, setup_type.c_str(), arc.setup_, indent);
+    writeCheckArc(clk_pin, clk_rf, hold_type.c_str(), arc.hold_, indent);
+  }
+}
+
+void
+MakeTimingModel::writeCheckArc(const Pin *clk_pin,
+			       const RiseFall *clk_rf,
+			       const char *timing_type,
+			       ModelTable tables[RiseFall::index_count][RiseFall::index_count],
+			       const char *indent)
+{
+  int clk_index = clk_rf->index();
+  if (tables[clk_index][RiseFall::rise()->index()].exists_
+      || tables[clk_index][RiseFall::fall()->index()].exists_) {
+    fprintf(stream_, "%s  timing () {\n", indent);
+    fprintf(stream_, "%s    related_pin : \"%s\";\n", indent,
+	    network_->portName(clk_pin));
+    fprintf(stream_, "%s    timing_type : %s;\n", indent, timing_type);
+    string table_indent = string(indent) + "    ";
+    for (RiseFall *data_rf : RiseFall::range()) {
+      const ModelTable &table = tables[clk_index][data_rf->index()];
+      if (table.exists_) {
+	string group = string(data_rf->name()) + "_constraint";
+	writeTable(group.c_str(), table, true, false, table_indent.c_str());
+      }
+    }
+    fprintf(stream_, "%s  }\n", indent);
+  }
+}
+
+void
+MakeTimingModel::writeTable(const char *group_name,
+			    const ModelTable &table,
+			    bool slew_index,
+			    bool load_index,
+			    const char *indent)
+{
+  const char *template_name = "model_delay";
+  if (!slew_index)
+    template_name = "model_clk_delay";
+  else if (!load_index)
+    template_name = "model_check";
+  string value_indent = string(indent) + "  ";
+  fprintf(stream_, "%s%s (%s) {\n", indent, group_name, template_name);
+  if (slew_index && load_index) {
+    writeIndex("index_1", model_slews, model_slew_count, model_time_scale,
+	       value_indent.c_str());
+    writeIndex("index_2", model_loads, model_load_count, model_cap_scale,
+	       value_indent.c_str());
+  }
+  else if (slew_index)
+    writeIndex("index_1", model_slews, model_slew_count, model_time_scale,
+	       value_indent.c_str());
+  else
+    writeIndex("index_1", model_loads, model_load_count, model_cap_scale,
+	       value_indent.c_str());
+  int row_count = (slew_index && load_index) ? model_slew_count : 1;
+  int column_count = load_index ? model_load_count : model_slew_count;
+  fprintf(stream_, "%s  values (", indent);
+  for (int row = 0; row < row_count; row++) {
+    if (row > 0)
+      fprintf(stream_, ", \\\n%s          ", indent);
+    fprintf(stream_, "\"");
+    for (int column = 0; column < column_count; column++) {
+      int slew = slew_index ? (load_index ? row : column) : 0;
+      int load = load_index ? column : 0;
+      float value = table.values_[slew][load];
+      if (value == table.min_max_->initValue())
+	value = 0.0;
+      fprintf(stream_, "%s%.5f", column > 0 ? ", " : "",
+	      value / model_time_scale);
+    }
+    fprintf(stream_, "\"");
+  }
+  fprintf(stream_, ");\n");
+  fprintf(stream_, "%s}\n", indent);
+}
+
+void
+MakeTimingModel::writeIndex(const char *index_name,
+			    const float *values,
+			    int count,
+			    float scale,
+			    const char *indent)
+{
+  fprintf(stream_, "%s%s (\"", indent, index_name);
+  for (int i = 0; i < count; i++)
+    fprintf(stream_, "%s%.5f", i > 0 ? ", " : "", values[i] / scale);
+  fprintf(stream_, "\");\n");
+}
+
+////////////////////////////////////////////////////////////////
+
+ModelTable::ModelTable(const MinMax *min_max) :
+  min_max_(min_max),
+  exists_(false)
+{
+  for (int i = 0; i < model_slew_count; i++) {
+    for (int j = 0; j < model_load_count; j++)
+      values_[i][j] = min_max->initValue();
+  }
+}
+
+void
+ModelTable::merge(int slew_index,
+		  int load_index,
+		  float value)
+{
+  exists_ = true;
+  float &table_value = values_[slew_index][load_index];
+  table_value = min_max_->minMax(table_value, value);
+}
+
+void
+ModelTable::merge(const ModelTable &table)
+{
+  if (table.exists_) {
+    exists_ = true;
+    for (int i = 0; i < model_slew_count; i++) {
+      for (int j = 0; j < model_load_count; j++)
+	values_[i][j] = min_max_->minMax(values_[i][j], table.values_[i][j]);
+    }
+  }
+}
+
+ModelDelayArc::ModelDelayArc()
+{
+  int min_index = MinMax::minIndex();
+  for (int to_index = 0; to_index < RiseFall::index_count; to_index++) {
+    for (int from_index = 0; from_index < RiseFall::index_count; from_index++)
+      delays_[min_index][from_index][to_index] = ModelTable(MinMax::min());
+    slews_[min_index][to_index] = ModelTable(MinMax::min());
+  }
+}
+
+ModelArrival::ModelArrival()
+{
+  for (int rf_index = 0; rf_index < RiseFall::index_count; rf_index++) {
+    exists_[rf_index] = false;
+    min_[rf_index] = 0.0;
+    max_[rf_index] = 0.0;
+  }
+}
+
+} // namespace
@@ -0,0 +1,47 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace sta {
+
+class Sta;
+class Corner;
+
+// Extract a timing model of the top level design for corner and write
+// it as a liberty library with one cell named cell_name.
+// The model has
+//  input to output combinational arcs
+//  clock to output arcs
+//  input setup/hold checks to clocks
+// Delay tables are indexed by input transition and output load.
+// Clocks must be defined on the clock input ports.
+// filename has the max delays and transitions. If min_filename is
+// not null the min delays and transitions are written to it as library
+// lib_name_min, for use with read_liberty -min.
+// Setup checks use max data/min clock paths and hold checks use
+// min data/max clock paths in both libraries.
+// Paths are found from the arc delays, so false path, multicycle and
+// path delay exceptions are not reflected in the model (with a warning).
+void
+writeTimingModel(const char *filename,
+		 const char *min_filename,
+		 const char *lib_name,
+		 const char *cell_name,
+		 const Corner *corner,
+		 Sta *sta);
+
+} // namespace
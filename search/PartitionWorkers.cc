@@ -0,0 +1,291 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "PartitionWorkers.hh"
+
+#include <algorithm>
+
+#if !(defined(_WINDOWS) || defined(_WIN32))
+  #include <unistd.h>
+  #include <sys/types.h>
+  #include <sys/wait.h>
+  #include <cerrno>
+#endif
+
+#include "Report.hh"
+#include "Debug.hh"
+#include "MinMax.hh"
+#include "Graph.hh"
+#include "Corner.hh"
+#include "PathAnalysisPt.hh"
+#include "ClkNetwork.hh"
+#include "Search.hh"
+#include "Sta.hh"
+
+namespace sta {
+
+PartitionWorkers::PartitionWorkers(Sta *sta) :
+  StaState(sta),
+  sta_(sta),
+  partitions_(sta),
+  endpoint_count_(0)
+{
+}
+
+// Assign the partitions, largest first, to the worker with the fewest
+// vertices.
+void
+PartitionWorkers::assignPartitions(int worker_count)
+{
+  const TimingPartitionSeq &partitions = partitions_.partitions();
+  partition_workers_.resize(partitions.size());
+  worker_vertex_counts_.assign(worker_count, 0);
+  for (size_t i = 0; i < partitions.size(); i++) {
+    auto min_iter = std::min_element(worker_vertex_counts_.begin(),
+				     worker_vertex_counts_.end());
+    int worker = min_iter - worker_vertex_counts_.begin();
+    partition_workers_[i] = worker;
+    worker_vertex_counts_[worker] += partitions[i].vertex_count_;
+  }
+}
+
+// The clock network is timed by every worker. Endpoints in the clock
+// network belong to worker 0.
+bool
+PartitionWorkers::isWorkerVertex(const Vertex *vertex,
+				 int worker) const
+{
+  int partition_index = partitions_.partitionIndex(vertex);
+  if (partition_index == TimingPartitions::partition_none)
+    return worker == 0;
+  else
+    return partition_workers_[partition_index] == worker;
+}
+
+Slack
+PartitionWorkers::worstSlack(const MinMax *min_max) const
+{
+  Slack worst_slack = MinMax::min()->initValue();
+  for (Corner *corner : *corners_) {
+    PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+    Slack slack = worst_slacks_[path_ap_index];
+    if (delayLess(slack, worst_slack, this))
+      worst_slack = slack;
+  }
+  return worst_slack;
+}
+
+Slack
+PartitionWorkers::totalNegativeSlack(const MinMax *min_max) const
+{
+  Slack tns = 0.0;
+  for (Corner *corner : *corners_) {
+    PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+    Slack tns1 = tns_[path_ap_index];
+    if (delayLess(tns1, tns, this))
+      tns = tns1;
+  }
+  return tns;
+}
+
+void
+PartitionWorkers::reportSlacks(int digits)
+{
+  report_->reportLine("Workers    %zu", worker_vertex_counts_.size());
+  report_->reportLine("Partitions %zu", partitions_.partitions().size());
+  report_->reportLine("Endpoints  %zu", endpoint_count_);
+  report_->reportBlankLine();
+  report_->reportLine("Worker   Vertices");
+  report_->reportLine("-----------------");
+  for (size_t i = 0; i < worker_vertex_counts_.size(); i++)
+    report_->reportLine("%6zu %10zu", i, worker_vertex_counts_[i]);
+  report_->reportBlankLine();
+  for (const MinMax *min_max : MinMax::range()) {
+    report_->reportLine("%s worst slack %s",
+			min_max->asString(),
+			delayAsString(worstSlack(min_max), this, digits));
+    report_->reportLine("%s tns %s",
+			min_max->asString(),
+			delayAsString(totalNegativeSlack(min_max), this, digits));
+  }
+}
+
+// Merge the endpoint slacks for each path analysis point.
+void
+PartitionWorkers::mergeSlacks(const float *slacks)
+{
+  PathAPIndex path_ap_count = corners_->pathAnalysisPtCount();
+  for (PathAPIndex i = 0; i < path_ap_count; i++) {
+    Slack slack = slacks[i];
+    if (delayLess(slack, worst_slacks_[i], this))
+      worst_slacks_[i] = slack;
+    if (delayLess(slack, 0.0, this))
+      tns_[i] += slack;
+  }
+  endpoint_count_++;
+}
+
+#if defined(_WINDOWS) || defined(_WIN32)
+
+void
+PartitionWorkers::findSlacks(int)
+{
+  report_->error(626, "partition workers are not supported on Windows.");
+}
+
+#else
+
+// Records written by the workers are the endpoint slacks for each
+// path analysis point.
+static void
+writeAll(int fd,
+	 const void *buffer,
+	 size_t size)
+{
+  const char *ptr = static_cast<const char*>(buffer);
+  while (size > 0) {
+    ssize_t length = write(fd, ptr, size);
+    if (length < 0) {
+      if (errno != EINTR)
+	_exit(1);
+    }
+    else {
+      ptr += length;
+      size -= length;
+    }
+  }
+}
+
+void
+PartitionWorkers::findSlacks(int worker_count)
+{
+  partitions_.findPartitions();
+  assignPartitions(worker_count);
+  PathAPIndex path_ap_count = corners_->pathAnalysisPtCount();
+  worst_slacks_.assign(path_ap_count, MinMax::min()->initValue());
+  tns_.assign(path_ap_count, 0.0);
+  endpoint_count_ = 0;
+
+  std::vector<pid_t> pids;
+  std::vector<int> fds;
+  for (int worker = 0; worker < worker_count; worker++) {
+    int pipe_fds[2];
+    if (pipe(pipe_fds) < 0)
+      break;
+    pid_t pid = fork();
+    if (pid == 0) {
+      // Worker process.
+      close(pipe_fds[0]);
+      for (int fd : fds)
+	close(fd);
+      runWorker(worker, pipe_fds[1]);
+    }
+    close(pipe_fds[1]);
+    if (pid < 0) {
+      close(pipe_fds[0]);
+      break;
+    }
+    pids.push_back(pid);
+    fds.push_back(pipe_fds[0]);
+    debugPrint(debug_, "partition", 1, "worker %d pid %d %zu vertices",
+	       worker,
+	       static_cast<int>(pid),
+	       worker_vertex_counts_[worker]);
+  }
+  // Read the pipes in order. Workers that finish first wait for the
+  // pipe to be read.
+  for (int fd : fds) {
+    readWorker(fd);
+    close(fd);
+  }
+  int failed_count = worker_count - pids.size();
+  for (pid_t pid : pids) {
+    int status;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+    if (!(WIFEXITED(status) && WEXITSTATUS(status) == 0))
+      failed_count++;
+  }
+  if (failed_count > 0)
+    report_->error(627, "%d of %d partition workers failed.",
+		   failed_count,
+		   worker_count);
+}
+
+void
+PartitionWorkers::runWorker(int worker,
+			    int fd)
+{
+  try {
+    // The dispatch queue threads are not copied into this process.
+    sta_->forkedProcessInit();
+    VertexIterator vertex_iter(graph_);
+    while (vertex_iter.hasNext()) {
+      Vertex *vertex = vertex_iter.next();
+      if (!isWorkerVertex(vertex, worker)
+	  && partitions_.partitionIndex(vertex)
+	  != TimingPartitions::partition_none)
+	vertex->setIsDisabledConstraint(true);
+    }
+    sta_->findRequireds();
+    PathAPIndex path_ap_count = corners_->pathAnalysisPtCount();
+    SlackSeq slacks(path_ap_count);
+    std::vector<float> record(path_ap_count);
+    for (Vertex *vertex : *search_->endpoints()) {
+      if (isWorkerVertex(vertex, worker)) {
+	search_->wnsSlacks(vertex, slacks);
+	for (PathAPIndex i = 0; i < path_ap_count; i++)
+	  record[i] = delayAsFloat(slacks[i]);
+	writeAll(fd, record.data(), path_ap_count * sizeof(float));
+      }
+    }
+  }
+  catch (...) {
+    _exit(1);
+  }
+  close(fd);
+  // Skip exit handlers and destructors that belong to the parent.
+  _exit(0);
+}
+
+void
+PartitionWorkers::readWorker(int fd)
+{
+  PathAPIndex path_ap_count = corners_->pathAnalysisPtCount();
+  size_t record_size = path_ap_count * sizeof(float);
+  std::vector<float> record(path_ap_count);
+  char *buffer = reinterpret_cast<char*>(record.data());
+  size_t read_size = 0;
+  for (;;) {
+    ssize_t length = read(fd, buffer + read_size, record_size - read_size);
+    if (length < 0) {
+      if (errno != EINTR)
+	break;
+    }
+    else if (length == 0)
+      break;
+    else {
+      read_size += length;
+      if (read_size == record_size) {
+	mergeSlacks(record.data());
+	read_size = 0;
+      }
+    }
+  }
+}
+
+#endif
+
+} // namespace
@@ -0,0 +1,78 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <vector>
+
+#include "DisallowCopyAssign.hh"
+#include "GraphClass.hh"
+#include "Delay.hh"
+#include "StaState.hh"
+#include "TimingPartition.hh"
+
+namespace sta {
+
+class Sta;
+class MinMax;
+
+// Evaluate endpoint slacks in parallel local worker processes, one
+// group of register boundary partitions (see TimingPartition.hh) per
+// worker. Each worker is forked after the graph is built, annotated and
+// the delays are found, so it shares the whole graph and its delays
+// with the parent copy-on-write. There are no per-partition graphs, so
+// a worker does not use less memory than the parent. A worker disables
+// the data vertices of the partitions assigned to other workers, finds
+// arrivals and required times for the clock network and its own
+// partitions, and writes the slacks of its endpoints to a pipe.
+// Partitions only share the clock network, which every worker times,
+// so no arrivals are exchanged between workers. The parent merges the
+// endpoint slacks.
+class PartitionWorkers : public StaState
+{
+public:
+  explicit PartitionWorkers(Sta *sta);
+  // Requires the delays and the clock network.
+  void findSlacks(int worker_count);
+  Slack worstSlack(const MinMax *min_max) const;
+  Slack totalNegativeSlack(const MinMax *min_max) const;
+  size_t endpointCount() const { return endpoint_count_; }
+  void reportSlacks(int digits);
+
+protected:
+  void assignPartitions(int worker_count);
+  bool isWorkerVertex(const Vertex *vertex,
+		      int worker) const;
+  void runWorker(int worker,
+		 int fd);
+  void readWorker(int fd);
+  void mergeSlacks(const float *slacks);
+
+  Sta *sta_;
+  TimingPartitions partitions_;
+  // Worker index indexed by partition index.
+  std::vector<int> partition_workers_;
+  std::vector<size_t> worker_vertex_counts_;
+  size_t endpoint_count_;
+  // Merged slacks indexed by path analysis point index.
+  std::vector<Slack> worst_slacks_;
+  std::vector<Slack> tns_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PartitionWorkers);
+};
+
+} // namespace
@@ -805,7 +805,7 @@ PathGroups::makeGroupPathEnds(ExceptionTo *to,
   Graph *graph = this->graph();
   Search *search = this->search();
   if (exceptionToEmpty(to))
-    makeGroupPathEnds(search->endpoints(), corner, min_max, visitor);
+    makeGroupPathEnds(search->endpointSeq(), corner, min_max, visitor);
   else {
     // Only visit -to filter pins.
     VertexSet endpoints;
@@ -823,7 +823,9 @@ PathGroups::makeGroupPathEnds(ExceptionTo *to,
 	  && search->isEndpoint(bidirect_drvr_vertex))
 	endpoints.insert(bidirect_drvr_vertex);
     }
-    makeGroupPathEnds(&endpoints, corner, min_max, visitor);
+    VertexSeq endpoint_seq;
+    endpoint_seq.insert(endpoint_seq.end(), endpoints.begin(), endpoints.end());
+    makeGroupPathEnds(endpoint_seq, corner, min_max, visitor);
   }
 }
 
@@ -891,24 +893,33 @@ MakeEndpointPathEnds::visit(Vertex *vertex)
 
 ////////////////////////////////////////////////////////////////
 
+// Endpoints per task. Smaller chunks balance the load better when
+// a few endpoints have many more paths than the rest.
+static const size_t endpoint_chunk_size = 64;
+
 void
-PathGroups::makeGroupPathEnds(VertexSet *endpoints,
+PathGroups::makeGroupPathEnds(VertexSeq &endpoints,
 			      const Corner *corner,
 			      const MinMaxAll *min_max,
 			      PathEndVisitor *visitor)
 {
-  if (thread_count_ == 1) {
+  size_t endpoint_count = endpoints.size();
+  if (thread_count_ == 1
+      || endpoint_count <= endpoint_chunk_size) {
     MakeEndpointPathEnds end_visitor(visitor, corner, min_max, this);
-    for (auto endpoint : *endpoints)
+    for (Vertex *endpoint : endpoints)
       end_visitor.visit(endpoint);
   }
   else {
     Vector<MakeEndpointPathEnds*> visitors;
     for (int i = 0; i < thread_count_; i++)
       visitors.push_back(new MakeEndpointPathEnds(visitor, corner, min_max, this));
-    for (auto endpoint : *endpoints) {
-      dispatch_queue_->dispatch( [endpoint, &visitors](int i)
-				 { visitors[i]->visit(endpoint); } );
+    for (size_t start = 0; start < endpoint_count; start += endpoint_chunk_size) {
+      size_t end = std::min(start + endpoint_chunk_size, endpoint_count);
+      dispatch_queue_->dispatch([&endpoints, &visitors, start, end](int i) {
+	for (size_t j = start; j < end; j++)
+	  visitors[i]->visit(endpoints[j]);
+      });
     }
     dispatch_queue_->finishTasks();
     visitors.deleteContents();
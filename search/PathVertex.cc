@@ -266,9 +266,11 @@ PathVertex::setRequired(const Required &required,
   Arrival *arrivals = graph->arrivals(vertex_);
   int arrival_count = tag_group->arrivalCount();
   if (!vertex_->hasRequireds()) {
+    ArrivalId prev_id = vertex_->arrivals();
     Arrival *new_arrivals = graph->makeArrivals(vertex_, arrival_count * 2);
     for (int i = 0; i < arrival_count; i++)
       new_arrivals[i] =arrivals[i];
+    graph->deleteArrivals(prev_id, arrival_count);
     vertex_->setHasRequireds(true);
     arrivals = new_arrivals;
   }
@@ -278,10 +280,22 @@ PathVertex::setRequired(const Required &required,
 
 void
 PathVertex::deleteRequireds(Vertex *vertex,
-			    const StaState *)
+			    const StaState *sta)
 {
+  // Shrink the array back to the arrivals so its size always matches
+  // hasRequireds when it is given back to the arrival table.
+  Graph *graph = sta->graph();
+  TagGroup *tag_group = sta->search()->tagGroup(vertex);
+  if (tag_group) {
+    int arrival_count = tag_group->arrivalCount();
+    ArrivalId prev_id = vertex->arrivals();
+    Arrival *arrivals = graph->arrivals(vertex);
+    Arrival *new_arrivals = graph->makeArrivals(vertex, arrival_count);
+    for (int i = 0; i < arrival_count; i++)
+      new_arrivals[i] = arrivals[i];
+    graph->deleteArrivals(prev_id, arrival_count * 2);
+  }
   vertex->setHasRequireds(false);
-  // Don't bother reclaiming requieds from arrival table.
 }
 
 bool
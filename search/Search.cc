@@ -206,6 +206,32 @@ ClkArrivalSearchPred::searchThru(Edge *edge)
     && EvalPred::searchThru(edge);
 }
 
+// SearchThru unless to_vertex is outside of the filter cone.
+class FilterConeSearchThru : public SearchThru
+{
+public:
+  FilterConeSearchThru(TagGroupBldr *tag_bldr,
+		       const StaState *sta);
+  virtual bool searchTo(const Vertex *to_vertex);
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(FilterConeSearchThru);
+};
+
+FilterConeSearchThru::FilterConeSearchThru(TagGroupBldr *tag_bldr,
+					   const StaState *sta) :
+  SearchThru(tag_bldr, sta)
+{
+}
+
+bool
+FilterConeSearchThru::searchTo(const Vertex *to_vertex)
+{
+  Search *search = sta_->search();
+  return SearchThru::searchTo(to_vertex)
+    && search->inFilterCone(to_vertex);
+}
+
 ////////////////////////////////////////////////////////////////
 
 Search::Search(StaState *sta) :
@@ -231,6 +257,8 @@ Search::init(StaState *sta)
   requireds_exist_ = false;
   requireds_seeded_ = false;
   tns_exists_ = false;
+  timing_frozen_ = false;
+  search_corner_ = nullptr;
   worst_slacks_ = nullptr;
   arrival_iter_ = new BfsFwdIterator(BfsIndex::arrival, nullptr, sta);
   required_iter_ = new BfsBkwdIterator(BfsIndex::required, search_adj_, sta);
@@ -251,7 +279,12 @@ Search::init(StaState *sta)
   filter_ = nullptr;
   filter_from_ = nullptr;
   filter_to_ = nullptr;
+  filter_cone_fanout_ = false;
   found_downstream_clk_pins_ = false;
+  arrival_seed_count_ = 0;
+  arrival_visit_count_ = 0;
+  arrival_change_count_ = 0;
+  observer_ = nullptr;
 }
 
 // Init "options".
@@ -261,6 +294,7 @@ Search::initVars()
   unconstrained_paths_ = false;
   crpr_path_pruning_enabled_ = true;
   crpr_approx_missing_requireds_ = true;
+  arrival_tolerance_ = 0.0;
 }
 
 Search::~Search()
@@ -286,6 +320,7 @@ Search::~Search()
   delete genclks_;
   deleteFilter();
   deletePathGroups();
+  delete observer_;
 }
 
 void
@@ -293,6 +328,8 @@ Search::clear()
 {
   initVars();
 
+  timing_frozen_ = false;
+  search_corner_ = nullptr;
   clk_arrivals_valid_ = false;
   arrivals_at_endpoints_exist_ = false;
   arrivals_seeded_ = false;
@@ -339,6 +376,36 @@ Search::setCrprApproxMissingRequireds(bool enabled)
   crpr_approx_missing_requireds_ = enabled;
 }
 
+void
+Search::resetArrivalUpdateStats()
+{
+  arrival_seed_count_ = 0;
+  arrival_visit_count_ = 0;
+  arrival_change_count_ = 0;
+}
+
+void
+Search::setArrivalTolerance(float tolerance)
+{
+  arrival_tolerance_ = tolerance;
+}
+
+void
+Search::copyOptions(const Search *search)
+{
+  unconstrained_paths_ = search->unconstrained_paths_;
+  crpr_path_pruning_enabled_ = search->crpr_path_pruning_enabled_;
+  crpr_approx_missing_requireds_ = search->crpr_approx_missing_requireds_;
+  arrival_tolerance_ = search->arrival_tolerance_;
+}
+
+void
+Search::setObserver(SearchObserver *observer)
+{
+  delete observer_;
+  observer_ = observer;
+}
+
 void
 Search::deleteTags()
 {
@@ -372,6 +439,9 @@ Search::deleteFilter()
   }
   delete filter_to_;
   filter_to_ = nullptr;
+  filter_cone_pins_.clear();
+  filter_cone_fanout_ = false;
+  filter_cone_.clear();
 }
 
 void
@@ -411,9 +481,60 @@ Search::deletePaths(Vertex *vertex)
   tnsNotifyBefore(vertex);
   if (worst_slacks_)
     worst_slacks_->worstSlackNotifyBefore(vertex);
+  deletePathArrays(vertex);
   vertex->deletePaths();
 }
 
+// Give the vertex arrival and prev path arrays back to the graph for reuse.
+void
+Search::deletePathArrays(Vertex *vertex)
+{
+  uint32_t arrival_count, prev_path_count;
+  pathArrayCounts(vertex, arrival_count, prev_path_count);
+  graph_->deleteArrivals(vertex->arrivals(), arrival_count);
+  graph_->deletePrevPaths(vertex->prevPaths(), prev_path_count);
+  // The prev path array is optional, so it must not be left pointing
+  // at an array that has been given back.
+  vertex->setPrevPaths(prev_path_null);
+}
+
+void
+Search::pathArrayCounts(const Vertex *vertex,
+			// Return values.
+			uint32_t &arrival_count,
+			uint32_t &prev_path_count) const
+{
+  TagGroup *tag_group = tagGroup(vertex);
+  if (tag_group) {
+    prev_path_count = tag_group->arrivalCount();
+    // Requireds follow the arrivals in the same array.
+    arrival_count = vertex->hasRequireds()
+      ? prev_path_count * 2
+      : prev_path_count;
+  }
+  else {
+    arrival_count = 0;
+    prev_path_count = 0;
+  }
+}
+
+void
+Search::compactPaths()
+{
+  if (arrivals_exist_)
+    graph_->compactPaths([this] (const Vertex *vertex,
+				 uint32_t &arrival_count,
+				 uint32_t &prev_path_count) {
+      pathArrayCounts(vertex, arrival_count, prev_path_count);
+    });
+}
+
+void
+Search::reportPathMemory() const
+{
+  graph_->reportPathMemory();
+}
+
 ////////////////////////////////////////////////////////////////
 
 // from/thrus/to are owned and deleted by Search.
@@ -442,23 +563,38 @@ Search::findPathEnds(ExceptionFrom *from,
 {
   unconstrained_paths_ = unconstrained;
   // Delete results from last findPathEnds.
-  // Filtered arrivals are deleted by Sta::searchPreamble.
+  // Filtered arrivals are deleted by Sta::searchPreamble unless
+  // they can be reused.
   deletePathGroups();
   checkFromThrusTo(from, thrus, to);
-  filter_from_ = from;
-  filter_to_ = to;
-  if ((from
-       && (from->pins()
-	   || from->instances()))
-      || thrus) {
-    filter_ = sdc_->makeFilterPath(from, thrus, nullptr);
-    findFilteredArrivals();
+  if (filter_) {
+    // Filtered arrivals kept by Sta::searchPreamble are reused.
+    debugPrint(debug_, "search", 1, "reuse filtered arrivals");
+    delete from;
+    if (thrus) {
+      thrus->deleteContents();
+      delete thrus;
+    }
+    delete filter_to_;
+    filter_to_ = to;
+  }
+  else {
+    filter_from_ = from;
+    filter_to_ = to;
+    if ((from
+	 && (from->pins()
+	     || from->instances()))
+	|| thrus) {
+      filter_ = sdc_->makeFilterPath(from, thrus, nullptr);
+      filterConePins(thrus, to, filter_cone_pins_, filter_cone_fanout_);
+      findFilteredArrivals();
+    }
+    else
+      // These cases do not require filtered arrivals.
+      //  -from clocks
+      //  -to
+      findAllArrivals();
   }
-  else
-    // These cases do not require filtered arrivals.
-    //  -from clocks
-    //  -to
-    findAllArrivals();
   if (!sdc_->recoveryRemovalChecksEnabled())
     recovery = removal = false;
   if (!sdc_->gatedClkChecksEnabled())
@@ -556,7 +692,15 @@ Search::deleteFilterClkInfos()
 void
 Search::findFilteredArrivals()
 {
-  findArrivals1();
+  if (filter_cone_pins_.empty())
+    findArrivals1();
+  else {
+    // Bring the unfiltered arrivals up to date before the search is
+    // restricted to the filter cone. The cone is only found after
+    // this update so it does not limit the unfiltered search.
+    findAllArrivals();
+    findFilterCone();
+  }
   seedFilterStarts();
   Level max_level = levelize_->maxLevel();
   // Search always_to_endpoint to search from exisiting arrivals at
@@ -571,6 +715,214 @@ Search::findFilteredArrivals()
     debugPrint(debug_, "search", 1, "found %d arrivals", arrival_count);
   }
   arrivals_exist_ = true;
+  filter_cone_.clear();
+  filter_cone_.shrink_to_fit();
+}
+
+// The filtered search only has to reach the -to pins, or the
+// fanout of the last -thru.
+void
+Search::filterConePins(ExceptionThruSeq *thrus,
+		       ExceptionTo *to,
+		       // Return values.
+		       PinSet &pins,
+		       bool &fanout)
+{
+  pins.clear();
+  fanout = false;
+  if (to
+      && (to->hasPins()
+	  || to->hasInstances())
+      && !to->hasClocks())
+    to->allPins(network_, &pins);
+  else if (thrus) {
+    ExceptionThru *last_thru = thrus->back();
+    last_thru->allPins(network_, &pins);
+    fanout = true;
+  }
+}
+
+class FilterConeThruHierPin : public HierPinThruVisitor
+{
+public:
+  FilterConeThruHierPin(Graph *graph,
+			VertexSeq &vertices);
+
+protected:
+  virtual void visit(Pin *drvr,
+		     Pin *load);
+  void pinVertices(Pin *pin);
+
+  Graph *graph_;
+  VertexSeq &vertices_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(FilterConeThruHierPin);
+};
+
+FilterConeThruHierPin::FilterConeThruHierPin(Graph *graph,
+					     VertexSeq &vertices) :
+  HierPinThruVisitor(),
+  graph_(graph),
+  vertices_(vertices)
+{
+}
+
+void
+FilterConeThruHierPin::visit(Pin *drvr,
+			     Pin *load)
+{
+  pinVertices(drvr);
+  pinVertices(load);
+}
+
+void
+FilterConeThruHierPin::pinVertices(Pin *pin)
+{
+  Vertex *vertex, *bidirect_drvr_vertex;
+  graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+  if (vertex)
+    vertices_.push_back(vertex);
+  if (bidirect_drvr_vertex)
+    vertices_.push_back(bidirect_drvr_vertex);
+}
+
+void
+Search::findFilterCone()
+{
+  filter_cone_.clear();
+  VertexSeq roots;
+  FilterConeThruHierPin visitor(graph_, roots);
+  for (Pin *pin : filter_cone_pins_) {
+    if (network_->isHierarchical(pin))
+      visitDrvrLoadsThruHierPin(pin, network_, &visitor);
+    else {
+      Vertex *vertex, *bidirect_drvr_vertex;
+      graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+      if (vertex)
+	roots.push_back(vertex);
+      if (bidirect_drvr_vertex)
+	roots.push_back(bidirect_drvr_vertex);
+    }
+  }
+  if (!roots.empty()) {
+    findFilterCone(roots, true, filter_cone_);
+    if (filter_cone_fanout_) {
+      std::vector<bool> fanout_cone;
+      findFilterCone(roots, false, fanout_cone);
+      if (fanout_cone.size() > filter_cone_.size())
+	filter_cone_.resize(fanout_cone.size(), false);
+      for (size_t i = 0; i < fanout_cone.size(); i++) {
+	if (fanout_cone[i])
+	  filter_cone_[i] = true;
+      }
+    }
+    debugPrint(debug_, "search", 1, "filter cone from %zu pins",
+	       filter_cone_pins_.size());
+  }
+}
+
+static void
+filterConeMark(Vertex *vertex,
+	       const Graph *graph,
+	       std::vector<bool> &cone,
+	       VertexSeq &stack)
+{
+  VertexId vertex_id = graph->id(vertex);
+  if (vertex_id >= cone.size())
+    cone.resize(vertex_id + 1, false);
+  if (!cone[vertex_id]) {
+    cone[vertex_id] = true;
+    stack.push_back(vertex);
+  }
+}
+
+// Mark the fanin or fanout cone of roots indexed by VertexId.
+// Timing checks are not part of a path so they are not traversed.
+void
+Search::findFilterCone(VertexSeq &roots,
+		       bool fanin,
+		       std::vector<bool> &cone)
+{
+  cone.assign(graph_->vertexIdEnd(), false);
+  VertexSeq stack;
+  for (Vertex *root : roots)
+    filterConeMark(root, graph_, cone, stack);
+  while (!stack.empty()) {
+    Vertex *vertex = stack.back();
+    stack.pop_back();
+    if (fanin) {
+      VertexInEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+	Edge *edge = edge_iter.next();
+	if (!edge->role()->isTimingCheck())
+	  filterConeMark(edge->from(graph_), graph_, cone, stack);
+      }
+    }
+    else {
+      VertexOutEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+	Edge *edge = edge_iter.next();
+	if (!edge->role()->isTimingCheck())
+	  filterConeMark(edge->to(graph_), graph_, cone, stack);
+      }
+    }
+  }
+}
+
+bool
+Search::inFilterCone(const Vertex *vertex) const
+{
+  if (filter_cone_.empty())
+    return true;
+  else {
+    VertexId vertex_id = graph_->id(vertex);
+    return vertex_id < filter_cone_.size()
+      && filter_cone_[vertex_id];
+  }
+}
+
+bool
+Search::filteredArrivalsReusable(ExceptionFrom *from,
+				 ExceptionThruSeq *thrus,
+				 ExceptionTo *to)
+{
+  if (filter_
+      && invalid_arrivals_.empty()
+      && arrival_iter_->empty()
+      && filterMatches(from, thrus)) {
+    if (filter_cone_pins_.empty())
+      // The last filtered search was not restricted.
+      return true;
+    else {
+      PinSet cone_pins;
+      bool cone_fanout;
+      filterConePins(thrus, to, cone_pins, cone_fanout);
+      return cone_fanout == filter_cone_fanout_
+	&& PinSet::equal(&cone_pins, &filter_cone_pins_);
+    }
+  }
+  return false;
+}
+
+bool
+Search::filterMatches(ExceptionFrom *from,
+		      ExceptionThruSeq *thrus)
+{
+  ExceptionFrom *filter_from = filter_->from();
+  ExceptionThruSeq *filter_thrus = filter_->thrus();
+  if (!((from == nullptr && filter_from == nullptr)
+	|| (from && filter_from && from->equal(filter_from))))
+    return false;
+  size_t thru_count = thrus ? thrus->size() : 0;
+  size_t filter_thru_count = filter_thrus ? filter_thrus->size() : 0;
+  if (thru_count != filter_thru_count)
+    return false;
+  for (size_t i = 0; i < thru_count; i++) {
+    if (!(*thrus)[i]->equal((*filter_thrus)[i]))
+      return false;
+  }
+  return true;
 }
 
 class SeedFaninsThruHierPin : public HierPinThruVisitor
@@ -635,6 +987,7 @@ Search::seedFilterStarts()
 void
 Search::deleteVertexBefore(Vertex *vertex)
 {
+  timing_frozen_ = false;
   if (arrivals_exist_) {
     deletePaths(vertex);
     arrival_iter_->deleteVertexBefore(vertex);
@@ -646,7 +999,7 @@ Search::deleteVertexBefore(Vertex *vertex)
     invalid_tns_.erase(vertex);
   }
   if (endpoints_)
-    endpoints_->erase(vertex);
+    eraseEndpoint(vertex);
   if (invalid_endpoints_)
     invalid_endpoints_->erase(vertex);
 }
@@ -658,38 +1011,81 @@ Search::arrivalsValid()
     && invalid_requireds_.empty();
 }
 
+void
+Search::setTimingFrozen(bool frozen)
+{
+  timing_frozen_ = frozen;
+}
+
+void
+Search::setSearchCorner(const Corner *corner)
+{
+  if (corner != search_corner_) {
+    arrivalsInvalid();
+    search_corner_ = corner;
+  }
+}
+
+const PathAnalysisPtSeq &
+Search::searchPathAnalysisPts() const
+{
+  if (search_corner_)
+    return search_corner_->pathAnalysisPts();
+  else
+    return corners_->pathAnalysisPts();
+}
+
 void
 Search::arrivalsInvalid()
 {
+  timing_frozen_ = false;
   if (arrivals_exist_) {
     debugPrint(debug_, "search", 1, "arrivals invalid");
     // Delete paths to make sure no state is left over.
     // For example, set_disable_timing strands a vertex, which means
     // the search won't revisit it to clear the previous arrival.
     deletePaths();
-    deleteTags();
-    genclks_->clear();
-    deleteFilter();
-    arrivals_at_endpoints_exist_ = false;
-    arrivals_seeded_ = false;
-    requireds_exist_ = false;
-    requireds_seeded_ = false;
-    clk_arrivals_valid_ = false;
-    arrival_iter_->clear();
-    required_iter_->clear();
-    // No need to keep track of incremental updates any more.
-    invalid_arrivals_.clear();
-    invalid_requireds_.clear();
-    tns_exists_ = false;
-    clearWorstSlack();
-    invalid_tns_.clear();
+    deleteArrivalState();
   }
 }
 
+void
+Search::arrivalsDeleted()
+{
+  timing_frozen_ = false;
+  if (arrivals_exist_) {
+    debugPrint(debug_, "search", 1, "arrivals deleted");
+    arrivals_exist_ = false;
+    deleteArrivalState();
+  }
+}
+
+void
+Search::deleteArrivalState()
+{
+  deleteTags();
+  genclks_->clear();
+  deleteFilter();
+  arrivals_at_endpoints_exist_ = false;
+  arrivals_seeded_ = false;
+  requireds_exist_ = false;
+  requireds_seeded_ = false;
+  clk_arrivals_valid_ = false;
+  arrival_iter_->clear();
+  required_iter_->clear();
+  // No need to keep track of incremental updates any more.
+  invalid_arrivals_.clear();
+  invalid_requireds_.clear();
+  tns_exists_ = false;
+  clearWorstSlack();
+  invalid_tns_.clear();
+}
+
 void
 Search::requiredsInvalid()
 {
   debugPrint(debug_, "search", 1, "requireds invalid");
+  timing_frozen_ = false;
   requireds_exist_ = false;
   requireds_seeded_ = false;
   invalid_requireds_.clear();
@@ -701,6 +1097,11 @@ Search::requiredsInvalid()
 void
 Search::arrivalInvalid(Vertex *vertex)
 {
+  // Delay calc threads only call this after timing is thawed.
+  if (timing_frozen_)
+    timing_frozen_ = false;
+  if (observer_)
+    observer_->arrivalInvalid(vertex);
   if (arrivals_exist_) {
     debugPrint(debug_, "search", 2, "arrival invalid %s",
                vertex->name(sdc_network_));
@@ -717,6 +1118,7 @@ void
 Search::arrivalInvalidDelete(Vertex *vertex)
 {
   arrivalInvalid(vertex);
+  deletePathArrays(vertex);
   vertex->deletePaths();
 }
 
@@ -771,6 +1173,10 @@ Search::requiredInvalid(const Pin *pin)
 void
 Search::requiredInvalid(Vertex *vertex)
 {
+  if (timing_frozen_)
+    timing_frozen_ = false;
+  if (observer_)
+    observer_->requiredInvalid(vertex);
   if (requireds_exist_) {
     debugPrint(debug_, "search", 2, "required invalid %s",
                vertex->name(sdc_network_));
@@ -899,7 +1305,7 @@ Search::visitStartpoints(VertexVisitor *visitor)
 void
 Search::visitEndpoints(VertexVisitor *visitor)
 {
-  for (Vertex *end : *endpoints()) {
+  for (Vertex *end : endpointSeq()) {
     Pin *pin = end->pin();
     // Filter register clock pins (fails on set_max_delay -from clk_src).
     if (!network_->isRegClkPin(pin)
@@ -967,9 +1373,16 @@ Search::findArrivals(Level level,
 {
   debugPrint(debug_, "search", 1, "find arrivals to level %d", level);
   findArrivals1();
+  int seed_count = arrival_iter_->queueCount();
+  int change_count = arrival_change_count_;
   Stats stats(debug_, report_);
   int arrival_count = arrival_iter_->visitParallel(level, arrival_visitor);
   stats.report("Find arrivals");
+  arrival_seed_count_ += seed_count;
+  arrival_visit_count_ += arrival_count;
+  debugPrint(debug_, "search", 1, "%d seeds %d arrivals changed",
+             seed_count,
+             arrival_change_count_ - change_count);
   if (arrival_iter_->empty()
       && invalid_arrivals_.empty()) {
     clk_arrivals_valid_ = true;
@@ -1020,7 +1433,7 @@ ArrivalVisitor::init0()
 {
   tag_bldr_ = new TagGroupBldr(true, sta_);
   tag_bldr_no_crpr_ = new TagGroupBldr(false, sta_);
-  adj_pred_ = new SearchThru(tag_bldr_, sta_);
+  adj_pred_ = new FilterConeSearchThru(tag_bldr_, sta_);
 }
 
 void
@@ -1130,6 +1543,7 @@ ArrivalVisitor::visit(Vertex *vertex)
       search->arrivalIterator()->enqueueAdjacentVertices(vertex, adj_pred_);
     if (arrivals_changed) {
       debugPrint(debug, "search", 4, "arrival changed");
+      search->incrArrivalChangeCount();
       // Only update arrivals when delays change by more than
       // fuzzyEqual can distinguish.
       search->setVertexArrivals(vertex, tag_bldr_);
@@ -1200,8 +1614,14 @@ Search::arrivalsChanged(Vertex *vertex,
       Arrival arrival2;
       bool arrival_exists2;
       tag_bldr->tagArrival(tag1, arrival2, arrival_exists2);
-      if (!arrival_exists2
-	  || !delayEqual(arrival1, arrival2))
+      if (!arrival_exists2)
+	return true;
+      if (arrival_tolerance_ > 0.0) {
+	if (abs(delayAsFloat(arrival1) - delayAsFloat(arrival2))
+	    > arrival_tolerance_)
+	  return true;
+      }
+      else if (!delayEqual(arrival1, arrival2))
 	return true;
     }
     return false;
@@ -1471,7 +1891,7 @@ Search::seedClkArrivals(const Pin *pin,
   for (Clock *clk : *sdc_->findLeafPinClocks(pin)) {
     debugPrint(debug_, "search", 2, "arrival seed clk %s pin %s",
                clk->name(), network_->pathName(pin));
-    for (PathAnalysisPt *path_ap : corners_->pathAnalysisPts()) {
+    for (PathAnalysisPt *path_ap : searchPathAnalysisPts()) {
       const MinMax *min_max = path_ap->pathMinMax();
       for (RiseFall *rf : RiseFall::range()) {
 	ClockEdge *clk_edge = clk->edge(rf);
@@ -1590,7 +2010,7 @@ Search::makeUnclkedPaths(Vertex *vertex,
 {
   bool search_from = false;
   const Pin *pin = vertex->pin();
-  for (PathAnalysisPt *path_ap : corners_->pathAnalysisPts()) {
+  for (PathAnalysisPt *path_ap : searchPathAnalysisPts()) {
     const MinMax *min_max = path_ap->pathMinMax();
     for (RiseFall *rf : RiseFall::range()) {
       Tag *tag = fromUnclkedInputTag(pin, rf, min_max, path_ap,
@@ -1762,7 +2182,7 @@ Search::seedInputDelayArrival(const Pin *pin,
     clk_edge = sdc_->defaultArrivalClockEdge();
   if (ref_pin) {
     Vertex *ref_vertex = graph_->pinLoadVertex(ref_pin);
-    for (PathAnalysisPt *path_ap : corners_->pathAnalysisPts()) {
+    for (PathAnalysisPt *path_ap : searchPathAnalysisPts()) {
       const MinMax *min_max = path_ap->pathMinMax();
       RiseFall *ref_rf = input_delay->refTransition();
       const Clock *clk = input_delay->clock();
@@ -1783,7 +2203,7 @@ Search::seedInputDelayArrival(const Pin *pin,
     }
   }
   else {
-    for (PathAnalysisPt *path_ap : corners_->pathAnalysisPts()) {
+    for (PathAnalysisPt *path_ap : searchPathAnalysisPts()) {
       const MinMax *min_max = path_ap->pathMinMax();
       float clk_arrival, clk_insertion, clk_latency;
       inputDelayClkArrival(input_delay, clk_edge, min_max, path_ap,
@@ -2695,6 +3115,7 @@ Search::setVertexArrivals(Vertex *vertex,
       }
       else {
 	// Prev paths not required.
+	graph_->deletePrevPaths(vertex->prevPaths(), arrival_count);
 	prev_paths = nullptr;
 	vertex->setPrevPaths(prev_path_null);
       }
@@ -2702,6 +3123,8 @@ Search::setVertexArrivals(Vertex *vertex,
       vertex->setTagGroupIndex(tag_group->index());
     }
     else {
+      if (prev_tag_group)
+	deletePathArrays(vertex);
       Arrival *arrivals = graph_->makeArrivals(vertex, arrival_count);
       prev_paths = nullptr;
       if  (tag_bldr->hasClkTag() || tag_bldr->hasGenClkSrcTag())
@@ -3105,13 +3528,15 @@ Search::endpoints()
   if (endpoints_ == nullptr) {
     endpoints_ = new VertexSet;
     invalid_endpoints_ = new VertexSet;
+    endpoint_seq_.clear();
+    endpoint_index_.clear();
     VertexIterator vertex_iter(graph_);
     while (vertex_iter.hasNext()) {
       Vertex *vertex = vertex_iter.next();
       if (isEndpoint(vertex)) {
 	debugPrint(debug_, "endpoint", 2, "insert %s",
                    vertex->name(sdc_network_));
-	endpoints_->insert(vertex);
+	insertEndpoint(vertex);
       }
     }
   }
@@ -3120,14 +3545,14 @@ Search::endpoints()
       if (isEndpoint(vertex)) {
 	debugPrint(debug_, "endpoint", 2, "insert %s",
                    vertex->name(sdc_network_));
-	endpoints_->insert(vertex);
+	insertEndpoint(vertex);
       }
       else {
 	if (debug_->check("endpoint", 2)
 	    && endpoints_->hasKey(vertex))
 	  report_->reportLine("endpoint: remove %s",
                               vertex->name(sdc_network_));
-	endpoints_->erase(vertex);
+	eraseEndpoint(vertex);
       }
     }
     invalid_endpoints_->clear();
@@ -3135,9 +3560,46 @@ Search::endpoints()
   return endpoints_;
 }
 
+VertexSeq &
+Search::endpointSeq()
+{
+  endpoints();
+  return endpoint_seq_;
+}
+
+void
+Search::insertEndpoint(Vertex *vertex)
+{
+  if (!endpoints_->hasKey(vertex)) {
+    endpoints_->insert(vertex);
+    endpoint_index_[vertex] = endpoint_seq_.size();
+    endpoint_seq_.push_back(vertex);
+  }
+}
+
+// Move the last endpoint into the hole left by vertex.
+void
+Search::eraseEndpoint(Vertex *vertex)
+{
+  auto index_itr = endpoint_index_.find(vertex);
+  if (index_itr != endpoint_index_.end()) {
+    size_t index = index_itr->second;
+    endpoint_index_.erase(index_itr);
+    Vertex *last = endpoint_seq_.back();
+    endpoint_seq_.pop_back();
+    if (last != vertex) {
+      endpoint_seq_[index] = last;
+      endpoint_index_[last] = index;
+    }
+    endpoints_->erase(vertex);
+  }
+}
+
 void
 Search::endpointInvalid(Vertex *vertex)
 {
+  if (timing_frozen_)
+    timing_frozen_ = false;
   if (invalid_endpoints_) {
     debugPrint(debug_, "endpoint", 2, "invalid %s",
                vertex->name(sdc_network_));
@@ -3184,10 +3646,13 @@ Search::hasEnabledChecks(Vertex *vertex) const
 void
 Search::endpointsInvalid()
 {
+  timing_frozen_ = false;
   delete endpoints_;
   delete invalid_endpoints_;
   endpoints_ = nullptr;
   invalid_endpoints_ = nullptr;
+  endpoint_seq_.clear();
+  endpoint_index_.clear();
 }
 
 void
@@ -16,8 +16,13 @@
 
 #include "Sta.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include "Machine.hh"
 #include "DispatchQueue.hh"
+#include "Mutex.hh"
 #include "ReportTcl.hh"
 #include "Debug.hh"
 #include "Stats.hh"
@@ -45,6 +50,7 @@
 #include "dcalc/GraphDelayCalc1.hh"
 #include "sdf/SdfWriter.hh"
 #include "Levelize.hh"
+#include "Bfs.hh"
 #include "Sim.hh"
 #include "ClkInfo.hh"
 #include "TagGroup.hh"
@@ -67,6 +73,11 @@
 #include "Genclks.hh"
 #include "ClkNetwork.hh"
 #include "Power.hh"
+#include "BulkAnnotation.hh"
+#include "PartitionWorkers.hh"
+#include "CornerSearch.hh"
+#include "TimingPartition.hh"
+#include "MakeTimingModel.hh"
 
 namespace sta {
 
@@ -218,6 +229,106 @@ StaLevelizeObserver::levelChangedBefore(Vertex *vertex)
 
 ////////////////////////////////////////////////////////////////
 
+class StaMode
+{
+public:
+  StaMode(Sdc *sdc,
+	  Search *search);
+  void arrivalInvalid(Vertex *vertex);
+  void requiredInvalid(Vertex *vertex);
+  void deletePaths();
+
+  Sdc *sdc_;
+  Search *search_;
+  // Search paths while the mode is not current.
+  GraphPaths paths_;
+  bool paths_saved_;
+  // Vertices invalidated in other modes while the paths are saved.
+  VertexSet invalid_arrivals_;
+  VertexSet invalid_requireds_;
+  std::mutex invalid_lock_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(StaMode);
+};
+
+StaMode::StaMode(Sdc *sdc,
+		 Search *search) :
+  sdc_(sdc),
+  search_(search),
+  paths_saved_(false)
+{
+}
+
+void
+StaMode::arrivalInvalid(Vertex *vertex)
+{
+  if (paths_saved_) {
+    UniqueLock lock(invalid_lock_);
+    invalid_arrivals_.insert(vertex);
+  }
+}
+
+void
+StaMode::requiredInvalid(Vertex *vertex)
+{
+  if (paths_saved_) {
+    UniqueLock lock(invalid_lock_);
+    invalid_requireds_.insert(vertex);
+  }
+}
+
+void
+StaMode::deletePaths()
+{
+  if (paths_saved_) {
+    paths_.clear();
+    search_->arrivalsDeleted();
+    invalid_arrivals_.clear();
+    invalid_requireds_.clear();
+    paths_saved_ = false;
+  }
+}
+
+// Vertex invalidations in the current mode are recorded for the modes
+// with saved paths. Most invalidations come from constraint changes
+// that do not apply to the other modes, but recording them is cheaper
+// than separating them from network, parasitic and delay changes.
+class StaSearchObserver : public SearchObserver
+{
+public:
+  explicit StaSearchObserver(StaModeMap *modes);
+  virtual void arrivalInvalid(Vertex *vertex);
+  virtual void requiredInvalid(Vertex *vertex);
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(StaSearchObserver);
+
+  StaModeMap *modes_;
+};
+
+StaSearchObserver::StaSearchObserver(StaModeMap *modes) :
+  SearchObserver(),
+  modes_(modes)
+{
+}
+
+void
+StaSearchObserver::arrivalInvalid(Vertex *vertex)
+{
+  for (auto name_mode : *modes_)
+    name_mode.second->arrivalInvalid(vertex);
+}
+
+void
+StaSearchObserver::requiredInvalid(Vertex *vertex)
+{
+  for (auto name_mode : *modes_)
+    name_mode.second->requiredInvalid(vertex);
+}
+
+////////////////////////////////////////////////////////////////
+
 void
 initSta()
 {
@@ -270,7 +381,9 @@ Sta::Sta() :
   link_make_black_boxes_(true),
   update_genclks_(false),
   equiv_cells_(nullptr),
+  register_index_(nullptr),
   graph_sdc_annotated_(false),
+  mode_name_(nullptr),
   // Default to same parasitics for each corner min/max.
   parasitics_per_corner_(false),
   parasitics_per_min_max_(false)
@@ -331,6 +444,15 @@ Sta::setThreadCount(int thread_count)
   updateComponentsState();
 }
 
+void
+Sta::forkedProcessInit()
+{
+  // The queue cannot be deleted because its threads do not exist.
+  dispatch_queue_ = nullptr;
+  thread_count_ = 1;
+  updateComponentsState();
+}
+
 void
 Sta::updateComponentsState()
 {
@@ -342,6 +464,14 @@ Sta::updateComponentsState()
   if (graph_)
     graph_->copyState(this);
   sdc_->copyState(this);
+  // Constraints and searches for the other modes.
+  for (auto name_mode : modes_) {
+    StaMode *mode = name_mode.second;
+    if (mode->sdc_ != sdc_) {
+      mode->sdc_->copyState(this);
+      mode->search_->copyState(this);
+    }
+  }
   corners_->copyState(this);
   levelize_->copyState(this);
   parasitics_->copyState(this);
@@ -355,6 +485,10 @@ Sta::updateComponentsState()
   if (check_timing_)
     check_timing_->copyState(this);
   clk_network_->copyState(this);
+  if (clk_skews_)
+    clk_skews_->copyState(this);
+  if (register_index_)
+    register_index_->copyState(this);
   if (power_)
     power_->copyState(this);
 }
@@ -530,6 +664,19 @@ Sta::~Sta()
   delete graph_delay_calc_;
   delete sim_;
   delete levelize_;
+  StaModeMap::Iterator mode_iter(modes_);
+  while (mode_iter.hasNext()) {
+    const char *mode_name;
+    StaMode *mode;
+    mode_iter.next(mode_name, mode);
+    if (mode->search_ != search_) {
+      mode->deletePaths();
+      delete mode->search_;
+      delete mode->sdc_;
+    }
+    delete mode;
+    stringDelete(mode_name);
+  }
   delete sdc_;
   delete corners_;
   delete graph_;
@@ -541,16 +688,24 @@ Sta::~Sta()
   delete clk_network_;
   delete power_;
   delete equiv_cells_;
+  delete register_index_;
   delete dispatch_queue_;
 }
 
 void
 Sta::clear()
 {
+  thawTiming();
   clkPinsInvalid();
+  deleteModePaths();
   // Constraints reference search filter, so clear search first.
   search_->clear();
   sdc_->clear();
+  for (auto name_mode : modes_) {
+    Sdc *sdc = name_mode.second->sdc_;
+    if (sdc != sdc_)
+      sdc->clear();
+  }
   graph_sdc_annotated_ = false;
   // corners are NOT cleared because they are used to index liberty files.
   levelize_->clear();
@@ -573,7 +728,9 @@ void
 Sta::networkChanged()
 {
   // Everything else from clear().
+  deleteModePaths();
   search_->clear();
+  registerIndexInvalid();
   levelize_->clear();
   if (parasitics_)
     parasitics_->clear();
@@ -1081,6 +1238,7 @@ Sta::makeClock(const char *name,
   sdc_->makeClock(name, pins, add_to_pins, period, waveform, comment);
   update_genclks_ = true;
   search_->arrivalsInvalid();
+  registerIndexInvalid();
 }
 
 void
@@ -1108,6 +1266,7 @@ Sta::makeGeneratedClock(const char *name,
 			   edges, edge_shifts, comment);
   update_genclks_ = true;
   search_->arrivalsInvalid();
+  registerIndexInvalid();
 }
 
 void
@@ -1115,6 +1274,7 @@ Sta::removeClock(Clock *clk)
 {
   sdc_->removeClock(clk);
   search_->arrivalsInvalid();
+  registerIndexInvalid();
 }
 
 bool
@@ -1196,6 +1356,9 @@ Sta::setClockLatency(Clock *clk,
   search_->arrivalsInvalid();
 }
 
+// Constraint additions are annotated incrementally when the graph is
+// already annotated. Removals re-annotate the graph because a vertex or
+// edge may be annotated by more than one constraint.
 void
 Sta::sdcChangedGraph()
 {
@@ -1353,6 +1516,7 @@ Sta::setClockSense(PinSet *pins,
 {
   sdc_->setClockSense(pins, clks, sense);
   search_->arrivalsInvalid();
+  registerIndexInvalid();
 }
 
 ////////////////////////////////////////////////////////////////
@@ -1407,8 +1571,9 @@ Sta::setDataCheck(Pin *from,
 		  const SetupHoldAll *setup_hold,
 		  float margin)
 {
-  sdcChangedGraph();
   sdc_->setDataCheck(from, from_rf, to, to_rf, clk, setup_hold,margin);
+  if (graph_sdc_annotated_)
+    sdc_->annotateGraphDataCheck(to);
   search_->requiredInvalid(to);
 }
 
@@ -1429,8 +1594,9 @@ Sta::removeDataCheck(Pin *from,
 void
 Sta::disable(Pin *pin)
 {
-  sdcChangedGraph();
   sdc_->disable(pin);
+  if (graph_sdc_annotated_)
+    sdc_->annotateGraphDisable(pin);
   // Levelization respects disabled edges.
   levelize_->invalid();
   graph_delay_calc_->delayInvalid(pin);
@@ -1454,8 +1620,9 @@ Sta::disable(Instance *inst,
 	     LibertyPort *from,
 	     LibertyPort *to)
 {
-  sdcChangedGraph();
   sdc_->disable(inst, from, to);
+  if (graph_sdc_annotated_)
+    sdc_->annotateGraphDisable(inst);
 
   if (from) {
     Pin *from_pin = network_->findPin(inst, from);
@@ -1528,8 +1695,9 @@ Sta::removeDisable(LibertyCell *cell,
 void
 Sta::disable(LibertyPort *port)
 {
-  sdcChangedGraph();
   sdc_->disable(port);
+  if (graph_sdc_annotated_)
+    sdc_->annotateGraphDisable(port);
   disableAfter();
 }
 
@@ -1590,6 +1758,7 @@ Sta::disableAfter()
   levelize_->invalid();
   graph_delay_calc_->delaysInvalid();
   search_->arrivalsInvalid();
+  registerIndexInvalid();
 }
 
 ////////////////////////////////////////////////////////////////
@@ -1810,6 +1979,7 @@ Sta::setLogicValue(Pin *pin,
   // Levelization respects constant disabled edges.
   levelize_->invalid();
   sim_->constantsInvalid();
+  registerIndexInvalid();
   // Constants disable edges which isolate downstream vertices of the
   // graph from the delay calculator's BFS search.  This means that
   // simply invaldating the delays downstream from the constant pin
@@ -1828,6 +1998,7 @@ Sta::setCaseAnalysis(Pin *pin,
   // Levelization respects constant disabled edges.
   levelize_->invalid();
   sim_->constantsInvalid();
+  registerIndexInvalid();
   // Constants disable edges which isolate downstream vertices of the
   // graph from the delay calculator's BFS search.  This means that
   // simply invaldating the delays downstream from the constant pin
@@ -1844,6 +2015,7 @@ Sta::removeCaseAnalysis(Pin *pin)
   // Levelization respects constant disabled edges.
   levelize_->invalid();
   sim_->constantsInvalid();
+  registerIndexInvalid();
   // Constants disable edges which isolate downstream vertices of the
   // graph from the delay calculator's BFS search.  This means that
   // simply invaldating the delays downstream from the constant pin
@@ -1898,7 +2070,8 @@ Sta::setOutputDelay(Pin *pin,
   sdc_->setOutputDelay(pin, rf, clk, clk_rf, ref_pin,
 		       source_latency_included,network_latency_included,
 		       min_max, add, delay);
-  sdcChangedGraph();
+  if (graph_sdc_annotated_)
+    sdc_->annotateGraphOutputDelay(pin);
   search_->requiredInvalid(pin);
 }
 
@@ -2103,6 +2276,7 @@ Sta::removeConstraints()
     sdc_->removeGraphAnnotations();
   sdc_->clear();
   clk_network_->clear();
+  registerIndexInvalid();
 }
 
 void
@@ -2406,6 +2580,7 @@ void
 Sta::makeCorners(StringSet *corner_names)
 {
   parasitics_->deleteParasitics();
+  deleteModePaths();
   corners_->makeCorners(corner_names);
   makeParasiticAnalysisPts();
   cmd_corner_ = corners_->findCorner(0);
@@ -2425,6 +2600,261 @@ Sta::setCmdCorner(Corner *corner)
 
 ////////////////////////////////////////////////////////////////
 
+// The constraints before the first mode is defined are mode "default".
+void
+Sta::ensureModes()
+{
+  if (modes_.empty()) {
+    mode_name_ = stringCopy("default");
+    modes_[mode_name_] = makeStaMode(sdc_, search_);
+  }
+}
+
+StaMode *
+Sta::makeStaMode(Sdc *sdc,
+		 Search *search)
+{
+  search->setObserver(new StaSearchObserver(&modes_));
+  return new StaMode(sdc, search);
+}
+
+void
+Sta::makeMode(const char *mode_name)
+{
+  ensureModes();
+  if (!modes_.hasKey(mode_name)) {
+    // makeSdc replaces sdc_, so restore the current mode constraints.
+    Sdc *sdc = sdc_;
+    makeSdc();
+    Sdc *mode_sdc = sdc_;
+    sdc_ = sdc;
+    mode_sdc->copyState(this);
+    Search *mode_search = new Search(this);
+    mode_search->copyOptions(search_);
+    modes_[stringCopy(mode_name)] = makeStaMode(mode_sdc, mode_search);
+  }
+}
+
+bool
+Sta::modeExists(const char *mode_name)
+{
+  ensureModes();
+  return modes_.hasKey(mode_name);
+}
+
+const char *
+Sta::currentMode()
+{
+  ensureModes();
+  return mode_name_;
+}
+
+void
+Sta::setMode(const char *mode_name)
+{
+  ensureModes();
+  auto mode_itr = modes_.find(mode_name);
+  if (mode_itr != modes_.end()
+      && mode_itr->second->sdc_ != sdc_) {
+    StaMode *mode = mode_itr->second;
+    StaMode *prev_mode = modes_.findKey(mode_name_);
+    bool delays_compatible = modeDelaysCompatible(sdc_, mode->sdc_);
+    bool analysis_type_changed =
+      mode->sdc_->analysisType() != sdc_->analysisType();
+    thawTiming();
+    if (delays_compatible)
+      // Delays that depend on the previous mode constraints.
+      modeDelaysInvalid();
+    saveModePaths(prev_mode);
+    // Graph annotations reference the constraints of the current mode.
+    sdcChangedGraph();
+    clkPinsInvalid();
+    if (check_min_pulse_widths_)
+      check_min_pulse_widths_->clear();
+    if (check_min_periods_)
+      check_min_periods_->clear();
+    sdc_->annotateLibertyDisables(false);
+
+    sdc_ = mode->sdc_;
+    search_ = mode->search_;
+    mode_name_ = mode_itr->first;
+    updateComponentsState();
+    makeObservers();
+
+    sdc_->annotateLibertyDisables(true);
+    sdc_->clkHpinDisablesInvalid();
+    levelize_->invalid();
+    sim_->constantsInvalid();
+    restoreModePaths(mode);
+    if (delays_compatible)
+      // Delays that depend on the new mode constraints.
+      modeDelaysInvalid();
+    else {
+      graph_delay_calc_->delaysInvalid();
+      corners_->operatingConditionsChanged();
+      if (analysis_type_changed) {
+	corners_->analysisTypeChanged();
+	if (graph_)
+	  graph_->setDelayCount(corners_->dcalcAnalysisPtCount());
+	// Path analysis points changed.
+	search_->arrivalsInvalid();
+      }
+    }
+    // Invalidations from here on apply to the previous mode paths.
+    prev_mode->paths_saved_ = true;
+  }
+}
+
+// Save the current mode search paths so they can be restored when
+// the mode is current again.
+void
+Sta::saveModePaths(StaMode *mode)
+{
+  // Filter exceptions belong to the mode constraints.
+  search_->deleteFilteredArrivals();
+  // Vertices in the search queues are marked with bfs bits that
+  // are shared by all modes.
+  if (!(search_->arrivalIterator()->empty()
+	&& search_->requiredIterator()->empty()))
+    search_->arrivalsInvalid();
+  if (graph_)
+    graph_->swapPaths(mode->paths_);
+  mode->invalid_arrivals_.clear();
+  mode->invalid_requireds_.clear();
+}
+
+void
+Sta::restoreModePaths(StaMode *mode)
+{
+  if (graph_) {
+    // The graph paths were saved with the previous mode, leaving the
+    // graph without paths to exchange with the mode paths.
+    graph_->swapPaths(mode->paths_);
+    mode->paths_.clear();
+  }
+  mode->paths_saved_ = false;
+  for (Vertex *vertex : mode->invalid_arrivals_)
+    search_->arrivalInvalid(vertex);
+  for (Vertex *vertex : mode->invalid_requireds_)
+    search_->requiredInvalid(vertex);
+  mode->invalid_arrivals_.clear();
+  mode->invalid_requireds_.clear();
+}
+
+void
+Sta::deleteModePaths()
+{
+  for (auto name_mode : modes_)
+    name_mode.second->deletePaths();
+}
+
+bool
+Sta::modeDelaysCompatible(Sdc *sdc1,
+			  Sdc *sdc2)
+{
+  if (sdc1->analysisType() != sdc2->analysisType()
+      || sdc1->wireloadMode() != sdc2->wireloadMode()
+      || sdc1->hasLibertyDisables()
+      || sdc2->hasLibertyDisables())
+    return false;
+  for (auto min_max : MinMax::range()) {
+    if (sdc1->operatingConditions(min_max) != sdc2->operatingConditions(min_max)
+	|| sdc1->wireload(min_max) != sdc2->wireload(min_max)
+	|| sdc1->wireloadSelection(min_max) != sdc2->wireloadSelection(min_max))
+      return false;
+  }
+  return true;
+}
+
+// Invalidate the delays that depend on the current mode constraints:
+// port drives and loads, net loads, instance pvts, ideal clock slews
+// and disabled timing.
+void
+Sta::modeDelaysInvalid()
+{
+  if (graph_) {
+    PinSet pins;
+    sdc_->delayConstraintPins(pins);
+    for (Pin *pin : pins) {
+      Vertex *vertex, *bidirect_drvr_vertex;
+      graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+      if (vertex)
+	modeDelayInvalid(vertex);
+      if (bidirect_drvr_vertex)
+	modeDelayInvalid(bidirect_drvr_vertex);
+    }
+
+    ensureClkNetwork();
+    for (Clock *clk : sdc_->clks()) {
+      const PinSet *clk_pins = clk_network_->pins(clk);
+      if (clk_pins) {
+	for (Pin *pin : *clk_pins) {
+	  Vertex *vertex, *bidirect_drvr_vertex;
+	  graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+	  if (vertex)
+	    modeDelayInvalid(vertex);
+	  if (bidirect_drvr_vertex)
+	    modeDelayInvalid(bidirect_drvr_vertex);
+	}
+      }
+    }
+
+    ensureGraphSdcAnnotated();
+    VertexIterator vertex_iter(graph_);
+    while (vertex_iter.hasNext()) {
+      Vertex *vertex = vertex_iter.next();
+      if (vertex->isDisabledConstraint())
+	modeDelayInvalid(vertex);
+      VertexOutEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+	Edge *edge = edge_iter.next();
+	if (edge->isDisabledConstraint()) {
+	  graph_delay_calc_->delayInvalid(vertex);
+	  graph_delay_calc_->delayInvalid(edge->to(graph_));
+	}
+      }
+    }
+  }
+}
+
+// Invalidate the vertex delays and the delays of the drivers
+// that it loads.
+void
+Sta::modeDelayInvalid(Vertex *vertex)
+{
+  graph_delay_calc_->delayInvalid(vertex);
+  VertexInEdgeIterator edge_iter(vertex, graph_);
+  while (edge_iter.hasNext()) {
+    Edge *edge = edge_iter.next();
+    if (edge->role()->isWire())
+      graph_delay_calc_->delayInvalid(edge->from(graph_));
+  }
+}
+
+void
+Sta::updateTimingModes(bool full)
+{
+  ensureModes();
+  const char *mode_name = mode_name_;
+  for (auto name_mode : modes_) {
+    setMode(name_mode.first);
+    updateTiming(full);
+  }
+  setMode(mode_name);
+}
+
+StringSeq *
+Sta::modeNames()
+{
+  ensureModes();
+  StringSeq *mode_names = new StringSeq;
+  for (auto mode_sdc : modes_)
+    mode_names->push_back(mode_sdc.first);
+  return mode_names;
+}
+
+////////////////////////////////////////////////////////////////
+
 // from/thrus/to are owned and deleted by Search.
 // Returned sequence is owned by the caller.
 // PathEnds are owned by Search PathGroups and deleted on next call.
@@ -2449,7 +2879,7 @@ Sta::findPathEnds(ExceptionFrom *from,
 		  bool clk_gating_setup,
 		  bool clk_gating_hold)
 {
-  searchPreamble();
+  searchPreamble(from, thrus, to);
   return search_->findPathEnds(from, thrus, to, unconstrained,
 			       corner, min_max, group_count, endpoint_count,
 			       unique_pins, slack_min, slack_max,
@@ -2471,11 +2901,23 @@ Sta::findPathEnds(ExceptionFrom *from,
 
 void
 Sta::searchPreamble()
+{
+  searchPreamble(nullptr, nullptr, nullptr);
+}
+
+void
+Sta::searchPreamble(ExceptionFrom *from,
+		    ExceptionThruSeq *thrus,
+		    ExceptionTo *to)
 {
   findDelays();
   updateGeneratedClks();
   sdc_->searchPreamble();
-  search_->deleteFilteredArrivals();
+  // Repeated reports with the same -from/-thru reuse the filtered
+  // arrivals until timing changes.
+  if (!((from || thrus)
+	&& search_->filteredArrivalsReusable(from, thrus, to)))
+    search_->deleteFilteredArrivals();
 }
 
 void
@@ -2567,9 +3009,67 @@ Sta::updateTiming(bool full)
   searchPreamble();
   if (full)
     search_->arrivalsInvalid();
+  search_->resetArrivalUpdateStats();
   search_->findAllArrivals();
 }
 
+void
+Sta::freezeTiming()
+{
+  thawTiming();
+  searchPreamble();
+  search_->findAllArrivals();
+  search_->findRequireds();
+  if (sdc_->crprEnabled()
+      && search_->crprPathPruningEnabled()
+      && !search_->crprApproxMissingRequireds()) {
+    // Resurrect pruned requireds up front rather than in findRequired.
+    int fanout = 0;
+    VertexIterator vertex_iter(graph_);
+    while (vertex_iter.hasNext()) {
+      Vertex *vertex = vertex_iter.next();
+      if (!search_->isClock(vertex)
+	  && vertex->requiredsPruned())
+	disableFanoutCrprPruning(vertex, fanout);
+    }
+    if (fanout > 0) {
+      debugPrint(debug_, "search", 1, "resurrect pruned requireds fanout %d",
+                 fanout);
+      search_->findAllArrivals();
+      search_->findRequireds();
+    }
+  }
+  PathAPIndex path_ap_count = corners_->pathAnalysisPtCount();
+  frozen_worst_slacks_.resize(path_ap_count);
+  frozen_worst_vertices_.resize(path_ap_count);
+  frozen_tns_.resize(path_ap_count);
+  for (Corner *corner : *corners_) {
+    for (MinMax *min_max : MinMax::range()) {
+      PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+      search_->worstSlack(corner, min_max,
+			  frozen_worst_slacks_[path_ap_index],
+			  frozen_worst_vertices_[path_ap_index]);
+      frozen_tns_[path_ap_index] = search_->totalNegativeSlack(corner, min_max);
+    }
+  }
+  search_->setTimingFrozen(true);
+}
+
+bool
+Sta::timingFrozen() const
+{
+  return search_->timingFrozen();
+}
+
+void
+Sta::thawTiming()
+{
+  search_->setTimingFrozen(false);
+  frozen_worst_slacks_.clear();
+  frozen_worst_vertices_.clear();
+  frozen_tns_.clear();
+}
+
 void
 Sta::reportClkSkew(ClockSet *clks,
 		   const Corner *corner,
@@ -2591,18 +3091,88 @@ Sta::findWorstClkSkew(const SetupHold *setup_hold)
   return clk_skews_->findWorstClkSkew(cmd_corner_, setup_hold);
 }
 
+void
+Sta::reportTimingPartitions(int count)
+{
+  ensureGraph();
+  ensureGraphSdcAnnotated();
+  ensureClkNetwork();
+  TimingPartitions partitions(this);
+  partitions.findPartitions();
+  partitions.reportPartitions(count);
+}
+
+void
+Sta::reportPartitionSlacks(int worker_count,
+			   int digits)
+{
+  ensureGraph();
+  ensureGraphSdcAnnotated();
+  ensureClkNetwork();
+  // Levelize and find the delays once before the workers are forked.
+  ensureLevelized();
+  findDelays();
+  PartitionWorkers workers(this);
+  workers.findSlacks(worker_count);
+  workers.reportSlacks(digits);
+}
+
+void
+Sta::reportCornerSlacks(int digits)
+{
+  CornerSearch corner_search(this);
+  corner_search.findSlacks();
+  corner_search.reportSlacks(digits);
+}
+
+bool
+Sta::reportCornerPathEnds(ExceptionFrom *from,
+			  ExceptionThruSeq *thrus,
+			  ExceptionTo *to,
+			  bool unconstrained,
+			  const Corner *corner,
+			  const MinMaxAll *min_max,
+			  int group_count,
+			  int endpoint_count,
+			  bool unique_pins,
+			  float slack_min,
+			  float slack_max,
+			  bool sort_by_slack,
+			  PathGroupNameSet *group_names,
+			  bool setup,
+			  bool hold,
+			  bool recovery,
+			  bool removal,
+			  bool clk_gating_setup,
+			  bool clk_gating_hold)
+{
+  CornerSearch corner_search(this);
+  return corner_search.reportPathEnds(from, thrus, to, unconstrained,
+				      corner, min_max, group_count,
+				      endpoint_count, unique_pins,
+				      slack_min, slack_max,
+				      sort_by_slack, group_names,
+				      setup, hold,
+				      recovery, removal,
+				      clk_gating_setup, clk_gating_hold);
+}
+
 ////////////////////////////////////////////////////////////////
 
 void
 Sta::delaysInvalid()
 {
+  thawTiming();
   graph_delay_calc_->delaysInvalid();
+  deleteModePaths();
   search_->arrivalsInvalid();
 }
 
 void
 Sta::arrivalsInvalid()
 {
+  thawTiming();
+  deleteModePaths();
   search_->arrivalsInvalid();
 }
 
@@ -2804,8 +3374,10 @@ Sta::vertexArrival(Vertex *vertex,
 		   const ClockEdge *clk_edge,
 		   const PathAnalysisPt *path_ap)
 {
-  searchPreamble();
-  search_->findArrivals(vertex->level());
+  if (!search_->timingFrozen()) {
+    searchPreamble();
+    search_->findArrivals(vertex->level());
+  }
   const MinMax *min_max = path_ap->pathMinMax();
   Arrival arrival = min_max->initValue();
   VertexPathIterator path_iter(vertex, rf, path_ap, this);
@@ -3033,6 +3605,8 @@ Sta::vertexSlacks(Vertex *vertex,
 void
 Sta::findRequired(Vertex *vertex)
 {
+  if (search_->timingFrozen())
+    return;
   searchPreamble();
   search_->findAllArrivals();
   search_->findRequireds(vertex->level());
@@ -3081,6 +3655,15 @@ Sta::disableFanoutCrprPruning(Vertex *vertex,
 Slack
 Sta::totalNegativeSlack(const MinMax *min_max)
 {
+  if (search_->timingFrozen()) {
+    Slack tns = 0.0;
+    for (Corner *corner : *corners_) {
+      Slack tns1 = totalNegativeSlack(corner, min_max);
+      if (delayLess(tns1, tns, this))
+	tns = tns1;
+    }
+    return tns;
+  }
   searchPreamble();
   return search_->totalNegativeSlack(min_max);
 }
@@ -3089,6 +3672,10 @@ Slack
 Sta::totalNegativeSlack(const Corner *corner,
 			const MinMax *min_max)
 {
+  if (search_->timingFrozen()) {
+    PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+    return frozen_tns_[path_ap_index];
+  }
   searchPreamble();
   return search_->totalNegativeSlack(corner, min_max);
 }
@@ -3099,6 +3686,20 @@ Sta::worstSlack(const MinMax *min_max,
 		Slack &worst_slack,
 		Vertex *&worst_vertex)
 {
+  if (search_->timingFrozen()) {
+    worst_slack = MinMax::min()->initValue();
+    worst_vertex = nullptr;
+    for (Corner *corner : *corners_) {
+      Slack worst_slack1;
+      Vertex *worst_vertex1;
+      worstSlack(corner, min_max, worst_slack1, worst_vertex1);
+      if (delayLess(worst_slack1, worst_slack, this)) {
+	worst_slack = worst_slack1;
+	worst_vertex = worst_vertex1;
+      }
+    }
+    return;
+  }
   searchPreamble();
   return search_->worstSlack(min_max, worst_slack, worst_vertex);
 }
@@ -3110,6 +3711,12 @@ Sta::worstSlack(const Corner *corner,
 		Slack &worst_slack,
 		Vertex *&worst_vertex)
 {
+  if (search_->timingFrozen()) {
+    PathAPIndex path_ap_index = corner->findPathAnalysisPt(min_max)->index();
+    worst_slack = frozen_worst_slacks_[path_ap_index];
+    worst_vertex = frozen_worst_vertices_[path_ap_index];
+    return;
+  }
   searchPreamble();
   return search_->worstSlack(corner, min_max, worst_slack, worst_vertex);
 }
@@ -3135,12 +3742,15 @@ Sta::setArcDelayCalc(const char *delay_calc_name)
   // Update pointers to arc_delay_calc.
   updateComponentsState();
   graph_delay_calc_->delaysInvalid();
+  deleteModePaths();
   search_->arrivalsInvalid();
 }
 
 void
 Sta::findDelays(Vertex *to_vertex)
 {
+  if (search_->timingFrozen())
+    return;
   delayCalcPreamble();
   graph_delay_calc_->findDelays(to_vertex->level());
 }
@@ -3171,6 +3781,18 @@ Sta::setIncrementalDelayTolerance(float tol)
   graph_delay_calc_->setIncrementalDelayTolerance(tol);
 }
 
+bool
+Sta::parallelCornerDelayCalc() const
+{
+  return graph_delay_calc_->cornerParallel();
+}
+
+void
+Sta::setParallelCornerDelayCalc(bool parallel)
+{
+  graph_delay_calc_->setCornerParallel(parallel);
+}
+
 ArcDelay
 Sta::arcDelay(Edge *edge,
 	      TimingArc *arc,
@@ -3415,6 +4037,40 @@ Sta::setAnnotatedSlew(Vertex *vertex,
   graph_delay_calc_->delayInvalid(vertex);
 }
 
+size_t
+Sta::setArcDelays(const ArcDelayAnnotation *delays,
+		  size_t count)
+{
+  ensureGraph();
+  size_t annotated_count = annotateArcDelays(delays, count, this);
+  if (annotated_count > 0) {
+    deleteModePaths();
+    search_->arrivalsInvalid();
+  }
+  return annotated_count;
+}
+
+size_t
+Sta::setAnnotatedSlews(const SlewAnnotation *slews,
+		       size_t count)
+{
+  ensureGraph();
+  size_t annotated_count = annotateSlews(slews, count, this);
+  if (annotated_count > 0) {
+    graph_delay_calc_->delaysInvalid();
+    deleteModePaths();
+    search_->arrivalsInvalid();
+  }
+  return annotated_count;
+}
+
+void
+Sta::readBulkAnnotations(const char *filename)
+{
+  ensureGraph();
+  sta::readBulkAnnotations(filename, this);
+}
+
 void
 Sta::writeSdf(const char *filename,
 	      Corner *corner,
@@ -3429,11 +4085,25 @@ Sta::writeSdf(const char *filename,
 		no_version, this);
 }
 
+void
+Sta::writeTimingModel(const char *filename,
+		      const char *min_filename,
+		      const char *lib_name,
+		      const char *cell_name,
+		      const Corner *corner)
+{
+  ensureGraph();
+  ensureGraphSdcAnnotated();
+  sta::writeTimingModel(filename, min_filename, lib_name, cell_name,
+			corner, this);
+}
+
 void
 Sta::removeDelaySlewAnnotations()
 {
   graph_->removeDelaySlewAnnotations();
   graph_delay_calc_->delaysInvalid();
+  deleteModePaths();
 }
 
 LogicValue
@@ -3705,6 +4375,7 @@ Sta::readSpef(const char *filename,
 			      op_cond, corner, cnst_min_max, quiet,
 			      report_, network_, parasitics_);
   graph_delay_calc_->delaysInvalid();
+  deleteModePaths();
   search_->arrivalsInvalid();
   return success;
 }
@@ -3806,6 +4477,7 @@ Sta::deleteParasitics()
 {
   parasitics_->deleteParasitics();
   graph_delay_calc_->delaysInvalid();
+  deleteModePaths();
   search_->arrivalsInvalid();
 }
 
@@ -3892,6 +4564,101 @@ Sta::replaceCell(Instance *inst,
   }
 }
 
+void
+Sta::swapCellDelays(const Instance *inst,
+		    LibertyCell *swap_cell,
+		    const Corner *corner,
+		    SwapCellDelaySeq &delays)
+{
+  graph_delay_calc_->swapCellDelays(inst, swap_cell, corner, delays);
+}
+
+// Worst change in delay to (or from) drvr_vertex.
+static float
+swapCellDelayDelta(const SwapCellDelaySeq &delays,
+		   const Instance *inst,
+		   Vertex *drvr_vertex,
+		   const RiseFall *rf,
+		   DcalcAPIndex ap_index,
+		   const MinMax *min_max,
+		   const StaState *sta)
+{
+  const Graph *graph = sta->graph();
+  const Network *network = sta->network();
+  // Gate, wire and upstream driver (input pin load) delay changes.
+  float gate_delta = min_max->initValue();
+  float wire_delta = min_max->initValue();
+  float upstream_delta = min_max->initValue();
+  for (const SwapCellDelay &delay : delays) {
+    if (delay.ap_index_ == ap_index) {
+      Edge *edge = delay.edge_;
+      float delta = delayAsFloat(delay.delay_) - delayAsFloat(delay.prev_delay_);
+      const RiseFall *drvr_rf = delay.arc_->toTrans()->asRiseFall();
+      if (edge->isWire()) {
+	if (edge->from(graph) == drvr_vertex
+	    && drvr_rf == rf
+	    && min_max->compare(delta, wire_delta))
+	  wire_delta = delta;
+      }
+      else {
+	Vertex *to_vertex = edge->to(graph);
+	if (to_vertex == drvr_vertex) {
+	  if (drvr_rf == rf
+	      && min_max->compare(delta, gate_delta))
+	    gate_delta = delta;
+	}
+	else if (network->instance(to_vertex->pin()) != inst
+		 && min_max->compare(delta, upstream_delta))
+	  upstream_delta = delta;
+      }
+    }
+  }
+  float init = min_max->initValue();
+  return (gate_delta == init ? 0.0 : gate_delta)
+    + (wire_delta == init ? 0.0 : wire_delta)
+    + (upstream_delta == init ? 0.0 : upstream_delta);
+}
+
+Slack
+Sta::swapCellSlack(const Instance *inst,
+		   LibertyCell *swap_cell,
+		   const Corner *corner,
+		   const MinMax *min_max)
+{
+  SwapCellDelaySeq delays;
+  graph_delay_calc_->swapCellDelays(inst, swap_cell, corner, delays);
+  float worst_slack = MinMax::min()->initValue();
+  InstancePinIterator *pin_iter = network_->pinIterator(inst);
+  while (pin_iter->hasNext()) {
+    Pin *pin = pin_iter->next();
+    if (network_->isDriver(pin)) {
+      Vertex *drvr_vertex = graph_->pinDrvrVertex(pin);
+      if (drvr_vertex) {
+	for (auto rf : RiseFall::range()) {
+	  VertexPathIterator path_iter(drvr_vertex, rf, min_max, this);
+	  while (path_iter.hasNext()) {
+	    PathVertex *path = path_iter.next();
+	    if ((corner == nullptr
+		 || path->pathAnalysisPt(this)->corner() == corner)
+		&& !path->requiredIsInitValue(this)) {
+	      DcalcAPIndex ap_index = path->dcalcAnalysisPt(this)->index();
+	      float delta = swapCellDelayDelta(delays, inst, drvr_vertex, rf,
+					       ap_index, min_max, this);
+	      // Delay increases reduce setup slack and increase hold slack.
+	      float slack = delayAsFloat(path->slack(this));
+	      slack += (min_max == MinMax::max()) ? -delta : delta;
+	      if (slack < worst_slack)
+		worst_slack = slack;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  delete pin_iter;
+  return worst_slack;
+}
+
 Net *
 Sta::makeNet(const char *name,
 	     Instance *parent)
@@ -3968,6 +4735,7 @@ Sta::makeInstanceAfter(Instance *inst)
 void
 Sta::makePinAfter(Pin *pin)
 {
+  deleteModePaths();
   if (!network_->isHierarchical(pin) && graph_) {
     Vertex *vertex, *bidir_drvr_vertex;
     graph_->makePinVertices(pin, vertex, bidir_drvr_vertex);
@@ -4083,6 +4851,7 @@ void
 Sta::replaceCellBefore(Instance *inst,
 		       LibertyCell *to_cell)
 {
+  deleteModePaths();
   if (graph_) {
     // Delete all graph edges between instance pins.
     InstancePinIterator *pin_iter = network_->pinIterator(inst);
@@ -4117,6 +4886,8 @@ Sta::replaceCellAfter(Instance *inst)
       sim_->pinSetFuncAfter(pin);
       if (network_->direction(pin)->isAnyInput())
 	parasitics_->loadPinCapacitanceChanged(pin);
+      if (register_index_)
+	register_index_->pinChanged(pin);
     }
     delete pin_iter;
   }
@@ -4125,6 +4896,9 @@ Sta::replaceCellAfter(Instance *inst)
 void
 Sta::connectPinAfter(Pin *pin)
 {
+  deleteModePaths();
+  if (register_index_)
+    register_index_->netPinsChanged(pin);
   if (graph_) {
     if (network_->isHierarchical(pin)) {
       graph_->makeWireEdgesThruPin(pin);
@@ -4166,6 +4940,11 @@ Sta::connectPinAfter(Pin *pin)
     }
   }
   sdc_->connectPinAfter(pin);
+  for (auto name_mode : modes_) {
+    Sdc *sdc = name_mode.second->sdc_;
+    if (sdc != sdc_)
+      sdc->connectPinAfter(pin);
+  }
   sim_->connectPinAfter(pin);
 }
 
@@ -4214,8 +4993,16 @@ Sta::connectLoadPinAfter(Vertex *vertex)
 void
 Sta::disconnectPinBefore(Pin *pin)
 {
+  deleteModePaths();
+  if (register_index_)
+    register_index_->netPinsChanged(pin);
   parasitics_->disconnectPinBefore(pin);
   sdc_->disconnectPinBefore(pin);
+  for (auto name_mode : modes_) {
+    Sdc *sdc = name_mode.second->sdc_;
+    if (sdc != sdc_)
+      sdc->disconnectPinBefore(pin);
+  }
   sim_->disconnectPinBefore(pin);
   if (graph_) {
     if (network_->isDriver(pin)) {
@@ -4296,11 +5083,17 @@ Sta::deleteNetBefore(Net *net)
     delete pin_iter;
   }
   sdc_->deleteNetBefore(net);
+  for (auto name_mode : modes_) {
+    Sdc *sdc = name_mode.second->sdc_;
+    if (sdc != sdc_)
+      sdc->deleteNetBefore(net);
+  }
 }
 
 void
 Sta::deleteInstanceBefore(Instance *inst)
 {
+  deleteModePaths();
   if (network_->isLeaf(inst)) {
     deleteInstancePinsBefore(inst);
     deleteLeafInstanceBefore(inst);
@@ -4336,6 +5129,7 @@ Sta::deleteInstancePinsBefore(Instance *inst)
 void
 Sta::deletePinBefore(Pin *pin)
 {
+  deleteModePaths();
   if (graph_) {
     if (network_->isLoad(pin)) {
       Vertex *vertex = graph_->pinLoadVertex(pin);
@@ -4393,6 +5187,9 @@ Sta::deletePinBefore(Pin *pin)
   }
   sim_->deletePinBefore(pin);
   clk_network_->deletePinBefore(pin);
+  parasitics_->deletePinBefore(pin);
+  if (register_index_)
+    register_index_->pinChanged(pin);
 }
 
 void
@@ -4517,7 +5314,8 @@ Sta::findRegisterInstances(ClockSet *clks,
 			   bool latches)
 {
   findRegisterPreamble();
-  return findRegInstances(clks, clk_rf, edge_triggered, latches, this);
+  return findRegInstances(clks, clk_rf, edge_triggered, latches,
+			  register_index_, this);
 }
 
 PinSet *
@@ -4527,7 +5325,8 @@ Sta::findRegisterDataPins(ClockSet *clks,
 			  bool latches)
 {
   findRegisterPreamble();
-  return findRegDataPins(clks, clk_rf, edge_triggered, latches, this);
+  return findRegDataPins(clks, clk_rf, edge_triggered, latches,
+			 register_index_, this);
 }
 
 PinSet *
@@ -4537,7 +5336,8 @@ Sta::findRegisterClkPins(ClockSet *clks,
 			 bool latches)
 {
   findRegisterPreamble();
-  return findRegClkPins(clks, clk_rf, edge_triggered, latches, this);
+  return findRegClkPins(clks, clk_rf, edge_triggered, latches,
+			register_index_, this);
 }
 
 PinSet *
@@ -4547,7 +5347,8 @@ Sta::findRegisterAsyncPins(ClockSet *clks,
 			   bool latches)
 {
   findRegisterPreamble();
-  return findRegAsyncPins(clks, clk_rf, edge_triggered, latches, this);
+  return findRegAsyncPins(clks, clk_rf, edge_triggered, latches,
+			  register_index_, this);
 }
 
 PinSet *
@@ -4557,7 +5358,8 @@ Sta::findRegisterOutputPins(ClockSet *clks,
 			    bool latches)
 {
   findRegisterPreamble();
-  return findRegOutputPins(clks, clk_rf, edge_triggered, latches, this);
+  return findRegOutputPins(clks, clk_rf, edge_triggered, latches,
+			   register_index_, this);
 }
 
 void
@@ -4566,6 +5368,16 @@ Sta::findRegisterPreamble()
   ensureGraph();
   ensureGraphSdcAnnotated();
   sim_->ensureConstantsPropagated();
+  if (register_index_ == nullptr)
+    register_index_ = new RegisterIndex(this);
+}
+
+// Clocks, disables and constants change the clock fanout registers.
+void
+Sta::registerIndexInvalid()
+{
+  if (register_index_)
+    register_index_->clear();
 }
 
 ////////////////////////////////////////////////////////////////
@@ -4682,6 +5494,242 @@ FaninSrchPred::searchThruRole(Edge *edge)
     || role == TimingRole::latchEnToQ();
 }
 
+// Multi-source fanin/fanout cone search.
+// Vertices are marked in a visited bitset indexed by VertexId so all of
+// the roots share one traversal. The vertices at each level of the
+// search are expanded by the thread pool.
+// Level limits are the minimum number of edges (pin_levels) or
+// non-wire edges (inst_levels) from the roots. Searches with both
+// limits use the depth first search.
+class ConeSearch
+{
+public:
+  ConeSearch(bool fanin,
+	     bool flat,
+	     int inst_levels,
+	     int pin_levels,
+	     SearchPred *pred,
+	     const Sta *sta);
+  // Return the visited vertices in cone.
+  void findCone(VertexSeq &roots,
+		VertexSeq &cone);
+
+private:
+  void visitVertices(VertexSeq &vertices,
+		     int level,
+		     // Return values.
+		     VertexSeq &same_level,
+		     VertexSeq &next_level);
+  void visit(Vertex *vertex,
+	     int level,
+	     // Return values.
+	     VertexSeq &same_level,
+	     VertexSeq &next_level);
+  bool searchAdjacent(Vertex *vertex,
+		      int level);
+  void visitAdjacent(Edge *edge,
+		     Vertex *adj_vertex,
+		     // Return values.
+		     VertexSeq &same_level,
+		     VertexSeq &next_level);
+  bool visitedInsert(Vertex *vertex);
+  bool isVisited(Vertex *vertex) const;
+
+  bool fanin_;
+  bool flat_;
+  int inst_levels_;
+  int pin_levels_;
+  SearchPred *pred_;
+  const Sta *sta_;
+  const Graph *graph_;
+  std::vector<std::atomic<uint64_t>> visited_;
+  // Per thread same/next level vertices.
+  std::vector<VertexSeq> thread_same_levels_;
+  std::vector<VertexSeq> thread_next_levels_;
+
+  // Levels with fewer vertices are expanded by the calling thread.
+  static const size_t parallel_vertex_min_ = 1024;
+};
+
+ConeSearch::ConeSearch(bool fanin,
+		       bool flat,
+		       int inst_levels,
+		       int pin_levels,
+		       SearchPred *pred,
+		       const Sta *sta) :
+  fanin_(fanin),
+  flat_(flat),
+  inst_levels_(inst_levels),
+  pin_levels_(pin_levels),
+  pred_(pred),
+  sta_(sta),
+  graph_(sta->graph()),
+  visited_((graph_->vertexIdEnd() + 63) / 64),
+  thread_same_levels_(sta->threadCount()),
+  thread_next_levels_(sta->threadCount())
+{
+}
+
+void
+ConeSearch::findCone(VertexSeq &roots,
+		     VertexSeq &cone)
+{
+  VertexSeq level_vertices;
+  for (Vertex *root : roots) {
+    if (visitedInsert(root))
+      level_vertices.push_back(root);
+  }
+  int level = 0;
+  while (!level_vertices.empty()) {
+    VertexSeq next_level;
+    // Visit the level vertices and the vertices they reach without
+    // incrementing the level.
+    while (!level_vertices.empty()) {
+      cone.insert(cone.end(), level_vertices.begin(), level_vertices.end());
+      VertexSeq same_level;
+      visitVertices(level_vertices, level, same_level, next_level);
+      level_vertices.swap(same_level);
+    }
+    // Next level vertices are marked when the level starts so they are
+    // not claimed before a same level path reaches them.
+    for (Vertex *vertex : next_level) {
+      if (visitedInsert(vertex))
+	level_vertices.push_back(vertex);
+    }
+    debugPrint(sta_->debug(), "cone", 1, "level %d %zu vertices",
+	       level, cone.size());
+    level++;
+  }
+}
+
+void
+ConeSearch::visitVertices(VertexSeq &vertices,
+			  int level,
+			  // Return values.
+			  VertexSeq &same_level,
+			  VertexSeq &next_level)
+{
+  size_t vertex_count = vertices.size();
+  size_t thread_count = sta_->threadCount();
+  if (thread_count <= 1
+      || vertex_count < parallel_vertex_min_) {
+    for (Vertex *vertex : vertices)
+      visit(vertex, level, same_level, next_level);
+  }
+  else {
+    DispatchQueue *dispatch_queue = sta_->dispatchQueue();
+    size_t chunk_size = (vertex_count + thread_count - 1) / thread_count;
+    for (size_t start = 0; start < vertex_count; start += chunk_size) {
+      size_t end = std::min(start + chunk_size, vertex_count);
+      dispatch_queue->dispatch([this, &vertices, start, end, level](int i) {
+	for (size_t j = start; j < end; j++)
+	  visit(vertices[j], level,
+		thread_same_levels_[i], thread_next_levels_[i]);
+      });
+    }
+    dispatch_queue->finishTasks();
+    for (size_t i = 0; i < thread_count; i++) {
+      VertexSeq &thread_same = thread_same_levels_[i];
+      VertexSeq &thread_next = thread_next_levels_[i];
+      same_level.insert(same_level.end(),
+			thread_same.begin(), thread_same.end());
+      next_level.insert(next_level.end(),
+			thread_next.begin(), thread_next.end());
+      thread_same.clear();
+      thread_next.clear();
+    }
+  }
+}
+
+void
+ConeSearch::visit(Vertex *vertex,
+		  int level,
+		  // Return values.
+		  VertexSeq &same_level,
+		  VertexSeq &next_level)
+{
+  if (searchAdjacent(vertex, level)) {
+    if (fanin_) {
+      VertexInEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+	Edge *edge = edge_iter.next();
+	Vertex *from_vertex = edge->from(graph_);
+	if (pred_->searchThru(edge)
+	    && (flat_
+		|| !sta_->crossesHierarchy(edge))
+	    && pred_->searchFrom(from_vertex))
+	  visitAdjacent(edge, from_vertex, same_level, next_level);
+      }
+    }
+    else {
+      VertexOutEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+	Edge *edge = edge_iter.next();
+	Vertex *to_vertex = edge->to(graph_);
+	if (pred_->searchThru(edge)
+	    && (flat_
+		|| !sta_->crossesHierarchy(edge))
+	    && pred_->searchTo(to_vertex))
+	  visitAdjacent(edge, to_vertex, same_level, next_level);
+      }
+    }
+  }
+}
+
+bool
+ConeSearch::searchAdjacent(Vertex *vertex,
+			   int level)
+{
+  if ((inst_levels_ > 0
+       && level >= inst_levels_)
+      || (pin_levels_ > 0
+	  && level >= pin_levels_))
+    return false;
+  else if (fanin_)
+    return !sta_->network()->isRegClkPin(vertex->pin())
+      && pred_->searchTo(vertex);
+  else
+    return !sta_->search()->isEndpoint(vertex, pred_)
+      && pred_->searchFrom(vertex);
+}
+
+void
+ConeSearch::visitAdjacent(Edge *edge,
+			  Vertex *adj_vertex,
+			  // Return values.
+			  VertexSeq &same_level,
+			  VertexSeq &next_level)
+{
+  bool same = pin_levels_ <= 0
+    && (inst_levels_ <= 0
+	|| edge->role()->isWire());
+  if (same) {
+    if (visitedInsert(adj_vertex))
+      same_level.push_back(adj_vertex);
+  }
+  else if (!isVisited(adj_vertex))
+    next_level.push_back(adj_vertex);
+}
+
+// Return true if vertex was not already visited.
+bool
+ConeSearch::visitedInsert(Vertex *vertex)
+{
+  VertexId vertex_id = graph_->id(vertex);
+  uint64_t bit = uint64_t(1) << (vertex_id & 63);
+  uint64_t prev = visited_[vertex_id >> 6].fetch_or(bit,
+						    std::memory_order_relaxed);
+  return (prev & bit) == 0;
+}
+
+bool
+ConeSearch::isVisited(Vertex *vertex) const
+{
+  VertexId vertex_id = graph_->id(vertex);
+  uint64_t bit = uint64_t(1) << (vertex_id & 63);
+  return (visited_[vertex_id >> 6].load(std::memory_order_relaxed) & bit) != 0;
+}
+
 PinSet *
 Sta::findFaninPins(PinSeq *to,
 		   bool flat,
@@ -4695,6 +5743,7 @@ Sta::findFaninPins(PinSeq *to,
   ensureLevelized();
   PinSet *fanin = new PinSet;
   FaninSrchPred pred(thru_disabled, thru_constants, this);
+  VertexSeq roots;
   PinSeq::Iterator to_iter(to);
   while (to_iter.hasNext()) {
     Pin *pin = to_iter.next();
@@ -4702,14 +5751,31 @@ Sta::findFaninPins(PinSeq *to,
       EdgesThruHierPinIterator edge_iter(pin, network_, graph_);
       while (edge_iter.hasNext()) {
 	Edge *edge = edge_iter.next();
-	findFaninPins(edge->from(graph_), flat, startpoints_only,
-		      inst_levels, pin_levels, fanin, pred);
+	roots.push_back(edge->from(graph_));
       }
     }
     else {
       Vertex *vertex = graph_->pinLoadVertex(pin);
-      findFaninPins(vertex, flat, startpoints_only,
+      if (vertex)
+	roots.push_back(vertex);
+    }
+  }
+  if (inst_levels > 0
+      && pin_levels > 0) {
+    for (Vertex *root : roots)
+      findFaninPins(root, flat, startpoints_only,
 		    inst_levels, pin_levels, fanin, pred);
+  }
+  else {
+    ConeSearch cone_search(true, flat, inst_levels, pin_levels, &pred, this);
+    VertexSeq cone;
+    cone_search.findCone(roots, cone);
+    for (Vertex *vertex : cone) {
+      Pin *pin = vertex->pin();
+      if (!startpoints_only
+	  || network_->isRegClkPin(pin)
+	  || !hasFanin(vertex, &pred, graph_))
+	fanin->insert(pin);
     }
   }
   return fanin;
@@ -4805,6 +5871,7 @@ Sta::findFanoutPins(PinSeq *from,
   ensureLevelized();
   PinSet *fanout = new PinSet;
   FanInOutSrchPred pred(thru_disabled, thru_constants, this);
+  VertexSeq roots;
   PinSeq::Iterator from_iter(from);
   while (from_iter.hasNext()) {
     Pin *pin = from_iter.next();
@@ -4812,14 +5879,29 @@ Sta::findFanoutPins(PinSeq *from,
       EdgesThruHierPinIterator edge_iter(pin, network_, graph_);
       while (edge_iter.hasNext()) {
 	Edge *edge = edge_iter.next();
-	findFanoutPins(edge->to(graph_), flat, endpoints_only,
-		       inst_levels, pin_levels, fanout, pred);
+	roots.push_back(edge->to(graph_));
       }
     }
     else {
       Vertex *vertex = graph_->pinDrvrVertex(pin);
-      findFanoutPins(vertex, flat, endpoints_only,
+      if (vertex)
+	roots.push_back(vertex);
+    }
+  }
+  if (inst_levels > 0
+      && pin_levels > 0) {
+    for (Vertex *root : roots)
+      findFanoutPins(root, flat, endpoints_only,
 		     inst_levels, pin_levels, fanout, pred);
+  }
+  else {
+    ConeSearch cone_search(false, flat, inst_levels, pin_levels, &pred, this);
+    VertexSeq cone;
+    cone_search.findCone(roots, cone);
+    for (Vertex *vertex : cone) {
+      if (!endpoints_only
+	  || search_->isEndpoint(vertex, &pred))
+	fanout->insert(vertex->pin());
     }
   }
   return fanout;
@@ -5349,7 +6431,8 @@ Sta::makeEquivCells(LibertyLibrarySeq *equiv_libs,
 		    LibertyLibrarySeq *map_libs)
 {
   delete equiv_cells_;
-  equiv_cells_ = new EquivCells(equiv_libs, map_libs);
+  equiv_cells_ = new EquivCells(equiv_libs, map_libs,
+				corners_->count() * MinMax::index_count);
 }
 
 LibertyCellSeq *
@@ -5361,6 +6444,17 @@ Sta::equivCells(LibertyCell *cell)
     return nullptr;
 }
 
+LibertyCellSeq *
+Sta::equivCells(LibertyCell *cell,
+		const Corner *corner,
+		const MinMax *min_max)
+{
+  if (equiv_cells_)
+    return equiv_cells_->equivs(cell, corner->libertyIndex(min_max));
+  else
+    return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////
 void
 Sta::powerPreamble()
@@ -5430,6 +6524,7 @@ void
 Sta::clkPinsInvalid()
 {
   clk_network_->clkPinsInvalid();
+  registerIndexInvalid();
 }
 
 } // namespace
@@ -0,0 +1,194 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "TimingPartition.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include "Report.hh"
+#include "Debug.hh"
+#include "TimingRole.hh"
+#include "Graph.hh"
+#include "ClkNetwork.hh"
+#include "Search.hh"
+
+namespace sta {
+
+TimingPartitions::TimingPartitions(const StaState *sta) :
+  StaState(sta)
+{
+}
+
+void
+TimingPartitions::findPartitions()
+{
+  size_t id_end = graph_->vertexIdEnd();
+  parents_.resize(id_end);
+  for (size_t i = 0; i < id_end; i++)
+    parents_[i] = i;
+  partitions_.clear();
+
+  VertexIterator vertex_iter(graph_);
+  while (vertex_iter.hasNext()) {
+    Vertex *vertex = vertex_iter.next();
+    if (isPartitionVertex(vertex)) {
+      VertexOutEdgeIterator edge_iter(vertex, graph_);
+      while (edge_iter.hasNext()) {
+	Edge *edge = edge_iter.next();
+	Vertex *to_vertex = edge->to(graph_);
+	if (isPartitionEdge(edge)
+	    && isPartitionVertex(to_vertex))
+	  merge(graph_->id(vertex), graph_->id(to_vertex));
+      }
+    }
+  }
+
+  // Number the partitions by root vertex.
+  std::vector<int> root_index(id_end, partition_none);
+  partition_index_.assign(id_end, partition_none);
+  VertexIterator vertex_iter2(graph_);
+  while (vertex_iter2.hasNext()) {
+    Vertex *vertex = vertex_iter2.next();
+    if (isPartitionVertex(vertex)) {
+      VertexId vertex_id = graph_->id(vertex);
+      VertexId root = findRoot(vertex_id);
+      int index = root_index[root];
+      if (index == partition_none) {
+	index = partitions_.size();
+	root_index[root] = index;
+	partitions_.push_back({0, 0,
+			       std::numeric_limits<Level>::max(),
+			       std::numeric_limits<Level>::min()});
+      }
+      partition_index_[vertex_id] = index;
+      TimingPartition &partition = partitions_[index];
+      partition.vertex_count_++;
+      if (search_->isEndpoint(vertex))
+	partition.endpoint_count_++;
+      Level level = vertex->level();
+      partition.level_min_ = std::min(partition.level_min_, level);
+      partition.level_max_ = std::max(partition.level_max_, level);
+    }
+  }
+  parents_.clear();
+  parents_.shrink_to_fit();
+
+  // Sort by decreasing size and renumber the vertex partitions.
+  size_t partition_count = partitions_.size();
+  std::vector<int> order(partition_count);
+  for (size_t i = 0; i < partition_count; i++)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+		   [this] (int index1, int index2) {
+		     return partitions_[index1].vertex_count_
+		       > partitions_[index2].vertex_count_;
+		   });
+  std::vector<int> renumber(partition_count);
+  TimingPartitionSeq sorted(partition_count);
+  for (size_t i = 0; i < partition_count; i++) {
+    renumber[order[i]] = i;
+    sorted[i] = partitions_[order[i]];
+  }
+  partitions_.swap(sorted);
+  for (int &index : partition_index_) {
+    if (index != partition_none)
+      index = renumber[index];
+  }
+  debugPrint(debug_, "partition", 1, "%zu partitions", partition_count);
+}
+
+// The clock network is shared by the partitions it clocks.
+bool
+TimingPartitions::isPartitionVertex(Vertex *vertex)
+{
+  return !clk_network_->isClock(vertex->pin());
+}
+
+// Data paths end at timing checks and start again at register outputs.
+bool
+TimingPartitions::isPartitionEdge(Edge *edge)
+{
+  const TimingRole *role = edge->role();
+  return !role->isTimingCheck()
+    && role != TimingRole::regClkToQ()
+    && role != TimingRole::latchEnToQ();
+}
+
+VertexId
+TimingPartitions::findRoot(VertexId vertex_id)
+{
+  // Path halving.
+  while (parents_[vertex_id] != vertex_id) {
+    parents_[vertex_id] = parents_[parents_[vertex_id]];
+    vertex_id = parents_[vertex_id];
+  }
+  return vertex_id;
+}
+
+void
+TimingPartitions::merge(VertexId vertex_id1,
+			VertexId vertex_id2)
+{
+  VertexId root1 = findRoot(vertex_id1);
+  VertexId root2 = findRoot(vertex_id2);
+  if (root1 < root2)
+    parents_[root2] = root1;
+  else if (root2 < root1)
+    parents_[root1] = root2;
+}
+
+int
+TimingPartitions::partitionIndex(const Vertex *vertex) const
+{
+  VertexId vertex_id = graph_->id(vertex);
+  if (vertex_id < partition_index_.size())
+    return partition_index_[vertex_id];
+  else
+    return partition_none;
+}
+
+void
+TimingPartitions::reportPartitions(int count)
+{
+  size_t vertex_count = 0;
+  size_t endpoint_count = 0;
+  for (const TimingPartition &partition : partitions_) {
+    vertex_count += partition.vertex_count_;
+    endpoint_count += partition.endpoint_count_;
+  }
+  report_->reportLine("Partitions %zu", partitions_.size());
+  report_->reportLine("Vertices   %zu", vertex_count);
+  report_->reportLine("Endpoints  %zu", endpoint_count);
+  report_->reportBlankLine();
+  size_t report_count = std::min(static_cast<size_t>(count),
+				 partitions_.size());
+  if (report_count > 0) {
+    report_->reportLine("Partition  Vertices Endpoints    Levels");
+    report_->reportLine("---------------------------------------");
+    for (size_t i = 0; i < report_count; i++) {
+      const TimingPartition &partition = partitions_[i];
+      report_->reportLine("%9zu %9zu %9zu %4d-%-4d",
+			  i,
+			  partition.vertex_count_,
+			  partition.endpoint_count_,
+			  partition.level_min_,
+			  partition.level_max_);
+    }
+  }
+}
+
+} // namespace
@@ -0,0 +1,78 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <vector>
+
+#include "DisallowCopyAssign.hh"
+#include "GraphClass.hh"
+#include "StaState.hh"
+
+namespace sta {
+
+class TimingPartition
+{
+public:
+  size_t vertex_count_;
+  size_t endpoint_count_;
+  Level level_min_;
+  Level level_max_;
+};
+
+typedef std::vector<TimingPartition> TimingPartitionSeq;
+
+// Partition the timing graph at register boundaries.
+// Two vertices are in the same partition if they are connected by
+// data edges. Register clock to output edges, timing checks and the
+// clock network are not followed, so a partition is a cloud of logic
+// between register outputs/input ports and register data pins/output
+// ports. Data arrivals in one partition do not depend on another
+// partition, so partitions can be timed independently once the clock
+// network arrivals are known.
+class TimingPartitions : public StaState
+{
+public:
+  explicit TimingPartitions(const StaState *sta);
+  // Requires a levelized graph and clock network.
+  void findPartitions();
+  // Partitions are sorted by decreasing vertex count.
+  const TimingPartitionSeq &partitions() const { return partitions_; }
+  // Partition index of vertex, or partition_none for vertices in the
+  // clock network.
+  int partitionIndex(const Vertex *vertex) const;
+  // Report the count largest partitions.
+  void reportPartitions(int count);
+
+  static const int partition_none = -1;
+
+protected:
+  bool isPartitionVertex(Vertex *vertex);
+  bool isPartitionEdge(Edge *edge);
+  VertexId findRoot(VertexId vertex_id);
+  void merge(VertexId vertex_id1,
+	     VertexId vertex_id2);
+
+  // Union-find parents and then partition indices indexed by VertexId.
+  std::vector<VertexId> parents_;
+  std::vector<int> partition_index_;
+  TimingPartitionSeq partitions_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(TimingPartitions);
+};
+
+} // namespace
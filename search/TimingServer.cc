@@ -0,0 +1,634 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "TimingServer.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+#if !(defined(_WINDOWS) || defined(_WIN32))
+  #include <unistd.h>
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <sys/un.h>
+#endif
+#include <tcl.h>
+
+#include "Error.hh"
+#include "Debug.hh"
+#include "Report.hh"
+#include "Units.hh"
+#include "Transition.hh"
+#include "Network.hh"
+#include "Graph.hh"
+#include "Corner.hh"
+#include "DcalcAnalysisPt.hh"
+#include "PathVertex.hh"
+#include "PathRef.hh"
+#include "PathExpanded.hh"
+#include "Sta.hh"
+
+namespace sta {
+
+using std::vector;
+
+class TimingServerUpdate
+{
+public:
+  explicit TimingServerUpdate(const char *cmd) :
+    cmd_(cmd),
+    done_(false)
+  {}
+
+  string cmd_;
+  string result_;
+  bool done_;
+};
+
+TimingServer::TimingServer(Sta *sta) :
+  StaState(sta),
+  sta_(sta),
+  listen_fd_(-1),
+  shutdown_(false)
+{
+  wakeup_fds_[0] = -1;
+  wakeup_fds_[1] = -1;
+  for (int mm_index : MinMax::rangeIndex()) {
+    worst_slack_[mm_index] = MinMax::min()->initValue();
+    tns_[mm_index] = 0.0;
+  }
+}
+
+TimingServer::~TimingServer()
+{
+  stop();
+}
+
+#if defined(_WINDOWS) || defined(_WIN32)
+
+// Unix domain sockets and poll are not available.
+bool
+TimingServer::serve(const char *)
+{
+  report_->error(630, "timing server is not supported on Windows.");
+  return false;
+}
+
+void
+TimingServer::stop()
+{
+  {
+    UniqueLock lock(update_lock_);
+    shutdown_ = true;
+  }
+  failUpdates("error server is shutting down");
+}
+
+void
+TimingServer::wakeup()
+{
+}
+
+#else
+
+static bool
+sendString(int fd,
+	   const string &str);
+
+bool
+TimingServer::serve(const char *socket_path)
+{
+  struct sockaddr_un addr;
+  if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+    report_->error(617, "timing server socket path %s is too long.",
+		   socket_path);
+    return false;
+  }
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    report_->error(618, "timing server socket failed: %s.", strerror(errno));
+    return false;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socket_path);
+  unlink(socket_path);
+  if (bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr),
+	   sizeof(addr)) < 0
+      || listen(listen_fd_, SOMAXCONN) < 0
+      || pipe(wakeup_fds_) < 0) {
+    report_->error(619, "timing server cannot listen on %s: %s.",
+		   socket_path, strerror(errno));
+    stop();
+    return false;
+  }
+
+  {
+    WriteLock lock(timing_lock_);
+    updateTiming();
+  }
+  report_->reportLine("Timing server listening on %s", socket_path);
+
+  bool shutdown = false;
+  while (!shutdown) {
+    struct pollfd fds[2];
+    fds[0].fd = listen_fd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = wakeup_fds_[0];
+    fds[1].events = POLLIN;
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR)
+	continue;
+      report_->warn(629, "timing server poll failed: %s.", strerror(errno));
+      break;
+    }
+    if (fds[1].revents & POLLIN) {
+      char buffer[64];
+      if (read(wakeup_fds_[0], buffer, sizeof(buffer)) < 0)
+	break;
+      processUpdates();
+    }
+    if (fds[0].revents & POLLIN) {
+      int client_fd = accept(listen_fd_, nullptr, nullptr);
+      if (client_fd >= 0) {
+	debugPrint(debug_, "timing_server", 1, "client %d connected",
+		   client_fd);
+	UniqueLock lock(client_lock_);
+	clients_[client_fd] = new std::thread(&TimingServer::clientThread,
+					      this, client_fd);
+      }
+    }
+    reapClients();
+    UniqueLock lock(update_lock_);
+    shutdown = shutdown_;
+  }
+  {
+    // Client threads do not queue updates once shutdown_ is set,
+    // including when the loop exits because poll failed.
+    UniqueLock lock(update_lock_);
+    shutdown_ = true;
+  }
+  // Answer updates that were queued before the shutdown.
+  processUpdates();
+  stop();
+  unlink(socket_path);
+  report_->reportLine("Timing server stopped");
+  return true;
+}
+
+void
+TimingServer::stop()
+{
+  {
+    UniqueLock lock(update_lock_);
+    shutdown_ = true;
+  }
+  // Client threads waiting for updates are joined below.
+  failUpdates("error server is shutting down");
+  // Unblock the client threads waiting on reads.
+  {
+    UniqueLock lock(client_lock_);
+    for (auto fd_thread : clients_)
+      ::shutdown(fd_thread.first, SHUT_RDWR);
+  }
+  for (auto fd_thread : clients_) {
+    std::thread *thread = fd_thread.second;
+    thread->join();
+    delete thread;
+    close(fd_thread.first);
+  }
+  clients_.clear();
+  finished_clients_.clear();
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+    listen_fd_ = -1;
+  }
+  for (int i = 0; i < 2; i++) {
+    if (wakeup_fds_[i] >= 0) {
+      close(wakeup_fds_[i]);
+      wakeup_fds_[i] = -1;
+    }
+  }
+}
+
+// Join client threads that have finished and close their sockets.
+// Sockets are only closed here so a descriptor is not reused while
+// it is still in clients_.
+void
+TimingServer::reapClients()
+{
+  UniqueLock lock(client_lock_);
+  for (int client_fd : finished_clients_) {
+    std::thread *thread = clients_.findKey(client_fd);
+    thread->join();
+    delete thread;
+    clients_.erase(client_fd);
+    close(client_fd);
+  }
+  finished_clients_.clear();
+}
+
+void
+TimingServer::wakeup()
+{
+  char byte = 0;
+  if (write(wakeup_fds_[1], &byte, 1) < 0)
+    debugPrint(debug_, "timing_server", 1, "wakeup failed");
+}
+
+////////////////////////////////////////////////////////////////
+
+void
+TimingServer::clientThread(int client_fd)
+{
+  string pending;
+  bool close = false;
+  bool shutdown = false;
+  char buffer[4096];
+  while (!close) {
+    ssize_t length = recv(client_fd, buffer, sizeof(buffer), 0);
+    if (length <= 0)
+      break;
+    pending.append(buffer, length);
+    size_t eol;
+    while (!close
+	   && (eol = pending.find('\n')) != string::npos) {
+      string request = pending.substr(0, eol);
+      pending.erase(0, eol + 1);
+      if (!request.empty() && request.back() == '\r')
+	request.pop_back();
+      string response;
+      handleRequest(request, response, close, shutdown);
+      if (!response.empty()
+	  && !sendString(client_fd, response + "\n"))
+	close = true;
+    }
+  }
+  debugPrint(debug_, "timing_server", 1, "client %d disconnected", client_fd);
+  if (shutdown) {
+    UniqueLock lock(update_lock_);
+    shutdown_ = true;
+  }
+  {
+    UniqueLock lock(client_lock_);
+    finished_clients_.push_back(client_fd);
+  }
+  wakeup();
+}
+
+static bool
+sendString(int fd,
+	   const string &str)
+{
+  const char *buffer = str.c_str();
+  size_t length = str.size();
+  while (length > 0) {
+    ssize_t sent = send(fd, buffer, length, MSG_NOSIGNAL);
+    if (sent <= 0)
+      return false;
+    buffer += sent;
+    length -= sent;
+  }
+  return true;
+}
+
+#endif
+
+void
+TimingServer::handleRequest(const string &request,
+			    // Return values.
+			    string &response,
+			    bool &close,
+			    bool &shutdown)
+{
+  size_t cmd_end = request.find(' ');
+  string cmd = request.substr(0, cmd_end);
+  const char *args = (cmd_end == string::npos)
+    ? ""
+    : request.c_str() + cmd_end + 1;
+  debugPrint(debug_, "timing_server", 2, "request %s", request.c_str());
+  if (cmd.empty())
+    response.clear();
+  else if (cmd == "quit")
+    close = true;
+  else if (cmd == "shutdown") {
+    response = "ok";
+    close = true;
+    shutdown = true;
+  }
+  else if (cmd == "eval")
+    response = updateRequest(args);
+  else {
+    ReadLock lock(timing_lock_);
+    response = readRequest(cmd, args);
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+// Parse optional rise/fall and min/max keywords.
+static bool
+parseRfMinMax(const vector<string> &tokens,
+	      // Return values.
+	      const RiseFall *&rf,
+	      const MinMax *&min_max)
+{
+  for (size_t i = 1; i < tokens.size(); i++) {
+    const char *token = tokens[i].c_str();
+    RiseFall *rf1 = RiseFall::find(token);
+    MinMax *min_max1 = MinMax::find(token);
+    if (rf1)
+      rf = rf1;
+    else if (min_max1)
+      min_max = min_max1;
+    else
+      return false;
+  }
+  return true;
+}
+
+string
+TimingServer::readRequest(const string &cmd,
+			  const char *args)
+{
+  vector<string> tokens;
+  const char *token_begin = args;
+  while (*token_begin) {
+    const char *token_end = strchr(token_begin, ' ');
+    if (token_end == nullptr)
+      token_end = token_begin + strlen(token_begin);
+    if (token_end != token_begin)
+      tokens.push_back(string(token_begin, token_end));
+    token_begin = *token_end ? token_end + 1 : token_end;
+  }
+
+  const RiseFall *rf = nullptr;
+  const MinMax *min_max = MinMax::max();
+  if (cmd == "worst_slack" || cmd == "tns") {
+    tokens.insert(tokens.begin(), string());
+    if (!parseRfMinMax(tokens, rf, min_max) || rf)
+      return "error usage: " + cmd + " [min|max]";
+    Slack value = (cmd == "tns")
+      ? tns_[min_max->index()]
+      : worst_slack_[min_max->index()];
+    return "ok " + timeString(delayAsFloat(value));
+  }
+
+  if (cmd != "slack"
+      && cmd != "arrival"
+      && cmd != "required"
+      && cmd != "slew"
+      && cmd != "path")
+    return "error unknown request " + cmd;
+  if (tokens.empty()
+      || !parseRfMinMax(tokens, rf, min_max))
+    return "error usage: " + cmd + " pin [rise|fall] [min|max]";
+  Vertex *bidirect_drvr_vertex;
+  Vertex *vertex = findVertex(tokens[0].c_str(), bidirect_drvr_vertex);
+  if (vertex == nullptr)
+    return "error pin " + tokens[0] + " not found";
+
+  if (cmd == "slack") {
+    Slack slack = vertexSlack(vertex, min_max);
+    if (bidirect_drvr_vertex) {
+      Slack slack1 = vertexSlack(bidirect_drvr_vertex, min_max);
+      if (delayLess(slack1, slack, this))
+	slack = slack1;
+    }
+    return "ok " + timeString(delayAsFloat(slack));
+  }
+  else if (cmd == "arrival" || cmd == "required") {
+    bool arrival = (cmd == "arrival");
+    Delay value = arrival ? min_max->initValue() : min_max->opposite()->initValue();
+    VertexPathIterator path_iter(bidirect_drvr_vertex
+				 ? bidirect_drvr_vertex
+				 : vertex, this);
+    while (path_iter.hasNext()) {
+      Path *path = path_iter.next();
+      if (path->minMax(this) == min_max
+	  && (rf == nullptr || path->transition(this) == rf)) {
+	if (arrival) {
+	  Arrival arr = path->arrival(this);
+	  if (delayGreater(arr, value, min_max, this))
+	    value = arr;
+	}
+	else {
+	  const Required &req = path->required(this);
+	  if (delayGreater(req, value, min_max->opposite(), this))
+	    value = req;
+	}
+      }
+    }
+    return "ok " + timeString(delayAsFloat(value));
+  }
+  else if (cmd == "slew") {
+    Slew slew = min_max->initValue();
+    Vertex *slew_vertex = bidirect_drvr_vertex ? bidirect_drvr_vertex : vertex;
+    for (Corner *corner : *corners_) {
+      const DcalcAnalysisPt *dcalc_ap = corner->findDcalcAnalysisPt(min_max);
+      for (RiseFall *rf1 : RiseFall::range()) {
+	if (rf == nullptr || rf1 == rf) {
+	  const Slew &slew1 = graph_->slew(slew_vertex, rf1, dcalc_ap->index());
+	  if (delayGreater(slew1, slew, min_max, this))
+	    slew = slew1;
+	}
+      }
+    }
+    return "ok " + timeString(delayAsFloat(slew));
+  }
+  else {
+    // path
+    Path *path = worstSlackPath(vertex, min_max);
+    if (path == nullptr)
+      return "error no path to " + tokens[0];
+    string response = "ok";
+    PathExpanded expanded(path, false, this);
+    for (size_t i = expanded.startIndex(); i < expanded.size(); i++) {
+      PathRef *path1 = expanded.path(i);
+      response += " ";
+      response += network_->pathName(path1->pin(this));
+      response += " ";
+      response += path1->transition(this)->asString();
+      response += " ";
+      response += timeString(delayAsFloat(path1->arrival(this)));
+    }
+    return response;
+  }
+}
+
+Vertex *
+TimingServer::findVertex(const char *pin_name,
+			 // Return value.
+			 Vertex *&bidirect_drvr_vertex) const
+{
+  Vertex *vertex = nullptr;
+  bidirect_drvr_vertex = nullptr;
+  Pin *pin = sta_->cmdNetwork()->findPin(pin_name);
+  if (pin)
+    graph_->pinVertices(pin, vertex, bidirect_drvr_vertex);
+  return vertex;
+}
+
+Slack
+TimingServer::vertexSlack(Vertex *vertex,
+			  const MinMax *min_max) const
+{
+  Slack slack = MinMax::min()->initValue();
+  VertexPathIterator path_iter(vertex, this);
+  while (path_iter.hasNext()) {
+    Path *path = path_iter.next();
+    if (path->minMax(this) == min_max) {
+      Slack path_slack = path->slack(this);
+      if (delayLess(path_slack, slack, this))
+	slack = path_slack;
+    }
+  }
+  return slack;
+}
+
+Path *
+TimingServer::worstSlackPath(Vertex *vertex,
+			     const MinMax *min_max) const
+{
+  Path *worst_path = nullptr;
+  Slack worst_slack = MinMax::min()->initValue();
+  VertexPathIterator path_iter(vertex, this);
+  while (path_iter.hasNext()) {
+    Path *path = path_iter.next();
+    if (path->minMax(this) == min_max) {
+      Slack path_slack = path->slack(this);
+      if (worst_path == nullptr
+	  || delayLess(path_slack, worst_slack, this)) {
+	worst_path = path;
+	worst_slack = path_slack;
+      }
+    }
+  }
+  return worst_path;
+}
+
+string
+TimingServer::timeString(float value) const
+{
+  if (value >= INF)
+    return "INF";
+  else if (value <= -INF)
+    return "-INF";
+  else {
+    const Unit *time_unit = units_->timeUnit();
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f",
+	     time_unit->digits() + 3, value / time_unit->scale());
+    return buffer;
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+string
+TimingServer::updateRequest(const char *cmd)
+{
+  TimingServerUpdate update(cmd);
+  {
+    UniqueLock lock(update_lock_);
+    if (shutdown_)
+      return "error server is shutting down";
+    updates_.push(&update);
+  }
+  wakeup();
+  UniqueLock lock(update_lock_);
+  update_done_.wait(lock, [&update] { return update.done_; });
+  return update.result_;
+}
+
+// Run queued updates in the interpreter thread.
+void
+TimingServer::processUpdates()
+{
+  Tcl_Interp *interp = sta_->tclInterp();
+  while (true) {
+    TimingServerUpdate *update;
+    {
+      UniqueLock lock(update_lock_);
+      if (updates_.empty())
+	break;
+      update = updates_.front();
+      updates_.pop();
+    }
+    string result;
+    {
+      WriteLock lock(timing_lock_);
+      report_->redirectStringBegin();
+      int code = Tcl_Eval(interp, update->cmd_.c_str());
+      string output = report_->redirectStringEnd();
+      string tcl_result = Tcl_GetStringResult(interp);
+      try {
+	updateTiming();
+      }
+      catch (Exception &excp) {
+	code = TCL_ERROR;
+	tcl_result = excp.what();
+      }
+      result = (code == TCL_OK) ? "ok" : "error";
+      // Responses are one line.
+      string text = output + tcl_result;
+      for (char &ch : text) {
+	if (ch == '\n')
+	  ch = ' ';
+      }
+      if (!text.empty())
+	result += " " + text;
+    }
+    UniqueLock lock(update_lock_);
+    update->result_ = result;
+    update->done_ = true;
+    update_done_.notify_all();
+  }
+}
+
+// Answer queued updates without running them.
+void
+TimingServer::failUpdates(const char *result)
+{
+  UniqueLock lock(update_lock_);
+  while (!updates_.empty()) {
+    TimingServerUpdate *update = updates_.front();
+    updates_.pop();
+    update->result_ = result;
+    update->done_ = true;
+  }
+  update_done_.notify_all();
+}
+
+// Bring arrivals, requireds and the slack summaries up to date so
+// read requests do not have to.
+void
+TimingServer::updateTiming()
+{
+  if (network_->isLinked()) {
+    sta_->updateTiming(false);
+    sta_->findRequireds();
+    for (MinMax *min_max : MinMax::range()) {
+      int mm_index = min_max->index();
+      Vertex *worst_vertex;
+      sta_->worstSlack(min_max, worst_slack_[mm_index], worst_vertex);
+      tns_[mm_index] = sta_->totalNegativeSlack(min_max);
+    }
+  }
+}
+
+} // namespace
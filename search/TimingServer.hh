@@ -0,0 +1,123 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2021, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <thread>
+#include <queue>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+#include "DisallowCopyAssign.hh"
+#include "Map.hh"
+#include "MinMax.hh"
+#include "Delay.hh"
+#include "GraphClass.hh"
+#include "StaState.hh"
+#include "Mutex.hh"
+
+namespace sta {
+
+using std::string;
+
+class Sta;
+class Path;
+class TimingServerUpdate;
+
+// Persistent timing server.
+// Clients connect to a local (unix domain) socket and send one request
+// per line.  Each request gets a one line response that starts with
+// "ok" or "error".
+//
+//  slack <pin> [min|max]
+//  arrival <pin> [rise|fall] [min|max]
+//  required <pin> [rise|fall] [min|max]
+//  slew <pin> [rise|fall] [min|max]
+//  path <pin> [min|max]           worst slack path to pin
+//  worst_slack [min|max]
+//  tns [min|max]
+//  eval <tcl command>             update the design/constraints
+//  quit                           close the connection
+//  shutdown                       stop the server
+//
+// Times are in user time units.  Read only requests from any number of
+// clients are answered concurrently while holding a read lock.  Eval
+// requests are serialized and run by the Tcl interpreter thread while
+// holding the write lock.  Timing is brought up to date before the write
+// lock is released so read requests never trigger incremental updates.
+class TimingServer : public StaState
+{
+public:
+  explicit TimingServer(Sta *sta);
+  ~TimingServer();
+  // Serve requests on socket_path until a client sends "shutdown".
+  // Not supported on Windows.
+  // Must be called from the thread that owns the Tcl interpreter.
+  // Return true if the server started.
+  bool serve(const char *socket_path);
+
+protected:
+  void clientThread(int client_fd);
+  void handleRequest(const string &request,
+		     // Return values.
+		     string &response,
+		     bool &close,
+		     bool &shutdown);
+  string readRequest(const string &cmd,
+		     const char *args);
+  string updateRequest(const char *cmd);
+  void processUpdates();
+  void failUpdates(const char *result);
+  void updateTiming();
+  void wakeup();
+  void reapClients();
+  void stop();
+  Vertex *findVertex(const char *pin_name,
+		     // Return value.
+		     Vertex *&bidirect_drvr_vertex) const;
+  Slack vertexSlack(Vertex *vertex,
+		    const MinMax *min_max) const;
+  Path *worstSlackPath(Vertex *vertex,
+		       const MinMax *min_max) const;
+  string timeString(float value) const;
+
+  Sta *sta_;
+  // Readers hold the lock for queries, updates hold it exclusively.
+  ReadWriteLock timing_lock_;
+  // Worst/total negative slack cached by updateTiming.
+  Slack worst_slack_[MinMax::index_count];
+  Slack tns_[MinMax::index_count];
+
+  // Updates queued by client threads for the interpreter thread.
+  std::queue<TimingServerUpdate*> updates_;
+  std::mutex update_lock_;
+  std::condition_variable update_done_;
+
+  int listen_fd_;
+  // Pipe used by client threads to wake up the interpreter thread.
+  int wakeup_fds_[2];
+  bool shutdown_;
+  std::mutex client_lock_;
+  Map<int, std::thread*> clients_;
+  std::vector<int> finished_clients_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(TimingServer);
+};
+
+} // namespace
@@ -19,6 +19,8 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <exception>
+#include <vector>
 
 #include "Debug.hh"
 #include "Error.hh"
@@ -39,7 +41,9 @@
 #include "PathAnalysisPt.hh"
 #include "Path.hh"
 #include "PathRef.hh"
+#include "PathEnd.hh"
 #include "PathExpanded.hh"
+#include "DispatchQueue.hh"
 #include "StaState.hh"
 #include "Sim.hh"
 
@@ -49,7 +53,9 @@ using std::string;
 using std::ofstream;
 using std::ifstream;
 
-typedef Map<string, StringVector*> CellSpicePortNames;
+class LibSubckt;
+
+typedef Map<string, LibSubckt*> LibSubcktMap;
 typedef int Stage;
 typedef Map<ParasiticNode*, int> ParasiticNodeMap;
 typedef Map<LibertyPort*, LogicValue> LibertyPortLogicValues;
@@ -61,13 +67,49 @@ streamPrint(ofstream &stream,
 
 ////////////////////////////////////////////////////////////////
 
+// Cell subckt definition in a library subckt file.
+class LibSubckt
+{
+public:
+  // .subckt thru .ends lines.
+  string text_;
+  StringVector port_names_;
+  bool has_ends_;
+  // Position in the library subckt file.
+  size_t index_;
+};
+
+// Library subckt file index by cell name.
+// The file is read once and shared read-only by path writers.
+class LibSubckts : public StaState
+{
+public:
+  LibSubckts(const char *lib_subckt_filename,
+	     const char *power_name,
+	     const char *gnd_name,
+	     const StaState *sta);
+  ~LibSubckts();
+  void read();
+  const LibSubckt *findSubckt(const char *cell_name) const;
+  const char *filename() const { return lib_subckt_filename_; }
+
+private:
+  void checkSpicePortNames(const char *cell_name,
+			   StringVector &port_names);
+
+  const char *lib_subckt_filename_;
+  const char *power_name_;
+  const char *gnd_name_;
+  LibSubcktMap subckts_;
+};
+
 class WritePathSpice : public StaState
 {
 public:
   WritePathSpice(Path *path,
 		 const char *spice_filename,
 		 const char *subckt_filename,
-		 const char *lib_subckt_filename,
+		 const LibSubckts *lib_subckts,
 		 const char *model_filename,
 		 const char *power_name,
 		 const char *gnd_name,
@@ -100,8 +142,7 @@ private:
   void writeSubckts();
   void findPathCellnames(// Return values.
 			 StringSet &path_cell_names);
-  void recordSpicePortNames(const char *cell_name,
-			    StringVector &tokens);
+  const StringVector *spicePortNames(const char *cell_name);
   float maxTime();
   const char *nodeName(ParasiticNode *node);
   void initNodeMap(const char *net_name);
@@ -162,6 +203,9 @@ private:
 			  int &volt_index);
   float slewAxisMinValue(TimingArc *arc);
   float pgPortVoltage(LibertyPgPort *pg_port);
+  void error(int id,
+	     const char *fmt,
+	     ...) __attribute__((format (printf, 3, 4)));
 
   // Stage "accessors".
   //
@@ -203,14 +247,13 @@ private:
   Path *path_;
   const char *spice_filename_;
   const char *subckt_filename_;
-  const char *lib_subckt_filename_;
+  const LibSubckts *lib_subckts_;
   const char *model_filename_;
   const char *power_name_;
   const char *gnd_name_;
 
   ofstream spice_stream_;
   PathExpanded path_expanded_;
-  CellSpicePortNames cell_spice_port_names_;
   ParasiticNodeMap node_map_;
   int next_node_index_;
   const char *net_name_;
@@ -252,6 +295,36 @@ SubcktEndsMissing::what() const noexcept
   return what_.c_str();
 }
 
+// Writers run on dispatch queue threads and Report is not thread safe,
+// so writer errors are thrown with the message id and reported by the
+// main thread after the writers finish.
+class PathSpiceError : public Exception
+{
+public:
+  PathSpiceError(int id,
+		 const char *msg);
+  int id() const { return id_; }
+  const char *what() const noexcept;
+
+protected:
+  int id_;
+  string msg_;
+};
+
+PathSpiceError::PathSpiceError(int id,
+			       const char *msg) :
+  Exception(),
+  id_(id),
+  msg_(msg)
+{
+}
+
+const char *
+PathSpiceError::what() const noexcept
+{
+  return msg_.c_str();
+}
+
 ////////////////////////////////////////////////////////////////
 
 void
@@ -264,16 +337,83 @@ writePathSpice(Path *path,
 	       const char *gnd_name,
 	       StaState *sta)
 {
+  LibSubckts lib_subckts(lib_subckt_filename, power_name, gnd_name, sta);
+  lib_subckts.read();
   WritePathSpice writer(path, spice_filename, subckt_filename,
-			lib_subckt_filename, model_filename,
+			&lib_subckts, model_filename,
 			power_name, gnd_name, sta);
-  writer.writeSpice();
+  try {
+    writer.writeSpice();
+  }
+  catch (PathSpiceError &error) {
+    sta->report()->error(error.id(), "%s", error.what());
+  }
+}
+
+void
+writePathSpice(PathEndSeq *path_ends,
+	       const char *spice_directory,
+	       const char *lib_subckt_filename,
+	       const char *model_filename,
+	       const char *power_name,
+	       const char *gnd_name,
+	       StaState *sta)
+{
+  // The Tcl typemap makes an empty path end list null.
+  if (path_ends == nullptr || path_ends->empty())
+    return;
+  LibSubckts lib_subckts(lib_subckt_filename, power_name, gnd_name, sta);
+  lib_subckts.read();
+  size_t path_count = path_ends->size();
+  std::vector<string> spice_filenames(path_count);
+  std::vector<string> subckt_filenames(path_count);
+  for (size_t i = 0; i < path_count; i++) {
+    string path_name = stdstrPrint("%s/path_%zu", spice_directory, i + 1);
+    spice_filenames[i] = path_name + ".sp";
+    subckt_filenames[i] = path_name + ".subckt";
+  }
+  // Exceptions thrown by the writers are rethrown in path order
+  // after all of the writers finish.
+  std::vector<std::exception_ptr> exceptions(path_count);
+  auto write_path = [&](size_t i) {
+    try {
+      WritePathSpice writer((*path_ends)[i]->path(),
+			    spice_filenames[i].c_str(),
+			    subckt_filenames[i].c_str(),
+			    &lib_subckts, model_filename,
+			    power_name, gnd_name, sta);
+      writer.writeSpice();
+    }
+    catch (...) {
+      exceptions[i] = std::current_exception();
+    }
+  };
+  DispatchQueue *dispatch_queue = sta->dispatchQueue();
+  if (dispatch_queue && path_count > 1) {
+    for (size_t i = 0; i < path_count; i++)
+      dispatch_queue->dispatch([&write_path, i](int) { write_path(i); });
+    dispatch_queue->finishTasks();
+  }
+  else {
+    for (size_t i = 0; i < path_count; i++)
+      write_path(i);
+  }
+  for (std::exception_ptr &excp : exceptions) {
+    if (excp) {
+      try {
+	std::rethrow_exception(excp);
+      }
+      catch (PathSpiceError &error) {
+	sta->report()->error(error.id(), "%s", error.what());
+      }
+    }
+  }
 }
 
 WritePathSpice::WritePathSpice(Path *path,
 			       const char *spice_filename,
 			       const char *subckt_filename,
-			       const char *lib_subckt_filename,
+			       const LibSubckts *lib_subckts,
 			       const char *model_filename,
 			       const char *power_name,
 			       const char *gnd_name,
@@ -282,7 +422,7 @@ WritePathSpice::WritePathSpice(Path *path,
   path_(path),
   spice_filename_(spice_filename),
   subckt_filename_(subckt_filename),
-  lib_subckt_filename_(lib_subckt_filename),
+  lib_subckts_(lib_subckts),
   model_filename_(model_filename),
   power_name_(power_name),
   gnd_name_(gnd_name),
@@ -309,7 +449,6 @@ WritePathSpice::WritePathSpice(Path *path,
 WritePathSpice::~WritePathSpice()
 {
   stringDelete(net_name_);
-  cell_spice_port_names_.deleteContents();
 }
 
 void
@@ -422,19 +561,33 @@ WritePathSpice::pgPortVoltage(LibertyPgPort *pg_port)
       else if (stringEqual(voltage_name, gnd_name_))
 	voltage = gnd_voltage_;
       else
-	report_->error(24, "pg_pin %s/%s voltage %s not found,",
-		       pg_port->cell()->name(),
-		       pg_port->name(),
-		       voltage_name);
+	error(24, "pg_pin %s/%s voltage %s not found,",
+	      pg_port->cell()->name(),
+	      pg_port->name(),
+	      voltage_name);
     }
   }
   else
-    report_->error(25, "Liberty pg_port %s/%s missing voltage_name attribute,",
-		   pg_port->cell()->name(),
-		   pg_port->name());
+    error(25, "Liberty pg_port %s/%s missing voltage_name attribute,",
+	  pg_port->cell()->name(),
+	  pg_port->name());
   return voltage;
 }
 
+void
+WritePathSpice::error(int id,
+		      const char *fmt,
+		      ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  char *msg = stringPrintArgs(fmt, args);
+  va_end(args);
+  PathSpiceError path_error(id, msg);
+  stringDelete(msg);
+  throw path_error;
+}
+
 void
 WritePathSpice::writeInputSource()
 {
@@ -817,7 +970,7 @@ WritePathSpice::writeSubcktInst(const Pin *input_pin)
   const char *inst_name = network_->pathName(inst);
   LibertyCell *cell = network_->libertyCell(inst);
   const char *cell_name = cell->name();
-  StringVector *spice_port_names = cell_spice_port_names_[cell_name];
+  const StringVector *spice_port_names = spicePortNames(cell_name);
   streamPrint(spice_stream_, "x%s", inst_name);
   for (string subckt_port_name : *spice_port_names) {
     const char *subckt_port_cname = subckt_port_name.c_str();
@@ -850,7 +1003,7 @@ WritePathSpice::writeSubcktInstVoltSrcs(Stage stage,
   const Instance *inst = network_->instance(input_pin);
   LibertyCell *cell = network_->libertyCell(inst);
   const char *cell_name = cell->name();
-  StringVector *spice_port_names = cell_spice_port_names_[cell_name];
+  const StringVector *spice_port_names = spicePortNames(cell_name);
 
   const Pin *drvr_pin = stageDrvrPin(stage);
   const LibertyPort *input_port = network_->libertyPort(input_pin);
@@ -959,9 +1112,9 @@ WritePathSpice::writeVoltageSource(LibertyCell *cell,
     if (pg_port)
       voltage = pgPortVoltage(pg_port);
     else
-      report_->error(26, "%s pg_port %s not found,",
-		     cell->name(),
-		     pg_port_name);
+      error(26, "%s pg_port %s not found,",
+	    cell->name(),
+	    pg_port_name);
 
   }
   writeVoltageSource(inst_name, subckt_port_name, voltage, volt_index);
@@ -1013,9 +1166,9 @@ WritePathSpice::regPortValues(Stage stage,
 	dcalc_ap_index = drvr_path->dcalcAnalysisPt(this)->index();
       }
       else
-	report_->error(27, "no register/latch found for path from %s to %s,",
-		       stageGateInputPort(stage)->name(),
-		       stageDrvrPort(stage)->name());
+	error(27, "no register/latch found for path from %s to %s,",
+	      stageGateInputPort(stage)->name(),
+	      stageDrvrPort(stage)->name());
     }
   }
 }
@@ -1338,61 +1491,134 @@ WritePathSpice::nodeName(ParasiticNode *node)
 
 ////////////////////////////////////////////////////////////////
 
-// Copy the subckt definition from lib_subckt_filename for
-// each cell in path to path_subckt_filename.
-void
-WritePathSpice::writeSubckts()
+LibSubckts::LibSubckts(const char *lib_subckt_filename,
+		       const char *power_name,
+		       const char *gnd_name,
+		       const StaState *sta) :
+  StaState(sta),
+  lib_subckt_filename_(lib_subckt_filename),
+  power_name_(power_name),
+  gnd_name_(gnd_name)
 {
-  StringSet path_cell_names;
-  findPathCellnames(path_cell_names);
+}
+
+LibSubckts::~LibSubckts()
+{
+  subckts_.deleteContents();
+}
 
+void
+LibSubckts::read()
+{
   ifstream lib_subckts_stream(lib_subckt_filename_);
   if (lib_subckts_stream.is_open()) {
-    ofstream subckts_stream(subckt_filename_);
-    if (subckts_stream.is_open()) {
-      string line;
-      while (getline(lib_subckts_stream, line)) {
-	// .subckt <cell_name> [args..]
-	StringVector tokens;
-	split(line, " \t", tokens);
-	if (tokens.size() >= 2
-	    && stringEqual(tokens[0].c_str(), ".subckt")) {
-	  const char *cell_name = tokens[1].c_str();
-	  if (path_cell_names.hasKey(cell_name)) {
-	    subckts_stream << line << "\n";
-	    bool found_ends = false;
-	    while (getline(lib_subckts_stream, line)) {
-	      subckts_stream << line << "\n";
-	      if (stringBeginEqual(line.c_str(), ".ends")) {
-		subckts_stream << "\n";
-		found_ends = true;
-		break;
-	      }
-	    }
-	    if (!found_ends)
-	      throw SubcktEndsMissing(cell_name, lib_subckt_filename_);
-	    path_cell_names.erase(cell_name);
+    string line;
+    while (getline(lib_subckts_stream, line)) {
+      // .subckt <cell_name> [args..]
+      StringVector tokens;
+      split(line, " \t", tokens);
+      if (tokens.size() >= 2
+	  && stringEqual(tokens[0].c_str(), ".subckt")) {
+	const string &cell_name = tokens[1];
+	LibSubckt *subckt = new LibSubckt;
+	subckt->text_ = line + "\n";
+	subckt->port_names_.assign(tokens.begin() + 2, tokens.end());
+	subckt->has_ends_ = false;
+	subckt->index_ = subckts_.size();
+	while (getline(lib_subckts_stream, line)) {
+	  subckt->text_ += line + "\n";
+	  if (stringBeginEqual(line.c_str(), ".ends")) {
+	    subckt->text_ += "\n";
+	    subckt->has_ends_ = true;
+	    break;
 	  }
-	  recordSpicePortNames(cell_name, tokens);
 	}
+	checkSpicePortNames(cell_name.c_str(), subckt->port_names_);
+	// Use the first definition of a cell.
+	if (subckts_.hasKey(cell_name))
+	  delete subckt;
+	else
+	  subckts_[cell_name] = subckt;
       }
-      subckts_stream.close();
-      lib_subckts_stream.close();
-
-      if (!path_cell_names.empty()) {
-	report_->error(28, "The following subkcts are missing from %s",
-		       lib_subckt_filename_);
-	for (const char *cell_name : path_cell_names)
-	  report_->reportLine(" %s", cell_name);
+    }
+    lib_subckts_stream.close();
+  }
+  else
+    throw FileNotReadable(lib_subckt_filename_);
+}
+
+void
+LibSubckts::checkSpicePortNames(const char *cell_name,
+				StringVector &port_names)
+{
+  LibertyCell *cell = network_->findLibertyCell(cell_name);
+  if (cell) {
+    for (string &port_sname : port_names) {
+      const char *port_name = port_sname.c_str();
+      LibertyPort *port = cell->findLibertyPort(port_name);
+      LibertyPgPort *pg_port = cell->findPgPort(port_name);
+      if (port == nullptr
+	  && pg_port == nullptr
+	  && !stringEqual(port_name, power_name_)
+	  && !stringEqual(port_name, gnd_name_))
+	report_->error(29, "subckt %s port %s has no corresponding liberty port, pg_port and is not power or ground.",
+		       cell_name, port_name);
+    }
+  }
+}
+
+const LibSubckt *
+LibSubckts::findSubckt(const char *cell_name) const
+{
+  return subckts_.findKey(cell_name);
+}
+
+////////////////////////////////////////////////////////////////
+
+// Copy the subckt definition from the library subckts for
+// each cell in path to path_subckt_filename.
+void
+WritePathSpice::writeSubckts()
+{
+  StringSet path_cell_names;
+  findPathCellnames(path_cell_names);
+
+  ofstream subckts_stream(subckt_filename_);
+  if (subckts_stream.is_open()) {
+    Vector<const LibSubckt*> subckts;
+    StringSet missing_cell_names;
+    for (const char *cell_name : path_cell_names) {
+      const LibSubckt *subckt = lib_subckts_->findSubckt(cell_name);
+      if (subckt) {
+	if (!subckt->has_ends_)
+	  throw SubcktEndsMissing(cell_name, lib_subckts_->filename());
+	subckts.push_back(subckt);
       }
+      else
+	missing_cell_names.insert(cell_name);
     }
-    else {
-      lib_subckts_stream.close();
-      throw FileNotWritable(subckt_filename_);
+    // Write subckts in library file order.
+    sort(subckts, [] (const LibSubckt *subckt1,
+		      const LibSubckt *subckt2) {
+		    return subckt1->index_ < subckt2->index_;
+		  });
+    for (const LibSubckt *subckt : subckts)
+      subckts_stream << subckt->text_;
+    subckts_stream.close();
+
+    if (!missing_cell_names.empty()) {
+      string cell_names;
+      for (const char *cell_name : missing_cell_names) {
+	cell_names += "\n ";
+	cell_names += cell_name;
+      }
+      error(28, "The following subkcts are missing from %s%s",
+	    lib_subckts_->filename(),
+	    cell_names.c_str());
     }
   }
   else
-    throw FileNotReadable(lib_subckt_filename_);
+    throw FileNotWritable(subckt_filename_);
 }
 
 void
@@ -1423,27 +1649,11 @@ WritePathSpice::findPathCellnames(// Return values.
   }
 }
 
-void
-WritePathSpice::recordSpicePortNames(const char *cell_name,
-				     StringVector &tokens)
+const StringVector *
+WritePathSpice::spicePortNames(const char *cell_name)
 {
-  LibertyCell *cell = network_->findLibertyCell(cell_name);
-  if (cell) {
-    StringVector *spice_port_names = new StringVector;
-    for (size_t i = 2; i < tokens.size(); i++) {
-      const char *port_name = tokens[i].c_str();
-      LibertyPort *port = cell->findLibertyPort(port_name);
-      LibertyPgPort *pg_port = cell->findPgPort(port_name);
-      if (port == nullptr
-	  && pg_port == nullptr
-	  && !stringEqual(port_name, power_name_)
-	  && !stringEqual(port_name, gnd_name_))
-	report_->error(29, "subckt %s port %s has no corresponding liberty port, pg_port and is not power or ground.",
-		       cell_name, port_name);
-      spice_port_names->push_back(port_name);
-    }
-    cell_spice_port_names_[cell_name] = spice_port_names;
-  }
+  const LibSubckt *subckt = lib_subckts_->findSubckt(cell_name);
+  return subckt ? &subckt->port_names_ : nullptr;
 }
 
 ////////////////////////////////////////////////////////////////
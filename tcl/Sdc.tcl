@@ -3167,6 +3167,44 @@ proc define_corners { args } {
 
 ################################################################
 
+define_cmd_args "define_mode" { mode_name }
+
+proc define_mode { args } {
+  check_argc_eq1 "define_mode" $args
+  set mode_name [lindex $args 0]
+  if { [mode_exists $mode_name] } {
+    sta_error 621 "mode $mode_name already exists."
+  }
+  define_mode_cmd $mode_name
+}
+
+define_cmd_args "current_mode" { [mode_name] }
+
+# With no argument return the current mode name.
+# Constraint commands apply to the current mode.
+proc current_mode { args } {
+  check_argc_eq0or1 "current_mode" $args
+  if { $args == {} } {
+    return [current_mode_cmd]
+  } else {
+    set mode_name [lindex $args 0]
+    if { ![mode_exists $mode_name] } {
+      sta_error 622 "mode $mode_name not found."
+    }
+    set_mode_cmd $mode_name
+    return $mode_name
+  }
+}
+
+define_cmd_args "all_modes" {}
+
+proc all_modes { args } {
+  check_argc_eq0 "all_modes" $args
+  return [mode_names]
+}
+
+################################################################
+
 define_cmd_args "set_pvt"\
   {insts [-min] [-max] [-process process] [-voltage voltage]\
      [-temperature temperature]}
@@ -75,11 +75,29 @@ proc check_setup_cmd { cmd cmd_args } {
 
 ################################################################
 
-define_cmd_args "find_timing" {[-full_update]}
+define_cmd_args "find_timing" {[-full_update] [-all_modes]}
 
 proc find_timing { args } {
-  parse_key_args "find_timing" args keys {} flags {-full_update}
-  find_timing_cmd [info exists flags(-full_update)]
+  parse_key_args "find_timing" args keys {} flags {-full_update -all_modes}
+  set full [info exists flags(-full_update)]
+  if { [info exists flags(-all_modes)] } {
+    find_timing_modes_cmd $full
+  } else {
+    find_timing_cmd $full
+  }
+}
+
+################################################################
+
+define_cmd_args "timing_server" {-socket socket_path}
+
+proc timing_server { args } {
+  parse_key_args "timing_server" args keys {-socket} flags {}
+  check_argc_eq0 "timing_server" $args
+  if { ![info exists keys(-socket)] } {
+    sta_error 620 "timing_server missing -socket."
+  }
+  timing_server_cmd [file nativename $keys(-socket)]
 }
 
 ################################################################
@@ -104,7 +122,10 @@ proc find_timing_paths { args } {
   return $path_ends
 }
 
-proc find_timing_paths_cmd { cmd args_var } {
+# With search_by_corner the path ends of each corner are found and
+# reported one corner at a time and the result is true if there are
+# path ends.
+proc find_timing_paths_cmd { cmd args_var {search_by_corner 0} } {
   global sta_report_unconstrained_paths
   upvar 1 $args_var args
 
@@ -208,6 +229,14 @@ proc find_timing_paths_cmd { cmd args_var } {
     }
   }
 
+  if { $search_by_corner } {
+    return [report_corner_path_ends $from $thrus $to $unconstrained \
+	      $corner $min_max \
+	      $group_count $endpoint_count $unique_pins \
+	      $slack_min $slack_max \
+	      $sort_by_slack $groups \
+	      1 1 1 1 1 1]
+  }
   set path_ends [find_path_ends $from $thrus $to $unconstrained \
 		   $corner $min_max \
 		   $group_count $endpoint_count $unique_pins \
@@ -365,6 +394,68 @@ proc_redirect report_clock_skew {
 
 ################################################################
 
+define_cmd_args "report_timing_partitions" {[-count count]}
+
+proc_redirect report_timing_partitions {
+  parse_key_args "report_timing_partitions" args keys {-count} flags {}
+  check_argc_eq0 "report_timing_partitions" $args
+
+  if [info exists keys(-count)] {
+    set count $keys(-count)
+    check_cardinal "-count" $count
+  } else {
+    set count 10
+  }
+  report_timing_partitions_cmd $count
+}
+
+################################################################
+
+define_cmd_args "report_partition_slacks" {[-workers worker_count]\
+					     [-digits digits]}
+
+proc_redirect report_partition_slacks {
+  global sta_report_default_digits
+
+  parse_key_args "report_partition_slacks" args keys {-workers -digits} flags {}
+  check_argc_eq0 "report_partition_slacks" $args
+
+  if [info exists keys(-workers)] {
+    set worker_count $keys(-workers)
+    check_positive_integer "-workers" $worker_count
+  } else {
+    set worker_count [thread_count]
+  }
+  if [info exists keys(-digits)] {
+    set digits $keys(-digits)
+    check_positive_integer "-digits" $digits
+  } else {
+    set digits $sta_report_default_digits
+  }
+  report_partition_slacks_cmd $worker_count $digits
+}
+
+################################################################
+
+define_cmd_args "report_corner_slacks" {[-digits digits]}
+
+proc_redirect report_corner_slacks {
+  global sta_report_default_digits
+
+  parse_key_args "report_corner_slacks" args keys {-digits} flags {}
+  check_argc_eq0 "report_corner_slacks" $args
+
+  if [info exists keys(-digits)] {
+    set digits $keys(-digits)
+    check_positive_integer "-digits" $digits
+  } else {
+    set digits $sta_report_default_digits
+  }
+  report_corner_slacks_cmd $digits
+}
+
+################################################################
+
 define_cmd_args "report_checks" \
   {[-from from_list|-rise_from from_list|-fall_from from_list]\
      [-through through_list|-rise_through through_list|-fall_through through_list]\
@@ -379,6 +470,7 @@ define_cmd_args "report_checks" \
      [-slack_min slack_min]\
      [-sort_by_slack]\
      [-path_group group_name]\
+     [-search_by_corner]\
      [-format full|full_clock|full_clock_expanded|short|end|summary]\
      [-fields [capacitance|slew|input_pin|net]]\
      [-digits digits]\
@@ -389,11 +481,18 @@ proc_redirect report_checks {
   global sta_report_unconstrained_paths
 
   parse_report_path_options "report_checks" args "full" 0
-  set path_ends [find_timing_paths_cmd "report_checks" args]
-  if { $path_ends == {} } {
-    report_line "No paths found."
+  parse_key_args "report_checks" args keys {} flags {-search_by_corner} 0
+  if { [info exists flags(-search_by_corner)] } {
+    if { ![find_timing_paths_cmd "report_checks" args 1] } {
+      report_line "No paths found."
+    }
   } else {
-    report_path_ends $path_ends
+    set path_ends [find_timing_paths_cmd "report_checks" args]
+    if { $path_ends == {} } {
+      report_line "No paths found."
+    } else {
+      report_path_ends $path_ends
+    }
   }
 }
 
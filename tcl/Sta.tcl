@@ -880,6 +880,49 @@ proc set_assigned_transition { args } {
   }
 }
 
+################################################################
+
+define_cmd_args "read_bulk_annotations" {filename}
+
+# Read arc delays and slews written by an external delay calculator.
+proc read_bulk_annotations { args } {
+  check_argc_eq1 "read_bulk_annotations" $args
+  read_bulk_annotations_cmd [file nativename [lindex $args 0]]
+}
+
+################################################################
+
+define_cmd_args "write_timing_model" {[-library_name lib_name]\
+					[-cell_name cell_name]\
+					[-corner corner_name]\
+					[-min_filename min_filename]\
+					filename}
+
+proc write_timing_model { args } {
+  parse_key_args "write_timing_model" args \
+    keys {-library_name -cell_name -corner -min_filename} flags {}
+  check_argc_eq1 "write_timing_model" $args
+
+  set filename [file nativename [lindex $args 0]]
+  if [info exists keys(-min_filename)] {
+    set min_filename [file nativename $keys(-min_filename)]
+  } else {
+    set min_filename ""
+  }
+  if [info exists keys(-cell_name)] {
+    set cell_name $keys(-cell_name)
+  } else {
+    set cell_name [get_name [[top_instance] cell]]
+  }
+  if [info exists keys(-library_name)] {
+    set lib_name $keys(-library_name)
+  } else {
+    set lib_name $cell_name
+  }
+  set corner [parse_corner keys]
+  write_timing_model_cmd $filename $min_filename $lib_name $cell_name $corner
+}
+
 ################################################################a
 
 # compatibility
@@ -1473,6 +1516,34 @@ define_cmd_args "set_pocv_sigma_factor" { factor }
 
 ################################################################
 
+define_cmd_args "set_arrival_tolerance" { tolerance }
+
+# Incremental arrival updates stop propagating at vertices with
+# arrivals that change by no more than tolerance.
+proc set_arrival_tolerance { args } {
+  check_argc_eq1 "set_arrival_tolerance" $args
+  set tolerance [lindex $args 0]
+  check_positive_float "tolerance" $tolerance
+  set_arrival_tolerance_cmd [time_ui_sta $tolerance]
+}
+
+define_cmd_args "report_arrival_update_stats" {[-reset]}
+
+# Vertex counts summed over the arrival updates since the last
+# find_timing or -reset.
+proc report_arrival_update_stats { args } {
+  parse_key_args "report_arrival_update_stats" args keys {} flags {-reset}
+  check_argc_eq0 "report_arrival_update_stats" $args
+  report_line "Seeded  [arrival_seed_count]"
+  report_line "Visited [arrival_visit_count]"
+  report_line "Changed [arrival_change_count]"
+  if { [info exists flags(-reset)] } {
+    reset_arrival_update_stats
+  }
+}
+
+################################################################
+
 define_cmd_args "write_path_spice" { -path_args path_args\
 				       -spice_directory spice_directory\
 				       -lib_subckt_file lib_subckts_file\
@@ -1539,16 +1610,8 @@ proc write_path_spice { args } {
   if { $path_ends == {} } {
     sta_error 507 "No paths found for -path_args $path_args."
   } else {
-    set path_index 1
-    foreach path_end $path_ends {
-      set path [$path_end path]
-      set path_name "path_$path_index"
-      set spice_file [file join $spice_dir "$path_name.sp"]
-      set subckt_file [file join $spice_dir "$path_name.subckt"]
-      write_path_spice_cmd $path $spice_file $subckt_file \
-	$lib_subckt_file $model_file $power $ground
-      incr path_index
-    }
+    write_path_spice_cmd $path_ends $spice_dir \
+      $lib_subckt_file $model_file $power $ground
   }
 }
 
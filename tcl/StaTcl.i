@@ -36,6 +36,7 @@
 #include <limits>
 
 #include "Machine.hh"
+#include "BlockArena.hh"
 #include "StaConfig.hh"  // STA_VERSION
 #include "Stats.hh"
 #include "Report.hh"
@@ -62,6 +63,7 @@
 #include "Parasitics.hh"
 #include "DelayCalc.hh"
 #include "DcalcAnalysisPt.hh"
+#include "GraphDelayCalc.hh"
 #include "Corner.hh"
 #include "PathVertex.hh"
 #include "PathRef.hh"
@@ -79,6 +81,7 @@
 #include "search/Levelize.hh"
 #include "search/ReportPath.hh"
 #include "search/Power.hh"
+#include "search/TimingServer.hh"
 
 namespace sta {
 
@@ -1259,6 +1262,10 @@ using namespace sta;
   Tcl_SetObjResult(interp, obj);
 }
 
+%typemap(in) PathEndSeq* {
+  $1 = tclListSeq<PathEnd*>($input, SWIGTYPE_p_PathEnd, interp);
+}
+
 %typemap(out) PathEndSeq* {
   Tcl_Obj *list = Tcl_NewListObj(0, nullptr);
   const PathEndSeq *path_ends = $1;
@@ -1992,6 +1999,12 @@ redirect_file_end()
   Sta::sta()->report()->redirectFileEnd();
 }
 
+void
+flush_report_files()
+{
+  Sta::sta()->report()->flushFiles();
+}
+
 void
 redirect_string_begin()
 {
@@ -2762,6 +2775,36 @@ corners()
   return Sta::sta()->corners();
 }
 
+void
+define_mode_cmd(const char *mode_name)
+{
+  Sta::sta()->makeMode(mode_name);
+}
+
+bool
+mode_exists(const char *mode_name)
+{
+  return Sta::sta()->modeExists(mode_name);
+}
+
+const char *
+current_mode_cmd()
+{
+  return Sta::sta()->currentMode();
+}
+
+void
+set_mode_cmd(const char *mode_name)
+{
+  Sta::sta()->setMode(mode_name);
+}
+
+TmpStringSeq *
+mode_names()
+{
+  return Sta::sta()->modeNames();
+}
+
 bool
 multi_corner()
 {
@@ -4084,6 +4127,27 @@ set_annotated_slew(Vertex *vertex,
   Sta::sta()->setAnnotatedSlew(vertex, corner, min_max, rf, slew);
 }
 
+void
+read_bulk_annotations_cmd(const char *filename)
+{
+  cmdGraph();
+  Sta::sta()->readBulkAnnotations(filename);
+}
+
+void
+write_timing_model_cmd(const char *filename,
+		       const char *min_filename,
+		       const char *lib_name,
+		       const char *cell_name,
+		       const Corner *corner)
+{
+  cmdLinkedNetwork();
+  if (min_filename[0] == '\0')
+    min_filename = nullptr;
+  Sta::sta()->writeTimingModel(filename, min_filename, lib_name, cell_name,
+			       corner);
+}
+
 // Remove all delay and slew annotations.
 void
 remove_delay_slew_annotations()
@@ -4280,6 +4344,18 @@ set_use_default_arrival_clock(bool enable)
   return Sta::sta()->setUseDefaultArrivalClock(enable);
 }
 
+bool
+parallel_corner_delay_calc()
+{
+  return Sta::sta()->parallelCornerDelayCalc();
+}
+
+void
+set_parallel_corner_delay_calc(bool parallel)
+{
+  Sta::sta()->setParallelCornerDelayCalc(parallel);
+}
+
 bool
 propagate_all_clocks()
 {
@@ -4330,6 +4406,43 @@ find_path_ends(ExceptionFrom *from,
   return ends;
 }
 
+bool
+report_corner_path_ends(ExceptionFrom *from,
+			ExceptionThruSeq *thrus,
+			ExceptionTo *to,
+			bool unconstrained,
+			Corner *corner,
+			const MinMaxAll *delay_min_max,
+			int group_count,
+			int endpoint_count,
+			bool unique_pins,
+			float slack_min,
+			float slack_max,
+			bool sort_by_slack,
+			PathGroupNameSet *groups,
+			bool setup,
+			bool hold,
+			bool recovery,
+			bool removal,
+			bool clk_gating_setup,
+			bool clk_gating_hold)
+{
+  cmdLinkedNetwork();
+  Sta *sta = Sta::sta();
+  bool found = sta->reportCornerPathEnds(from, thrus, to, unconstrained,
+					 corner, delay_min_max,
+					 group_count, endpoint_count,
+					 unique_pins,
+					 slack_min, slack_max,
+					 sort_by_slack,
+					 groups->size() ? groups : nullptr,
+					 setup, hold,
+					 recovery, removal,
+					 clk_gating_setup, clk_gating_hold);
+  delete groups;
+  return found;
+}
+
 void
 report_path_end_header()
 {
@@ -4460,6 +4573,28 @@ worst_clk_skew_cmd(const SetupHold *setup_hold)
   return Sta::sta()->findWorstClkSkew(setup_hold);
 }
 
+void
+report_timing_partitions_cmd(int count)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->reportTimingPartitions(count);
+}
+
+void
+report_partition_slacks_cmd(int worker_count,
+			    int digits)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->reportPartitionSlacks(worker_count, digits);
+}
+
+void
+report_corner_slacks_cmd(int digits)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->reportCornerSlacks(digits);
+}
+
 TmpPinSet *
 startpoints()
 {
@@ -4600,6 +4735,13 @@ find_timing_cmd(bool full)
   Sta::sta()->updateTiming(full);
 }
 
+void
+find_timing_modes_cmd(bool full)
+{
+  cmdLinkedNetwork();
+  Sta::sta()->updateTimingModes(full);
+}
+
 void
 find_requireds()
 {
@@ -4607,6 +4749,33 @@ find_requireds()
   Sta::sta()->findRequireds();
 }
 
+void
+freeze_timing()
+{
+  cmdLinkedNetwork();
+  Sta::sta()->freezeTiming();
+}
+
+void
+thaw_timing()
+{
+  Sta::sta()->thawTiming();
+}
+
+bool
+timing_frozen()
+{
+  return Sta::sta()->timingFrozen();
+}
+
+bool
+timing_server_cmd(const char *socket_path)
+{
+  cmdLinkedNetwork();
+  TimingServer server(Sta::sta());
+  return server.serve(socket_path);
+}
+
 void
 find_delays()
 {
@@ -4665,6 +4834,59 @@ worst_slack_corner(const Corner *corner,
   return worst_slack;
 }
 
+// Worst delay of edge to rf if inst were replaced by swap_cell.
+// Returns the current delay if the swap does not change it.
+float
+swap_cell_edge_delay(Instance *inst,
+		     LibertyCell *swap_cell,
+		     Edge *edge,
+		     const RiseFall *rf,
+		     const MinMax *min_max)
+{
+  cmdLinkedNetwork();
+  Sta *sta = Sta::sta();
+  sta->findDelays();
+  SwapCellDelaySeq delays;
+  sta->swapCellDelays(inst, swap_cell, nullptr, delays);
+  const DcalcAnalysisPtSeq &dcalc_aps = sta->corners()->dcalcAnalysisPts();
+  float delay = min_max->initValue();
+  bool exists = false;
+  for (const SwapCellDelay &swap_delay : delays) {
+    if (swap_delay.edge_ == edge
+	&& swap_delay.arc_->toTrans()->asRiseFall() == rf
+	&& dcalc_aps[swap_delay.ap_index_]->constraintMinMax() == min_max) {
+      float delay1 = delayAsFloat(swap_delay.delay_);
+      if (min_max->compare(delay1, delay))
+	delay = delay1;
+      exists = true;
+    }
+  }
+  if (!exists) {
+    for (TimingArc *arc : edge->timingArcSet()->arcs()) {
+      if (arc->toTrans()->asRiseFall() == rf) {
+	for (Corner *corner : *sta->corners()) {
+	  DcalcAnalysisPt *dcalc_ap = corner->findDcalcAnalysisPt(min_max);
+	  float delay1 = delayAsFloat(sta->arcDelay(edge, arc, dcalc_ap));
+	  if (min_max->compare(delay1, delay))
+	    delay = delay1;
+	}
+      }
+    }
+  }
+  return delay;
+}
+
+Slack
+swap_cell_slack(Instance *inst,
+		LibertyCell *swap_cell,
+		const MinMax *min_max)
+{
+  cmdLinkedNetwork();
+  Sta *sta = Sta::sta();
+  sta->findRequireds();
+  return sta->swapCellSlack(inst, swap_cell, nullptr, min_max);
+}
+
 PathRef *
 vertex_worst_arrival_path(Vertex *vertex,
 			  const MinMax *min_max)
@@ -4917,18 +5139,23 @@ write_sdc_cmd(const char *filename,
 }
 
 void
-write_path_spice_cmd(PathRef *path,
-		     const char *spice_filename,
-		     const char *subckt_filename,
+write_path_spice_cmd(PathEndSeq *path_ends,
+		     const char *spice_directory,
 		     const char *lib_subckt_filename,
 		     const char *model_filename,
 		     const char *power_name,
 		     const char *gnd_name)
 {
   Sta *sta = Sta::sta();
-  writePathSpice(path, spice_filename, subckt_filename,
-		 lib_subckt_filename, model_filename,
-		 power_name, gnd_name, sta);
+  try {
+    writePathSpice(path_ends, spice_directory, lib_subckt_filename,
+		   model_filename, power_name, gnd_name, sta);
+  }
+  catch (...) {
+    delete path_ends;
+    throw;
+  }
+  delete path_ends;
 }
 
 bool
@@ -5271,6 +5498,25 @@ report_arrival_count_histogram()
   Sta::sta()->search()->reportArrivalCountHistogram();
 }
 
+void
+report_path_memory()
+{
+  Sta::sta()->search()->reportPathMemory();
+}
+
+void
+compact_paths()
+{
+  Sta::sta()->search()->compactPaths();
+}
+
+// Largest table block memory chunk in bytes (0 = allocate blocks separately).
+void
+set_table_chunk_size_max(int size)
+{
+  BlockArena::setChunkSizeMax(size);
+}
+
 int
 tag_count()
 {
@@ -5301,6 +5547,36 @@ arrival_count()
   return Sta::sta()->arrivalCount();
 }
 
+void
+set_arrival_tolerance_cmd(float tolerance)
+{
+  Sta::sta()->search()->setArrivalTolerance(tolerance);
+}
+
+int
+arrival_seed_count()
+{
+  return Sta::sta()->search()->arrivalSeedCount();
+}
+
+int
+arrival_visit_count()
+{
+  return Sta::sta()->search()->arrivalVisitCount();
+}
+
+int
+arrival_change_count()
+{
+  return Sta::sta()->search()->arrivalChangeCount();
+}
+
+void
+reset_arrival_update_stats()
+{
+  Sta::sta()->search()->resetArrivalUpdateStats();
+}
+
 void
 delete_all_memory()
 {
@@ -120,6 +120,7 @@ proc proc_redirect { proc_name body } {
 		   "set redirect \[parse_redirect_args args\];" \
 		   "set code \[catch {" $body "} ret \];" \
 		   "if {\$redirect} { redirect_file_end };" \
+		   "flush_report_files;" \
 		   "if {\$code == 1} {return -code \$code -errorcode \$errorCode -errorinfo \$errorInfo \$ret} else {return \$ret} }" ]
   eval $proc_body
 }
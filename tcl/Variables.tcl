@@ -144,6 +144,14 @@ proc trace_input_port_default_clock { name1 name2 op } {
     use_default_arrival_clock set_use_default_arrival_clock
 }
 
+trace variable ::sta_parallel_corner_delay_calc "rw" \
+  sta::trace_parallel_corner_delay_calc
+
+proc trace_parallel_corner_delay_calc { name1 name2 op } {
+  trace_boolean_var $op ::sta_parallel_corner_delay_calc \
+    parallel_corner_delay_calc set_parallel_corner_delay_calc
+}
+
 trace variable ::sta_propagate_all_clocks "rw" \
   sta::trace_propagate_all_clocks
 
@@ -0,0 +1,42 @@
+# all_registers -clock after clock and netlist edits.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name c1 -period 10 clk1
+create_clock -name c2 -period 10 clk2
+create_clock -name c3 -period 10 clk3
+
+proc report_clk_registers { label } {
+  set line "$label:"
+  foreach clk_name {c1 c2 c3 c4} {
+    set clk [get_clocks -quiet $clk_name]
+    if { $clk != {} } {
+      set names {}
+      foreach reg [all_registers -clock $clk] {
+	lappend names [get_full_name $reg]
+      }
+      append line " $clk_name {[lsort $names]}"
+    }
+  }
+  puts $line
+}
+
+report_clk_registers "initial"
+
+delete_clock [get_clocks c3]
+create_clock -name c4 -period 5 clk3
+report_clk_registers "clock replaced"
+
+disconnect_pin clk3 r3/CK
+connect_pin clk1 r3/CK
+report_clk_registers "pin moved"
+
+make_instance r4 DFF_X1
+connect_pin clk2 r4/CK
+report_clk_registers "register added"
+
+replace_cell r2 DFF_X2
+report_clk_registers "cell replaced"
+
+delete_instance r1
+report_clk_registers "register deleted"
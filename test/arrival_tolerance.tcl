@@ -0,0 +1,45 @@
+# Arrival changes within the arrival tolerance are not propagated, so
+# incremental arrivals differ from a full update by at most the
+# tolerance. Larger changes propagate exactly.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+proc r1_slack {} {
+  return [get_property [get_pins r1/D] max_rise_slack]
+}
+
+set tolerance 0.01
+find_timing -full_update
+set_arrival_tolerance $tolerance
+
+# Change the in1 arrival by less than the tolerance.
+set_input_delay -clock clk 0.005 in1
+find_timing
+set pruned_visits [sta::arrival_visit_count]
+set pruned_slack [r1_slack]
+find_timing -full_update
+set full_visits [sta::arrival_visit_count]
+set exact_slack [r1_slack]
+set diff [expr abs($pruned_slack - $exact_slack)]
+puts "small change pruned: [expr {$pruned_visits < $full_visits}]"
+puts "small change differs: [expr {$diff > 0.0}]"
+puts "small change within tolerance: [expr {$diff <= $tolerance + 1e-6}]"
+
+# Change the in1 arrival by more than the tolerance.
+set_input_delay -clock clk 0.5 in1
+find_timing
+set changed [sta::arrival_change_count]
+set incr_slack [r1_slack]
+find_timing -full_update
+set exact_slack [r1_slack]
+puts "large change propagated: [expr {$changed > 0}]"
+puts "large change exact: [expr {abs($incr_slack - $exact_slack) < 1e-6}]"
+
+# Counts are summed until the next find_timing or -reset.
+with_output_to_variable stats { report_arrival_update_stats -reset }
+with_output_to_variable stats { report_arrival_update_stats }
+puts "reset: [regexp {Visited 0} $stats]"
@@ -0,0 +1,34 @@
+# Bulk annotations that reference deleted and unknown graph ids are ignored.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+report_checks > /dev/null
+# Delete vertices and edges from the middle of the id range.
+delete_instance u1
+
+# Annotate every id up to id_count. Most of them were deleted or never made.
+set id_count 2000
+set anno_file [file join results bulk_annotation_ids.anno]
+file mkdir results
+set stream [open $anno_file w]
+fconfigure $stream -translation binary
+puts -nonewline $stream "STAANNO1"
+puts -nonewline $stream [binary format m $id_count]
+for {set id 0} {$id < $id_count} {incr id} {
+  puts -nonewline $stream [binary format nnnf $id 0 0 1e-10]
+}
+puts -nonewline $stream [binary format m $id_count]
+for {set id 0} {$id < $id_count} {incr id} {
+  puts -nonewline $stream [binary format nnnf $id 0 0 1e-10]
+}
+close $stream
+
+with_output_to_variable warnings { read_bulk_annotations $anno_file }
+regexp {(\d+) annotations.*\n.* (\d+) annotations} $warnings \
+  ignore delay_ignored slew_ignored
+puts "delays ignored: [expr $delay_ignored == $id_count - [sta::graph_edge_count]]"
+puts "slews ignored: [expr $slew_ignored == $id_count - [sta::graph_vertex_count]]"
+report_checks > /dev/null
+puts "timing updated"
@@ -0,0 +1,31 @@
+# Path ends found one corner at a time and delays found with a task for
+# each corner match a search of all corners.
+define_corners fast slow
+read_liberty -corner fast ../examples/example1_fast.lib
+read_liberty -corner slow ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+# Some nets have parasitic networks and some do not.
+read_spef ../examples/example1.dspef
+create_clock -name clk -period 0.1 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+proc compare_reports { name args } {
+  with_output_to_variable all { eval report_checks $args }
+  with_output_to_variable by_corner { eval report_checks -search_by_corner $args }
+  puts "$name match: [expr {$all == $by_corner}]"
+}
+
+compare_reports "full" -group_count 3
+compare_reports "end" -format end -path_delay min_max -group_count 10
+compare_reports "summary" -format summary -sort_by_slack -group_count 3
+compare_reports "through" -through u2/A1 -format end -path_delay min_max
+compare_reports "corner" -corner slow -format end -group_count 10
+
+with_output_to_variable serial { report_checks -format end -path_delay min_max -group_count 10 -digits 4 }
+sta::set_thread_count 4
+set sta_parallel_corner_delay_calc 1
+sta::delays_invalid
+with_output_to_variable parallel { report_checks -format end -path_delay min_max -group_count 10 -digits 4 }
+puts "corner tasks match: [expr {$serial == $parallel}]"
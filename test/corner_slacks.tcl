@@ -0,0 +1,37 @@
+# Slacks found by one worker process per corner match a flat update.
+define_corners fast slow
+read_liberty -corner fast ../examples/example1_fast.lib
+read_liberty -corner slow ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 0.1 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+with_output_to_variable report { report_corner_slacks -digits 4 }
+foreach corner_name {fast slow} {
+  set corner [sta::find_corner $corner_name]
+  regexp "\n$corner_name +(\\S+) +(\\S+) +(\\S+) +(\\S+)" $report \
+    ignore max_slack max_tns min_slack min_tns
+  foreach min_max {max min} {
+    set worst_slack [set ${min_max}_slack]
+    set tns [set ${min_max}_tns]
+    set flat_worst_slack \
+      [sta::format_time [sta::worst_slack_corner $corner $min_max] 4]
+    set flat_tns \
+      [sta::format_time [sta::total_negative_slack_corner_cmd $corner $min_max] 4]
+    puts "$corner_name $min_max worst slack match: [expr {$worst_slack == $flat_worst_slack}]"
+    puts "$corner_name $min_max tns match: [expr {$tns == $flat_tns}]"
+  }
+}
+foreach min_max {max min} {
+  regexp "$min_max worst slack (\\S+)" $report ignore worst_slack
+  regexp "$min_max tns (\\S+)" $report ignore tns
+  set flat_worst_slack [sta::format_time [sta::worst_slack_cmd $min_max] 4]
+  set flat_tns [sta::format_time [sta::total_negative_slack_cmd $min_max] 4]
+  puts "$min_max worst slack match: [expr {$worst_slack == $flat_worst_slack}]"
+  puts "$min_max tns match: [expr {$tns == $flat_tns}]"
+}
+set fast_slack [sta::worst_slack_corner [sta::find_corner fast] max]
+set slow_slack [sta::worst_slack_corner [sta::find_corner slow] max]
+puts "corners differ: [expr {$fast_slack != $slow_slack}]"
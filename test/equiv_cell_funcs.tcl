@@ -0,0 +1,62 @@
+# Cells with functions that are written differently but have the same
+# truth table are equivalent.
+file mkdir results
+set lib_file [file join results equiv_cell_funcs.lib]
+set stream [open $lib_file w]
+puts $stream "library (equiv_funcs) {
+  delay_model : table_lookup;
+  time_unit : \"1ns\";
+  voltage_unit : \"1V\";
+  current_unit : \"1mA\";
+  capacitive_load_unit (1,pf);
+  pulling_resistance_unit : \"1kohm\";
+  leakage_power_unit : \"1nW\";
+  input_threshold_pct_rise : 50;
+  input_threshold_pct_fall : 50;
+  output_threshold_pct_rise : 50;
+  output_threshold_pct_fall : 50;
+  slew_lower_threshold_pct_rise : 20;
+  slew_lower_threshold_pct_fall : 20;
+  slew_upper_threshold_pct_rise : 80;
+  slew_upper_threshold_pct_fall : 80;"
+foreach {cell_name function sense} {
+  NAND2_A "!(A*B)" negative_unate
+  NAND2_B "!A+!B" negative_unate
+  AND2_A "A*B" positive_unate
+} {
+  puts $stream "  cell ($cell_name) {
+    area : 1;
+    pin (A) { direction : input; capacitance : 0.001; }
+    pin (B) { direction : input; capacitance : 0.001; }
+    pin (Z) {
+      direction : output;
+      function : \"$function\";"
+  foreach related_pin {A B} {
+    puts $stream "      timing () {
+        related_pin : \"$related_pin\";
+        timing_sense : $sense;
+        cell_rise (scalar) { values (\"0.1\"); }
+        cell_fall (scalar) { values (\"0.1\"); }
+        rise_transition (scalar) { values (\"0.05\"); }
+        fall_transition (scalar) { values (\"0.05\"); }
+      }"
+  }
+  puts $stream "    }
+  }"
+}
+puts $stream "}"
+close $stream
+
+read_liberty $lib_file
+set nand_a [get_lib_cells equiv_funcs/NAND2_A]
+set nand_b [get_lib_cells equiv_funcs/NAND2_B]
+set and_a [get_lib_cells equiv_funcs/AND2_A]
+puts "!(A*B) equiv !A+!B: [sta::equiv_cells $nand_a $nand_b]"
+puts "!(A*B) equiv A*B: [sta::equiv_cells $nand_a $and_a]"
+
+sta::make_equiv_cells [sta::find_liberty equiv_funcs]
+set equivs {}
+foreach cell [sta::find_equiv_cells $nand_a] {
+  lappend equivs [get_name $cell]
+}
+puts "NAND2_A equivs: [lsort $equivs]"
@@ -0,0 +1,53 @@
+# get_fanin/get_fanout -levels and -pin_levels include the pins within
+# the level limit of the nearest root, including pins also reached by a
+# longer reconvergent path.
+file mkdir results
+set verilog_file [file join results fanin_fanout_levels.v]
+set stream [open $verilog_file w]
+puts $stream {module top (in1, out1);
+  input in1;
+  output out1;
+  wire u1z, u2z, u3z, u4z;
+  BUF_X1 u1 (.A(in1), .Z(u1z));
+  BUF_X1 u2 (.A(u1z), .Z(u2z));
+  AND2_X1 u3 (.A1(u2z), .A2(in1), .ZN(u3z));
+  BUF_X1 u4 (.A(u3z), .Z(u4z));
+  BUF_X1 u5 (.A(u4z), .Z(out1));
+endmodule}
+close $stream
+
+read_liberty ../examples/example1_slow.lib
+read_verilog $verilog_file
+link_design top
+
+proc pin_names { pins } {
+  set names {}
+  foreach pin $pins {
+    lappend names [get_full_name $pin]
+  }
+  return [lsort $names]
+}
+
+proc check_cone { name pins expected } {
+  set names [pin_names $pins]
+  set match [expr {$names == [lsort $expected]}]
+  puts "$name: $match"
+  if { !$match } {
+    puts "  $names"
+  }
+}
+
+check_cone "fanout levels 2" [get_fanout -from [get_ports in1] -levels 2] \
+  {in1 u1/A u1/Z u2/A u2/Z u3/A2 u3/ZN u4/A u4/Z}
+check_cone "fanout pin_levels 3" \
+  [get_fanout -from [get_ports in1] -pin_levels 3] \
+  {in1 u1/A u1/Z u2/A u3/A2 u3/ZN u4/A}
+check_cone "fanout roots levels 1" \
+  [get_fanout -from [list [get_ports in1] [get_pins u2/Z]] -levels 1] \
+  {in1 u1/A u1/Z u2/Z u3/A1 u3/A2 u3/ZN}
+check_cone "fanin levels 2" [get_fanin -to [get_ports out1] -levels 2] \
+  {out1 u5/Z u5/A u4/Z u4/A}
+check_cone "fanin levels 4" [get_fanin -to [get_ports out1] -levels 4] \
+  {out1 u5/Z u5/A u4/Z u4/A u3/ZN u3/A1 u3/A2 u2/Z u2/A in1}
+check_cone "fanin pin_levels 5" [get_fanin -to [get_ports out1] -pin_levels 5] \
+  {out1 u5/Z u5/A u4/Z u4/A u3/ZN}
@@ -0,0 +1,37 @@
+# Frozen timing is thawed by network edits, constraint changes and
+# delay/arrival invalidation.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+proc check_thaw { name } {
+  set frozen [sta::timing_frozen]
+  set slack [sta::worst_slack_cmd max]
+  # Update from scratch to compare.
+  sta::delays_invalid
+  set flat_slack [sta::worst_slack_cmd max]
+  puts "$name frozen: $frozen slack match: [expr {$slack == $flat_slack}]"
+  sta::freeze_timing
+}
+
+sta::freeze_timing
+puts "frozen: [sta::timing_frozen]"
+set slack [sta::worst_slack_cmd max]
+set_output_delay -clock clk 2 out
+check_thaw "set_output_delay"
+puts "slack changed: [expr {[sta::worst_slack_cmd max] != $slack}]"
+set_input_delay -clock clk 3 in1
+check_thaw "set_input_delay"
+replace_cell u1 BUF_X4
+check_thaw "replace_cell"
+set_load 0.1 u2z
+check_thaw "set_load"
+sta::delays_invalid
+check_thaw "delays_invalid"
+sta::arrivals_invalid
+check_thaw "arrivals_invalid"
+sta::thaw_timing
+puts "frozen: [sta::timing_frozen]"
@@ -0,0 +1,65 @@
+# Each mode keeps its arrivals while another mode is current and
+# follows the network edits made in the other modes.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+define_mode scan
+current_mode scan
+create_clock -name scan_clk -period 20 {clk1 clk2 clk3}
+set_input_delay -clock scan_clk 1 {in1 in2}
+set_output_delay -clock scan_clk 2 out
+set_load 0.05 out
+
+proc mode_report { mode } {
+  current_mode $mode
+  find_timing
+  with_output_to_variable report { report_checks -path_delay min_max -digits 4 }
+  return $report
+}
+
+# Report with delays and arrivals found from scratch.
+proc full_report { mode } {
+  current_mode $mode
+  sta::delays_invalid
+  return [mode_report $mode]
+}
+
+proc check_modes { name } {
+  set default_report [mode_report default]
+  set scan_report [mode_report scan]
+  set default_report2 [mode_report default]
+  set scan_report2 [mode_report scan]
+  set default_full [full_report default]
+  set scan_full [full_report scan]
+  puts "$name default match: [expr {$default_report == $default_full && $default_report2 == $default_full}] scan match: [expr {$scan_report == $scan_full && $scan_report2 == $scan_full}]"
+}
+
+check_modes "initial"
+puts "modes differ: [expr {[mode_report default] != [mode_report scan]}]"
+current_mode default
+find_timing -full_update
+set full_visits [sta::arrival_visit_count]
+current_mode scan
+find_timing
+current_mode default
+find_timing
+# Only the arrivals changed by the scan mode port load are updated.
+puts "default restored incrementally: [expr {[sta::arrival_visit_count] < $full_visits}]"
+current_mode scan
+# Equivalent cell swaps update the arrivals of the other modes
+# incrementally.
+replace_cell u1 BUF_X4
+check_modes "replace_cell"
+set_load 0.1 u2z
+check_modes "set_load"
+disconnect_pin u1z u2/A2
+check_modes "disconnect_pin"
+connect_pin u1z u2/A2
+check_modes "connect_pin"
+find_timing -all_modes
+check_modes "find_timing -all_modes"
+puts "current mode: [current_mode]"
@@ -0,0 +1,18 @@
+# Endpoint slacks merged from partition worker processes match a flat update.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 0.1 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+with_output_to_variable report { report_partition_slacks -workers 3 -digits 4 }
+foreach min_max {max min} {
+  regexp "$min_max worst slack (\\S+)" $report ignore worst_slack
+  regexp "$min_max tns (\\S+)" $report ignore tns
+  set flat_worst_slack [sta::format_time [sta::worst_slack_cmd $min_max] 4]
+  set flat_tns [sta::format_time [sta::total_negative_slack_cmd $min_max] 4]
+  puts "$min_max worst slack match: [expr {$worst_slack == $flat_worst_slack}]"
+  puts "$min_max tns match: [expr {$tns == $flat_tns}]"
+}
+puts "tns negative: [expr {[sta::total_negative_slack_cmd max] < 0.0}]"
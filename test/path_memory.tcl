@@ -0,0 +1,32 @@
+# Requireds added and removed incrementally give their arrival arrays
+# back to the arrival table, so the live arrival count stays flat.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+proc arrivals_live {} {
+  with_output_to_variable mem { sta::report_path_memory }
+  regexp {Arrivals +live +([0-9]+)} $mem ignore live
+  return $live
+}
+
+sta::find_requireds
+set live [arrivals_live]
+set flat 1
+for {set i 1} {$i <= 5} {incr i} {
+  # Removing the output delay deletes the requireds at out.
+  unset_output_delay -clock clk out
+  sta::find_requireds
+  set_output_delay -clock clk $i out
+  sta::find_requireds
+  if { [arrivals_live] != $live } {
+    set flat 0
+  }
+}
+puts "live arrivals flat: $flat"
+set slack [sta::worst_slack_cmd max]
+sta::arrivals_invalid
+puts "slack match: [expr {$slack == [sta::worst_slack_cmd max]}]"
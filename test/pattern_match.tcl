@@ -0,0 +1,122 @@
+# Native glob and regexp matching agrees with Tcl, and names matched
+# by multiple threads agree with one thread.
+read_liberty ../examples/example1_slow.lib
+
+set lib_cell_names {}
+foreach cell [get_lib_cells *] {
+  lappend lib_cell_names [get_name $cell]
+}
+
+proc check_lib_cells { pattern regexp nocase } {
+  global lib_cell_names
+  set flags {}
+  if { $regexp } {
+    lappend flags -regexp
+  }
+  if { $nocase } {
+    lappend flags -nocase
+  }
+  set matches {}
+  foreach cell [get_lib_cells -quiet {*}$flags $pattern] {
+    lappend matches [get_name $cell]
+  }
+  set expected {}
+  foreach name $lib_cell_names {
+    if { $regexp } {
+      if { $nocase } {
+	set match [regexp -nocase "^${pattern}\$" $name]
+      } else {
+	set match [regexp "^${pattern}\$" $name]
+      }
+    } else {
+      set match [string match $pattern $name]
+    }
+    if { $match } {
+      lappend expected $name
+    }
+  }
+  set ok [expr {[lsort $matches] == [lsort $expected] && $expected != {}}]
+  puts "[string trim "$flags $pattern"]: $ok"
+}
+
+# Simple regexps matched natively.
+check_lib_cells {BUF_X.} 1 0
+check_lib_cells {buf_x.} 1 1
+check_lib_cells {AND2\_X.} 1 0
+check_lib_cells {.*X1} 1 0
+check_lib_cells {.+_X4} 1 0
+check_lib_cells {dff.*} 1 1
+# Regexps matched by Tcl.
+check_lib_cells {(AND|OR)2_X1} 1 0
+check_lib_cells {DFF[RS]*_X1} 1 0
+check_lib_cells {dff[rs]+_x1} 1 1
+check_lib_cells {[A-C].*_X\d} 1 0
+# Globs with repeated stars.
+check_lib_cells {*X1} 0 0
+check_lib_cells {**X1} 0 0
+check_lib_cells {AND**} 0 0
+check_lib_cells {*_X*1} 0 0
+check_lib_cells {D**F*X?} 0 0
+
+# Flat netlist with enough instances and nets to match with threads.
+file mkdir results
+set verilog_file [file join results pattern_match.v]
+set stream [open $verilog_file w]
+set inst_count 5000
+puts $stream "module top (in, out);"
+puts $stream "  input in;"
+puts $stream "  output out;"
+for {set i 0} {$i < $inst_count} {incr i} {
+  puts $stream "  wire n$i;"
+}
+set from in
+for {set i 0} {$i < $inst_count} {incr i} {
+  puts $stream "  BUF_X1 b$i (.A($from), .Z(n$i));"
+  set from n$i
+}
+puts $stream "  assign out = $from;"
+puts $stream "endmodule"
+close $stream
+
+read_verilog $verilog_file
+link_design top
+
+proc match_names { cmd pattern regexp thread_count } {
+  sta::set_thread_count $thread_count
+  set flags {}
+  if { $regexp } {
+    lappend flags -regexp
+  }
+  set names {}
+  foreach object [$cmd -quiet {*}$flags $pattern] {
+    lappend names [get_full_name $object]
+  }
+  sta::set_thread_count 1
+  return $names
+}
+
+foreach {cmd pattern regexp} {
+  get_cells b1* 0
+  get_cells *7** 0
+  get_cells b.*7 1
+  get_cells b[0-9]+5 1
+  get_nets n4?9 0
+  get_nets n.+3 1
+} {
+  set serial [match_names $cmd $pattern $regexp 1]
+  set parallel [match_names $cmd $pattern $regexp 4]
+  set expected 0
+  foreach name $serial {
+    if { $regexp } {
+      set match [regexp "^${pattern}\$" $name]
+    } else {
+      set match [string match $pattern $name]
+    }
+    if { $match } {
+      incr expected
+    }
+  }
+  set ok [expr {$serial == $parallel && $expected == [llength $serial]
+		&& $serial != {}}]
+  puts "$cmd $pattern threads: $ok"
+}
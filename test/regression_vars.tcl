@@ -67,6 +67,16 @@ proc record_example_tests { tests } {
   }
 }
 
+proc record_sta_tests { tests } {
+  global test_dir
+  foreach test $tests {
+    # Prune commented tests from the list.
+    if { [string index $test 0] != "#" } {
+      record_test $test $test_dir
+    }
+  }
+}
+
 ################################################################
 
 proc define_test_group { name tests } {
@@ -108,4 +118,34 @@ record_example_tests {
   example5
 }
 
+# Record tests in sta/test
+record_sta_tests {
+  all_registers_incr
+  arrival_tolerance
+  bulk_annotation_ids
+  corner_path_ends
+  corner_slacks
+  equiv_cell_funcs
+  fanin_fanout_levels
+  freeze_timing
+  modes
+  partition_slacks
+  path_memory
+  pattern_match
+  sdc_graph_incr
+  sdf_duplicate_cells
+  search_filter_incr
+  search_tag_group_incr
+  swap_cell
+  write_path_spice
+  write_timing_model
+}
+
+# The timing server test client is a python script.
+if { [auto_execok python3] != "" } {
+  record_sta_tests {
+    timing_server
+  }
+}
+
 define_test_group fast [group_tests all]
@@ -0,0 +1,64 @@
+# Constraints added after the graph is annotated (set_disable_timing on
+# pins, hierarchical pins, instances and library ports, set_output_delay
+# and set_data_check) are annotated incrementally. The timing reports
+# match a full annotation of the graph.
+file mkdir results
+set verilog_file [file join results sdc_graph_incr.v]
+set stream [open $verilog_file w]
+puts $stream {module sub (a, clk, z);
+  input a, clk;
+  output z;
+  wire n1;
+  BUF_X1 b1 (.A(a), .Z(n1));
+  DFF_X1 r (.D(n1), .CK(clk), .Q(z));
+endmodule
+
+module top (in1, in2, in3, clk, out1, out2, out3);
+  input in1, in2, in3, clk;
+  output out1, out2, out3;
+  wire r1q, r2q, u1z, u2z, h1z;
+  DFF_X1 r1 (.D(in1), .CK(clk), .Q(r1q));
+  DFF_X1 r2 (.D(in2), .CK(clk), .Q(r2q));
+  BUF_X1 u1 (.A(r2q), .Z(u1z));
+  AND2_X1 u2 (.A1(r1q), .A2(u1z), .ZN(u2z));
+  sub h1 (.a(u2z), .clk(clk), .z(h1z));
+  INV_X1 u3 (.A(h1z), .ZN(out1));
+  sub h2 (.a(in3), .clk(clk), .z(out2));
+  OR2_X1 u4 (.A1(r1q), .A2(in3), .ZN(out3));
+endmodule}
+close $stream
+
+read_liberty ../examples/example1_slow.lib
+read_verilog $verilog_file
+link_design top
+create_clock -name clk -period 10 clk
+set_input_delay -clock clk 1 {in1 in2 in3}
+set_output_delay -clock clk 0 {out1 out2}
+sta::set_thread_count 4
+
+proc report_timing_checks {} {
+  with_output_to_variable checks {
+    report_checks -path_delay min_max -group_count 20
+    report_checks -unconstrained -group_count 20
+  }
+  return $checks
+}
+
+# Annotate the graph.
+set before [report_timing_checks]
+
+set_disable_timing [get_pins u2/A2]
+set_disable_timing [get_pins h2/a]
+set_disable_timing -from A1 -to ZN [get_cells u4]
+set_disable_timing [get_lib_pins NangateOpenCellLibrary_slow/INV_X1/A]
+set_output_delay -clock clk 0.5 out3
+set_data_check -from [get_pins r1/Q] -to [get_pins u4/A2] -setup 0.3
+set incr [report_timing_checks]
+
+# Removing a constraint annotates the whole graph again.
+set_disable_timing [get_pins u1/A]
+unset_disable_timing [get_pins u1/A]
+set full [report_timing_checks]
+
+puts "constraints changed: [expr {$before != $incr}]"
+puts "full annotation match: [expr {$incr == $full}]"
@@ -0,0 +1,100 @@
+# SDF files with duplicate CELL entries annotate the same values with
+# any thread count; later entries replace earlier ones in file order.
+# Cells before an error are annotated and cells after it are not.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+file mkdir results
+
+proc write_sdf { filename cells } {
+  set stream [open $filename w]
+  puts $stream "(DELAYFILE"
+  puts $stream " (SDFVERSION \"OVI 2.1\")"
+  puts $stream " (DESIGN \"top\")"
+  puts $stream " (DIVIDER /)"
+  puts $stream " (TIMESCALE 1ns)"
+  puts $stream $cells
+  puts $stream ")"
+  close $stream
+}
+
+proc iopath_cell { cell_type inst from to delay {deltype ABSOLUTE} } {
+  return " (CELL (CELLTYPE \"$cell_type\") (INSTANCE $inst)
+  (DELAY ($deltype (IOPATH $from $to ($delay) ($delay)))))"
+}
+
+set dup_cells ""
+for {set i 1} {$i <= 200} {incr i} {
+  append dup_cells [iopath_cell BUF_X1 u1 A Z [expr $i * 0.001]] "\n"
+  append dup_cells [iopath_cell DFF_X1 r1 CK Q [expr 0.8 - $i * 0.001]] "\n"
+  append dup_cells " (CELL (CELLTYPE \"DFF_X1\") (INSTANCE r3)
+  (TIMINGCHECK (SETUP D (posedge CK) ([expr $i * 0.002]))))\n"
+}
+# Incremental values add to the last absolute values.
+append dup_cells [iopath_cell BUF_X1 u1 A Z 0.05 INCREMENT] "\n"
+set dup_file [file join results sdf_duplicate_cells.sdf]
+write_sdf $dup_file $dup_cells
+
+set error_cells [iopath_cell BUF_X1 u1 A Z 0.4]
+append error_cells "\n (CELL (CELLTYPE \"top\") (INSTANCE)
+  (DELAY (ABSOLUTE (INTERCONNECT r2/Q u1/A (1) (2) (3)))))\n"
+for {set i 1} {$i <= 100} {incr i} {
+  append error_cells [iopath_cell BUF_X1 u1 A Z 0.9] "\n"
+}
+set error_file [file join results sdf_duplicate_cells_error.sdf]
+write_sdf $error_file $error_cells
+
+set parse_error_cells [iopath_cell BUF_X1 u1 A Z 0.4]
+append parse_error_cells "\n" [iopath_cell BUF_X1 * A Z 0.7]
+for {set i 1} {$i <= 100} {incr i} {
+  append parse_error_cells "\n" [iopath_cell BUF_X1 u1 A Z 0.9]
+}
+set parse_error_file [file join results sdf_duplicate_cells_parse_error.sdf]
+write_sdf $parse_error_file $parse_error_cells
+
+# Read filename with thread_count threads and return the annotated
+# edges, check report and read error.
+proc read_annotations { filename thread_count } {
+  sta::remove_delay_slew_annotations
+  sta::set_thread_count $thread_count
+  set error ""
+  catch { read_sdf $filename } error
+  sta::set_thread_count 1
+  with_output_to_variable edges {
+    report_edges -from u1/A -to u1/Z
+    report_edges -from r1/CK -to r1/Q
+    report_edges -from r3/CK -to r3/D
+  }
+  with_output_to_variable checks { report_checks -path_delay min_max }
+  return [list $edges $checks $error]
+}
+
+proc u1_delay { annotations } {
+  regexp {\^ -> \^ ([0-9.]+)} [lindex $annotations 0] ignore delay
+  return $delay
+}
+
+set serial [read_annotations $dup_file 1]
+set parallel [read_annotations $dup_file 4]
+puts "duplicate u1 delay: [expr abs([u1_delay $serial] - 0.25) < 1e-3]"
+puts "duplicate edges match: [expr {[lindex $serial 0] == [lindex $parallel 0]}]"
+puts "duplicate checks match: [expr {[lindex $serial 1] == [lindex $parallel 1]}]"
+
+set serial [read_annotations $error_file 1]
+set parallel [read_annotations $error_file 4]
+puts "error: [regexp {more than 2 triples} [lindex $serial 2]]"
+puts "error match: [expr {[lindex $serial 2] == [lindex $parallel 2]}]"
+puts "error u1 delay: [expr abs([u1_delay $parallel] - 0.4) < 1e-3]"
+puts "error edges match: [expr {[lindex $serial 0] == [lindex $parallel 0]}]"
+puts "error checks match: [expr {[lindex $serial 1] == [lindex $parallel 1]}]"
+
+set serial [read_annotations $parse_error_file 1]
+set parallel [read_annotations $parse_error_file 4]
+puts "parse error: [regexp {INSTANCE wildcards} [lindex $serial 2]]"
+puts "parse error match: [expr {[lindex $serial 2] == [lindex $parallel 2]}]"
+puts "parse error u1 delay: [expr abs([u1_delay $parallel] - 0.4) < 1e-3]"
+puts "parse error edges match: [expr {[lindex $serial 0] == [lindex $parallel 0]}]"
@@ -0,0 +1,25 @@
+# Filtered report_checks followed by unfiltered slacks after an
+# incremental change outside of the filter cone.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+
+proc pin_slacks {} {
+  set slacks {}
+  foreach pin [get_pins {u2/A1 u2/ZN r3/D}] {
+    lappend slacks [get_property $pin max_rise_slack] \
+      [get_property $pin max_fall_slack]
+  }
+  return $slacks
+}
+
+report_checks -through u1/Z > /dev/null
+# r1q is outside of the fanin/fanout cone of u1/Z.
+set_load 0.5 [get_nets r1q]
+report_checks -through u1/Z > /dev/null
+set incr_slacks [pin_slacks]
+sta::arrivals_invalid
+set full_slacks [pin_slacks]
+puts "incremental slacks match: [expr {$incr_slacks == $full_slacks}]"
@@ -0,0 +1,36 @@
+# Incremental arrival updates that change the size of vertex tag groups.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+
+proc pin_slacks {} {
+  set slacks {}
+  foreach pin [get_pins {r1/CK r1/D r2/D r3/D}] {
+    lappend slacks [get_property $pin max_rise_slack] \
+      [get_property $pin max_fall_slack] \
+      [get_property $pin min_rise_slack] \
+      [get_property $pin min_fall_slack]
+  }
+  return $slacks
+}
+
+proc check_incremental { step } {
+  set incr_slacks [pin_slacks]
+  sta::arrivals_invalid
+  set full_slacks [pin_slacks]
+  puts "$step: [expr {$incr_slacks == $full_slacks}]"
+}
+
+pin_slacks
+# Grow and shrink the data tag group of in1 and r1/D.
+set_input_delay -clock clk -clock_fall -add_delay 1 in1
+check_incremental "add in1 clock_fall delay"
+unset_input_delay -clock clk -clock_fall in1
+check_incremental "remove in1 clock_fall delay"
+# Grow and shrink the clock + data tag group of clk1 and r1/CK.
+set_input_delay -clock clk -add_delay 1 clk1
+check_incremental "add clk1 delay"
+unset_input_delay -clock clk clk1
+check_incremental "remove clk1 delay"
@@ -0,0 +1,51 @@
+# What-if cell swap delays and slack match replace_cell.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 1 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+set_load 0.01 [get_nets u1z]
+
+proc edge_delay { from to rf } {
+  set edge [get_timing_edges -from [get_pins $from] -to [get_pins $to]]
+  return [get_property $edge delay_max_$rf]
+}
+
+proc swap_delay { inst swap_cell from to rf } {
+  set edge [get_timing_edges -from [get_pins $from] -to [get_pins $to]]
+  return [sta::time_sta_ui [sta::swap_cell_edge_delay [get_cells $inst] \
+			      [get_lib_cells $swap_cell] $edge $rf max]]
+}
+
+proc pin_slack { pin } {
+  set rise [get_property [get_pins $pin] max_rise_slack]
+  set fall [get_property [get_pins $pin] max_fall_slack]
+  return [expr min($rise, $fall)]
+}
+
+set edges {{u1/A u1/Z rise} {u1/A u1/Z fall} {r2/CK r2/Q rise} {r2/CK r2/Q fall}}
+set swap_cell NangateOpenCellLibrary_slow/BUF_X4
+foreach edge $edges {
+  lassign $edge from to rf
+  set before($edge) [edge_delay $from $to $rf]
+  set estimate($edge) [swap_delay u1 $swap_cell $from $to $rf]
+}
+set slack_estimate [sta::time_sta_ui [sta::swap_cell_slack [get_cells u1] \
+					[get_lib_cells $swap_cell] max]]
+set slack_before [pin_slack u1/Z]
+
+replace_cell u1 BUF_X4
+foreach edge $edges {
+  lassign $edge from to rf
+  set after [edge_delay $from $to $rf]
+  set est $estimate($edge)
+  set prev $before($edge)
+  # The estimate moves the same way as the replaced cell delay and
+  # lands within the slew change at the instance inputs.
+  set same_sign [expr ($est - $prev) * ($after - $prev) > 0]
+  puts "$from -> $to $rf: $same_sign [expr abs($est - $after) < 0.005]"
+}
+set slack_after [pin_slack u1/Z]
+puts "slack changed: [expr abs($slack_after - $slack_before) > 0.005]"
+puts "slack: [expr abs($slack_estimate - $slack_after) < 0.005]"
@@ -0,0 +1,59 @@
+# Timing server smoke test with a background python3 client.
+# regression_vars.tcl only records this test if python3 is found.
+if { [auto_execok python3] == "" } {
+  puts "python3 not found; skipping timing_server test."
+  return
+}
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+catch { timing_server } msg
+puts $msg
+catch { timing_server -socket /tmp/[string repeat x 200] } msg
+puts $msg
+
+file mkdir results
+set socket_path results/timing_server.sock
+set log_path results/timing_server.log
+set client_path results/timing_server_client.py
+set stream [open $client_path w]
+puts $stream {import socket, sys, time
+sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+for i in range(100):
+    try:
+        sock.connect(sys.argv[1])
+        break
+    except OSError:
+        time.sleep(0.1)
+stream = sock.makefile("rw")
+log = open(sys.argv[2], "w")
+for request in ["worst_slack max", "slack out", "slack bogus",
+                "eval set_output_delay -clock clk 2 out",
+                "slack out", "worst_slack max", "shutdown"]:
+    stream.write(request + "\n")
+    stream.flush()
+    log.write(stream.readline())
+log.close()}
+close $stream
+
+file delete $log_path
+exec python3 $client_path $socket_path $log_path &
+timing_server -socket $socket_path
+
+set stream [open $log_path r]
+set responses [split [string trim [read $stream]] "\n"]
+close $stream
+foreach response $responses {
+  puts [lindex $response 0]
+}
+proc slack_match { response } {
+  set slack [sta::time_sta_ui [sta::worst_slack_cmd max]]
+  return [expr {abs([lindex $response 1] - $slack) < 1e-3}]
+}
+puts "worst slack match: [slack_match [lindex $responses 5]]"
+puts "out slack changed: [expr {[lindex $responses 1 1] != [lindex $responses 4 1]}]"
+puts [lrange [lindex $responses 2] 1 end]
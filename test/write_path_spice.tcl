@@ -0,0 +1,51 @@
+# Path spice decks written by parallel writers match serial ones.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+file mkdir results
+set lib_subckt_file [file join results write_path_spice.subckt]
+set stream [open $lib_subckt_file w]
+puts $stream ".subckt BUF_X1 A Z VDD VSS\n.ends\n"
+puts $stream ".subckt AND2_X1 A1 A2 ZN VDD VSS\n.ends\n"
+puts $stream ".subckt DFF_X1 D CK Q QN VDD VSS\n.ends"
+close $stream
+set model_file [file join results write_path_spice.model]
+close [open $model_file w]
+
+proc write_decks { dir thread_count } {
+  global lib_subckt_file model_file
+  file delete -force $dir
+  file mkdir $dir
+  sta::set_thread_count $thread_count
+  write_path_spice -path_args {-group_count 10 -endpoint_count 1} \
+    -spice_directory $dir -lib_subckt_file $lib_subckt_file \
+    -model_file $model_file -power VDD -ground VSS
+}
+
+proc read_deck { filename dir } {
+  set stream [open $filename r]
+  set text [read $stream]
+  close $stream
+  return [string map [list $dir DIR] $text]
+}
+
+set serial_dir [file join results write_path_spice_serial]
+set parallel_dir [file join results write_path_spice_parallel]
+write_decks $serial_dir 1
+write_decks $parallel_dir 4
+set serial_files [lsort [glob -directory $serial_dir -tails *]]
+set parallel_files [lsort [glob -directory $parallel_dir -tails *]]
+puts "deck files: [llength $serial_files]"
+puts "file names match: [expr {$serial_files == $parallel_files}]"
+set match 1
+foreach file $serial_files {
+  if { [read_deck [file join $serial_dir $file] $serial_dir] \
+	 != [read_deck [file join $parallel_dir $file] $parallel_dir] } {
+    set match 0
+  }
+}
+puts "decks match: $match"
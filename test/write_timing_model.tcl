@@ -0,0 +1,83 @@
+# Write a timing model of example1 and read it back. The model sweep
+# leaves the design constraints as they were, and a top using the model
+# cell times the same as the flat netlist.
+read_liberty ../examples/example1_slow.lib
+read_verilog ../examples/example1.v
+link_design top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+
+proc path_slack { args } {
+  set path_end [eval find_timing_paths $args]
+  return [get_property $path_end slack]
+}
+
+proc boundary_slacks {} {
+  return [list [path_slack -from [get_ports in1]] \
+            [path_slack -from [get_ports in2]] \
+            [path_slack -to [get_ports out]]]
+}
+
+with_output_to_variable checks_before { report_checks -path_delay min_max }
+set flat_slacks [boundary_slacks]
+
+file mkdir results
+set sdc_before [file join results write_timing_model_before.sdc]
+set sdc_after [file join results write_timing_model_after.sdc]
+write_sdc -no_timestamp $sdc_before
+set model_file [file join results write_timing_model.lib]
+set min_model_file [file join results write_timing_model_min.lib]
+write_timing_model -library_name model -cell_name block \
+  -min_filename $min_model_file $model_file
+write_sdc -no_timestamp $sdc_after
+with_output_to_variable checks_after { report_checks -path_delay min_max }
+puts "checks restored: [expr {$checks_before == $checks_after}]"
+
+proc file_text { filename } {
+  set stream [open $filename r]
+  set text [read $stream]
+  close $stream
+  return $text
+}
+puts "sdc restored: [expr {[file_text $sdc_before] == [file_text $sdc_after]}]"
+
+read_liberty $model_file
+read_liberty $min_model_file
+
+proc report_model_arcs { lib_cell } {
+  set arcs {}
+  set arc_iter [$lib_cell timing_arc_set_iterator]
+  while {[$arc_iter has_next]} {
+    set arc_set [$arc_iter next]
+    lappend arcs "[$arc_set full_name] [$arc_set role]"
+  }
+  $arc_iter finish
+  foreach arc [lsort $arcs] {
+    puts $arc
+  }
+}
+
+report_model_arcs [get_lib_cells model/block]
+report_model_arcs [get_lib_cells model_min/block]
+
+# Time a top that instantiates the model cell with the same constraints.
+set model_verilog [file join results write_timing_model_top.v]
+set stream [open $model_verilog w]
+puts $stream "module model_top (in1, in2, clk1, clk2, clk3, out);"
+puts $stream "  input in1, in2, clk1, clk2, clk3;"
+puts $stream "  output out;"
+puts $stream "  block b1 (.in1(in1), .in2(in2), .clk1(clk1), .clk2(clk2),"
+puts $stream "    .clk3(clk3), .out(out));"
+puts $stream "endmodule"
+close $stream
+read_verilog $model_verilog
+link_design model_top
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+set model_slacks [boundary_slacks]
+
+foreach name {in1 in2 out} flat_slack $flat_slacks model_slack $model_slacks {
+  puts "$name slack: [expr abs($flat_slack - $model_slack) < 0.01]"
+}
@@ -0,0 +1,88 @@
+// OpenSTA, Static Timing Analyzer
+// Copyright (c) 2020, Parallax Software, Inc.
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "BlockArena.hh"
+
+#include "Machine.hh"
+
+namespace sta {
+
+size_t BlockArena::chunk_size_max_ = huge_page_size;
+
+BlockArena::BlockArena() :
+  next_(nullptr),
+  remaining_(0),
+  chunk_size_(chunk_size_min_),
+  size_(0)
+{
+}
+
+BlockArena::~BlockArena()
+{
+  clear();
+}
+
+void
+BlockArena::setChunkSizeMax(size_t size)
+{
+  chunk_size_max_ = size;
+}
+
+void *
+BlockArena::alloc(size_t size)
+{
+  // Keep blocks cache line aligned.
+  size = (size + alignment_ - 1) & ~(alignment_ - 1);
+  if (size > remaining_) {
+    if (size > chunk_size_max_)
+      // Blocks bigger than a chunk get a chunk of their own.
+      return makeChunk(size);
+    while (chunk_size_ < size)
+      chunk_size_ *= 2;
+    next_ = makeChunk(chunk_size_);
+    remaining_ = chunk_size_;
+    if (chunk_size_ < chunk_size_max_)
+      chunk_size_ *= 2;
+  }
+  void *memory = next_;
+  next_ += size;
+  remaining_ -= size;
+  return memory;
+}
+
+char *
+BlockArena::makeChunk(size_t size)
+{
+  char *memory = static_cast<char*>(largeMemoryAlloc(size));
+  chunks_.push_back({memory, size});
+  size_ += size;
+  return memory;
+}
+
+void
+BlockArena::clear()
+{
+  for (Chunk &chunk : chunks_)
+    largeMemoryFree(chunk.memory, chunk.size);
+  chunks_.clear();
+  next_ = nullptr;
+  remaining_ = 0;
+  chunk_size_ = chunk_size_min_;
+  size_ = 0;
+}
+
+} // namespace
@@ -7,6 +7,8 @@
 
 namespace sta {
 
+static thread_local int dispatch_thread_index = -1;
+
 DispatchQueue::DispatchQueue(size_t thread_count) :
   threads_(thread_count),
   pending_task_count_(0)
@@ -55,6 +57,12 @@ DispatchQueue::finishTasks()
     std::this_thread::yield();
 }
 
+int
+DispatchQueue::threadIndex()
+{
+  return dispatch_thread_index;
+}
+
 void
 DispatchQueue::dispatch(const fp_t& op)
 {
@@ -84,6 +92,7 @@ DispatchQueue::dispatch(fp_t&& op)
 void
 DispatchQueue::dispatch_thread_handler(size_t i)
 {
+  dispatch_thread_index = i;
   std::unique_lock<std::mutex> lock(lock_);
 
   do {
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <new>
 
 #include "StaConfig.hh"
 #include "StringUtil.hh"
@@ -80,4 +81,20 @@ memoryUsage()
   return rusage.ru_maxrss;
 }
 
+void *
+largeMemoryAlloc(size_t size)
+{
+  void *memory = malloc(size);
+  if (memory == nullptr)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void
+largeMemoryFree(void *memory,
+		size_t)
+{
+  free(memory);
+}
+
 } // namespace
@@ -21,6 +21,8 @@
 #include <stdio.h>
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <sys/mman.h>
+#include <new>
 
 #include "StaConfig.hh"
 #include "StringUtil.hh"
@@ -100,4 +102,25 @@ memoryUsage()
   return memory;
 }
 
+void *
+largeMemoryAlloc(size_t size)
+{
+  void *memory;
+  size_t alignment = (size >= huge_page_size) ? huge_page_size : 64;
+  if (posix_memalign(&memory, alignment, size) != 0)
+    throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+  if (size >= huge_page_size)
+    madvise(memory, size, MADV_HUGEPAGE);
+#endif
+  return memory;
+}
+
+void
+largeMemoryFree(void *memory,
+		size_t)
+{
+  free(memory);
+}
+
 } // namespace
@@ -16,6 +16,9 @@
 
 #include "Machine.hh"
 
+#include <stdlib.h>
+#include <new>
+
 namespace sta {
 
 int
@@ -53,4 +56,20 @@ memoryUsage()
   return 0;
 }
 
+void *
+largeMemoryAlloc(size_t size)
+{
+  void *memory = malloc(size);
+  if (memory == nullptr)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void
+largeMemoryFree(void *memory,
+		size_t)
+{
+  free(memory);
+}
+
 } // namespace
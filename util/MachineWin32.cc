@@ -17,6 +17,8 @@
 #include "Machine.hh"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <new>
 #include <windows.h> // GetSystemInfo
 
 #include "StaConfig.hh" // HAVE_PTHREAD_H
@@ -85,4 +87,20 @@ memoryUsage()
   return 0;
 }
 
+void *
+largeMemoryAlloc(size_t size)
+{
+  void *memory = malloc(size);
+  if (memory == nullptr)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void
+largeMemoryFree(void *memory,
+		size_t)
+{
+  free(memory);
+}
+
 } // namespace
@@ -15,13 +15,21 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "PatternMatch.hh"
+#include <ctype.h>
 #include <string.h>
 #include <tcl.h>
+#include <algorithm>
+
+#include "DispatchQueue.hh"
 
 namespace sta {
 
 using std::string;
 
+// Simple regexp tokens that are not literal characters.
+static const int pattern_any = -1;
+static const int pattern_star = -2;
+
 PatternMatch::PatternMatch(const char *pattern,
 			   bool is_regexp,
 			   bool nocase,
@@ -30,7 +38,8 @@ PatternMatch::PatternMatch(const char *pattern,
   is_regexp_(is_regexp),
   nocase_(nocase),
   interp_(interp),
-  regexp_(nullptr)
+  regexp_(nullptr),
+  is_simple_regexp_(false)
 {
   if (is_regexp_)
     compileRegexp();
@@ -41,7 +50,8 @@ PatternMatch::PatternMatch(const char *pattern) :
   is_regexp_(false),
   nocase_(false),
   interp_(nullptr),
-  regexp_(nullptr)
+  regexp_(nullptr),
+  is_simple_regexp_(false)
 {
 }
 
@@ -51,7 +61,8 @@ PatternMatch::PatternMatch(const char *pattern,
   is_regexp_(inherit_from->is_regexp_),
   nocase_(inherit_from->nocase_),
   interp_(inherit_from->interp_),
-  regexp_(nullptr)
+  regexp_(nullptr),
+  is_simple_regexp_(false)
 {
   if (is_regexp_)
     compileRegexp();
@@ -60,6 +71,8 @@ PatternMatch::PatternMatch(const char *pattern,
 void
 PatternMatch::compileRegexp()
 {
+  if (compileSimpleRegexp())
+    return;
   int flags = TCL_REG_ADVANCED;
   if (nocase_)
     flags |= TCL_REG_NOCASE;
@@ -74,6 +87,84 @@ PatternMatch::compileRegexp()
     throw RegexpCompileError(pattern_);
 }
 
+// Compile regexps that only use literals, '.', '.*' and '.+' so they
+// can be matched without the TCL regexp engine.
+bool
+PatternMatch::compileSimpleRegexp()
+{
+  std::vector<int> tokens;
+  const char *p = pattern_;
+  while (*p) {
+    char ch = *p++;
+    if (ch == '.') {
+      if (*p == '*') {
+	tokens.push_back(pattern_star);
+	p++;
+      }
+      else if (*p == '+') {
+	tokens.push_back(pattern_any);
+	tokens.push_back(pattern_star);
+	p++;
+      }
+      else
+	tokens.push_back(pattern_any);
+    }
+    else {
+      if (ch == '\\') {
+	// Escaped punctuation is literal; \d, \w etc are classes.
+	if (ispunct(static_cast<unsigned char>(*p)))
+	  ch = *p++;
+	else
+	  return false;
+      }
+      else if (strchr("*+?{}()[]|^$", ch))
+	return false;
+      tokens.push_back(static_cast<unsigned char>(ch));
+    }
+    // Quantified literals, '.*' and '.+' are not simple.
+    if (*p && strchr("*+?{", *p))
+      return false;
+  }
+  simple_regexp_ = tokens;
+  is_simple_regexp_ = true;
+  return true;
+}
+
+// Iterative wildcard match that backtracks to the last star.
+bool
+PatternMatch::matchSimpleRegexp(const char *str) const
+{
+  size_t token_count = simple_regexp_.size();
+  size_t t = 0;
+  const char *s = str;
+  size_t star_t = 0;
+  const char *star_s = nullptr;
+  while (*s) {
+    int token = (t < token_count) ? simple_regexp_[t] : 0;
+    if (token == pattern_star) {
+      star_t = t++;
+      star_s = s;
+    }
+    else if (t < token_count
+	     && (token == pattern_any
+		 || token == static_cast<unsigned char>(*s)
+		 || (nocase_
+		     && tolower(token) == tolower(static_cast<unsigned char>(*s))))) {
+      t++;
+      s++;
+    }
+    else if (star_s) {
+      t = star_t + 1;
+      s = ++star_s;
+    }
+    else
+      return false;
+  }
+  while (t < token_count && simple_regexp_[t] == pattern_star)
+    t++;
+  return t == token_count;
+}
+
 static bool
 regexpWildcards(const char *pattern)
 {
@@ -92,7 +183,9 @@ PatternMatch::hasWildcards() const
 bool
 PatternMatch::match(const char *str) const
 {
-  if (regexp_)
+  if (is_simple_regexp_)
+    return matchSimpleRegexp(str);
+  else if (regexp_)
     return Tcl_RegExpExec(nullptr, regexp_, str, str) == 1;
   else
     return patternMatch(pattern_, str);
@@ -101,7 +194,9 @@ PatternMatch::match(const char *str) const
 bool
 PatternMatch::matchNoCase(const char *str) const
 {
-  if (regexp_)
+  if (is_simple_regexp_)
+    return matchSimpleRegexp(str);
+  else if (regexp_)
     return Tcl_RegExpExec(0, regexp_, str, str) == 1;
   else
     return patternMatchNoCase(pattern_, str, nocase_);
@@ -129,25 +224,7 @@ bool
 patternMatch(const char *pattern,
 	     const char *str)
 {
-  const char *p = pattern;
-  const char *s = str;
-
-  while (*p && *s && (*s == *p || *p == '?')) {
-    p++;
-    s++;
-  }
-  if (*p == '\0' && *s == '\0')
-    return true;
-  else if (*p == '*') {
-    if (p[1] == '\0')
-      return true;
-    while (*s) {
-      if (patternMatch(p + 1, s))
-	return true;
-      s++;
-    }
-  }
-  return false;
+  return patternMatchNoCase(pattern, str, false);
 }
 
 inline
@@ -160,6 +237,8 @@ bool equalCase(char s,
     : s == p;
 }
 
+// Iterative match that backtracks to the last '*' instead of
+// recursing for every '*' in the pattern.
 bool
 patternMatchNoCase(const char *pattern,
 		   const char *str,
@@ -167,23 +246,28 @@ patternMatchNoCase(const char *pattern,
 {
   const char *p = pattern;
   const char *s = str;
+  const char *star_p = nullptr;
+  const char *star_s = nullptr;
 
-  while (*p && *s && (equalCase(*s, *p, nocase) || *p == '?')) {
-    p++;
-    s++;
-  }
-  if (*p == '\0' && *s == '\0')
-    return true;
-  else if (*p == '*') {
-    if (p[1] == '\0')
-      return true;
-    while (*s) {
-      if (patternMatchNoCase(p + 1, s, nocase))
-	return true;
+  while (*s) {
+    if (*p == '*') {
+      star_p = p++;
+      star_s = s;
+    }
+    else if (*p && (*p == '?' || equalCase(*s, *p, nocase))) {
+      p++;
       s++;
     }
+    else if (star_p) {
+      p = star_p + 1;
+      s = ++star_s;
+    }
+    else
+      return false;
   }
-  return false;
+  while (*p == '*')
+    p++;
+  return *p == '\0';
 }
 
 bool
@@ -192,4 +276,38 @@ patternWildcards(const char *pattern)
   return strpbrk(pattern, "*?") != 0;
 }
 
+// Names per thread below which the threads cost more than they save.
+static const size_t match_names_thread_min = 1024;
+
+void
+patternMatchNames(const PatternMatch *pattern,
+		  size_t count,
+		  const std::function<const char *(size_t index)> &name,
+		  DispatchQueue *dispatch_queue,
+		  int thread_count,
+		  // Return value.
+		  std::vector<char> &matches)
+{
+  matches.assign(count, false);
+  size_t chunk_count = std::min(static_cast<size_t>(std::max(thread_count, 1)),
+				count / match_names_thread_min);
+  if (dispatch_queue
+      && chunk_count > 1
+      && pattern->isThreadSafe()) {
+    size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+    for (size_t begin = 0; begin < count; begin += chunk_size) {
+      size_t end = std::min(begin + chunk_size, count);
+      dispatch_queue->dispatch([=, &name, &matches] (int) {
+	  for (size_t i = begin; i < end; i++)
+	    matches[i] = pattern->match(name(i));
+	});
+    }
+    dispatch_queue->finishTasks();
+  }
+  else {
+    for (size_t i = 0; i < count; i++)
+      matches[i] = pattern->match(name(i));
+  }
+}
+
 } // namespace
@@ -29,9 +29,16 @@ using std::min;
 
 Report *Report::default_ = nullptr;
 
+// Log and redirect files are written through a large buffer so that
+// long reports are written in big blocks. Commands defined with
+// proc_redirect flush them when they finish.
+static const size_t file_buffer_size = 1 << 20;
+
 Report::Report() :
   log_stream_(nullptr),
+  log_buffer_(nullptr),
   redirect_stream_(nullptr),
+  redirect_buffer_(nullptr),
   redirect_to_string_(false),
   buffer_size_(1000),
   buffer_(new char[buffer_size_]),
@@ -42,6 +49,8 @@ Report::Report() :
 
 Report::~Report()
 {
+  closeFile(log_stream_, log_buffer_);
+  closeFile(redirect_stream_, redirect_buffer_);
   delete [] buffer_;
 }
 
@@ -300,49 +309,79 @@ Report::fileCritical(int /* id */,
 
 ////////////////////////////////////////////////////////////////
 
+FILE *
+Report::openFile(const char *filename,
+                 const char *mode,
+                 char *&file_buffer)
+{
+  FILE *stream = fopen(filename, mode);
+  if (stream == nullptr)
+    throw FileNotWritable(filename);
+  file_buffer = new char[file_buffer_size];
+  setvbuf(stream, file_buffer, _IOFBF, file_buffer_size);
+  return stream;
+}
+
+void
+Report::closeFile(FILE *&stream,
+                  char *&file_buffer)
+{
+  if (stream)
+    fclose(stream);
+  stream = nullptr;
+  // The buffer must outlive the stream.
+  delete [] file_buffer;
+  file_buffer = nullptr;
+}
+
 void
 Report::logBegin(const char *filename)
 {
-  log_stream_ = fopen(filename, "w");
-  if (log_stream_ == nullptr)
-    throw FileNotWritable(filename);
+  closeFile(log_stream_, log_buffer_);
+  log_stream_ = openFile(filename, "w", log_buffer_);
 }
 
 void
 Report::logEnd()
 {
-  if (log_stream_)
-    fclose(log_stream_);
-  log_stream_ = nullptr;
+  closeFile(log_stream_, log_buffer_);
 }
 
 void
 Report::redirectFileBegin(const char *filename)
 {
-  redirect_stream_ = fopen(filename, "w");
-  if (redirect_stream_ == nullptr)
-    throw FileNotWritable(filename);
+  closeFile(redirect_stream_, redirect_buffer_);
+  redirect_stream_ = openFile(filename, "w", redirect_buffer_);
 }
 
 void
 Report::redirectFileAppendBegin(const char *filename)
 {
-  redirect_stream_ = fopen(filename, "a");
-  if (redirect_stream_ == nullptr)
-    throw FileNotWritable(filename);
+  closeFile(redirect_stream_, redirect_buffer_);
+  redirect_stream_ = openFile(filename, "a", redirect_buffer_);
 }
 
 void
 Report::redirectFileEnd()
 {
+  closeFile(redirect_stream_, redirect_buffer_);
+}
+
+void
+Report::flushFiles()
+{
+  if (log_stream_)
+    fflush(log_stream_);
   if (redirect_stream_)
-    fclose(redirect_stream_);
-  redirect_stream_ = nullptr;
+    fflush(redirect_stream_);
 }
 
 void
 Report::redirectStringBegin()
 {
+  // Save the string of an enclosing redirect.
+  if (redirect_to_string_)
+    redirect_strings_.push_back(redirect_string_);
   redirect_to_string_ = true;
   redirect_string_.clear();
 }
@@ -350,8 +389,16 @@ Report::redirectStringBegin()
 const char *
 Report::redirectStringEnd()
 {
-  redirect_to_string_ = false;
-  return redirect_string_.c_str();
+  if (redirect_strings_.empty()) {
+    redirect_to_string_ = false;
+    return redirect_string_.c_str();
+  }
+  else {
+    nested_string_ = redirect_string_;
+    redirect_string_ = redirect_strings_.back();
+    redirect_strings_.pop_back();
+    return nested_string_.c_str();
+  }
 }
 
 void
@@ -17,11 +17,11 @@
 #include "StringUtil.hh"
 
 #include <limits>
+#include <memory>
 #include <ctype.h>
 #include <stdio.h>
 
 #include "Machine.hh"
-#include "Mutex.hh"
 
 namespace sta {
 
@@ -152,38 +152,90 @@ stringPrintTmp(const char *fmt,
 
 ////////////////////////////////////////////////////////////////
 
-static int tmp_string_count_ = 100;
-static char **tmp_strings_ = nullptr;
-static size_t *tmp_string_lengths_ = nullptr;
-static int tmp_string_next_;
-static std::mutex string_lock_;
+// Each thread has its own ring of temporary strings so that threads
+// do not reuse each other's strings.
+class TmpStrings
+{
+public:
+  TmpStrings();
+  ~TmpStrings();
+  char *makeString(size_t length);
+  void nextString(// Return values.
+		  char *&str,
+		  size_t &length);
 
-void
-initTmpStrings()
+private:
+  static const int count_ = 100;
+  char *strings_[count_];
+  size_t lengths_[count_];
+  int next_;
+};
+
+TmpStrings::TmpStrings() :
+  next_(0)
 {
   size_t initial_length = 100;
-
-  tmp_strings_ = new char*[tmp_string_count_];
-  tmp_string_lengths_ = new size_t[tmp_string_count_];
-  for (int i = 0; i < tmp_string_count_; i++) {
-    tmp_strings_[i] = new char[initial_length];
-    tmp_string_lengths_[i] = initial_length;
+  for (int i = 0; i < count_; i++) {
+    strings_[i] = new char[initial_length];
+    lengths_[i] = initial_length;
   }
-  tmp_string_next_ = 0;
+}
+
+TmpStrings::~TmpStrings()
+{
+  for (int i = 0; i < count_; i++)
+    delete [] strings_[i];
 }
 
 void
-deleteTmpStrings()
+TmpStrings::nextString(// Return values.
+		       char *&str,
+		       size_t &length)
 {
-  if (tmp_strings_) {
-    for (int i = 0; i < tmp_string_count_; i++)
-      delete [] tmp_strings_[i];
-    delete [] tmp_strings_;
-    tmp_strings_ = nullptr;
+  if (next_ == count_)
+    next_ = 0;
+  str = strings_[next_];
+  length = lengths_[next_];
+  next_++;
+}
 
-    delete [] tmp_string_lengths_;
-    tmp_string_lengths_ = nullptr;
+char *
+TmpStrings::makeString(size_t length)
+{
+  if (next_ == count_)
+    next_ = 0;
+  char *tmp_str = strings_[next_];
+  if (lengths_[next_] < length) {
+    // String isn't long enough.  Make a new one.
+    stringDelete(tmp_str);
+    tmp_str = new char[length];
+    strings_[next_] = tmp_str;
+    lengths_[next_] = length;
   }
+  next_++;
+  return tmp_str;
+}
+
+static thread_local std::unique_ptr<TmpStrings> tmp_strings_;
+
+static TmpStrings *
+tmpStrings()
+{
+  if (tmp_strings_ == nullptr)
+    tmp_strings_.reset(new TmpStrings);
+  return tmp_strings_.get();
+}
+
+void
+initTmpStrings()
+{
+  tmpStrings();
+}
+
+void
+deleteTmpStrings()
+{
+  tmp_strings_.reset();
 }
 
 static void
@@ -191,31 +243,13 @@ getTmpString(// Return values.
 	     char *&str,
 	     size_t &length)
 {
-  UniqueLock lock(string_lock_);
-  if (tmp_string_next_ == tmp_string_count_)
-    tmp_string_next_ = 0;
-  str = tmp_strings_[tmp_string_next_];
-  length = tmp_string_lengths_[tmp_string_next_];
-  tmp_string_next_++;
+  tmpStrings()->nextString(str, length);
 }
 
 char *
 makeTmpString(size_t length)
 {
-  UniqueLock lock(string_lock_);
-  if (tmp_string_next_ == tmp_string_count_)
-    tmp_string_next_ = 0;
-  char *tmp_str = tmp_strings_[tmp_string_next_];
-  size_t tmp_length = tmp_string_lengths_[tmp_string_next_];
-  if (tmp_length < length) {
-    // String isn't long enough.  Make a new one.
-    stringDelete(tmp_str);
-    tmp_str = new char[length];
-    tmp_strings_[tmp_string_next_] = tmp_str;
-    tmp_string_lengths_[tmp_string_next_] = length;
-  }
-  tmp_string_next_++;
-  return tmp_str;
+  return tmpStrings()->makeString(length);
 }
 
 ////////////////////////////////////////////////////////////////
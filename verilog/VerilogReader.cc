@@ -1730,7 +1730,12 @@ VerilogReader::linkNetwork(const char *top_cell_name,
 	}
 	delete net_name_iter;
       }
-      makeModuleInstBody(module, top_instance, &bindings, make_black_boxes);
+      // The top module body is only expanded once, so its instance
+      // statements can be deleted as they are linked. For flat netlists
+      // this keeps the statement tree and the network from both being
+      // resident at their full size.
+      makeModuleInstBody(module, top_instance, &bindings, make_black_boxes,
+			 true);
       bool errors = reportLinkErrors(report);
       deleteModules();
       if (errors) {
@@ -1755,11 +1760,12 @@ void
 VerilogReader::makeModuleInstBody(VerilogModule *module,
 				  Instance *inst,
 				  VerilogBindingTbl *bindings,
-				  bool make_black_boxes)
+				  bool make_black_boxes,
+				  bool delete_insts)
 {
-  VerilogStmtSeq::Iterator stmt_iter(module->stmts());
-  while (stmt_iter.hasNext()) {
-    VerilogStmt *stmt = stmt_iter.next();
+  VerilogStmtSeq *stmts = module->stmts();
+  for (size_t i = 0; i < stmts->size(); i++) {
+    VerilogStmt *stmt = (*stmts)[i];
     if (stmt->isModuleInst())
       makeModuleInstNetwork(dynamic_cast<VerilogModuleInst*>(stmt),
 			    inst, module, bindings, make_black_boxes);
@@ -1788,6 +1794,10 @@ VerilogReader::makeModuleInstBody(VerilogModule *module,
     else if (stmt->isAssign())
       mergeAssignNet(dynamic_cast<VerilogAssign*>(stmt), module, inst,
 		     bindings);
+    if (delete_insts && stmt->isInstance()) {
+      delete stmt;
+      (*stmts)[i] = nullptr;
+    }
   }
 }
 
@@ -1840,7 +1850,7 @@ VerilogReader::makeModuleInstNetwork(VerilogModuleInst *mod_inst,
     }
     if (!is_leaf) {
       VerilogModule *module = this->module(cell);
-      makeModuleInstBody(module, inst, &bindings, make_black_boxes);
+      makeModuleInstBody(module, inst, &bindings, make_black_boxes, false);
     }
   }
 }
@@ -186,7 +186,9 @@ protected:
   void makeModuleInstBody(VerilogModule *module,
 			  Instance *inst,
 			  VerilogBindingTbl *bindings,
-			  bool make_black_boxes);
+			  bool make_black_boxes,
+			  // Delete instance statements after they are linked.
+			  bool delete_insts);
   void makeModuleInstNetwork(VerilogModuleInst *mod_inst,
 			     Instance *parent,
 			     VerilogModule *parent_module,